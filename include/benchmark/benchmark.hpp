@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "database.hpp"
+#include "alloc_tracker.hpp"
 
 namespace benchmark {
 
@@ -22,8 +23,12 @@ namespace benchmark {
         size_t total_operations;
         double duration_seconds;
         double operations_per_second;
-        size_t memory_usage_bytes;
+        size_t memory_usage_bytes;  // estimate_memory_usage()
         double memory_usage_mb;
+        alloc_tracker::LoadFootprint load;  // Counted heap / RSS cost of constructing the engine (zeros if not measured)
+        size_t cache_hits;    // Op2 roster cache hits (DatabaseCached only)
+        size_t cache_misses;  // Op2 roster cache misses (DatabaseCached only)
+        size_t batch_size;    // Keys per call (1 = unbatched)
     };
     
     /**
@@ -35,6 +40,91 @@ namespace benchmark {
         double execution_time_ms;
     };
     
+    /**
+     * @brief Structure to hold read-only query benchmark results
+     */
+    struct QueryBenchmarkResult {
+        std::string container_name;
+        std::string query_name;
+        size_t data_size;
+        size_t query_count;
+        size_t rows_returned;       // Sum of result sizes over all queries
+        double duration_seconds;
+        double queries_per_second;
+        double avg_latency_us;
+        double memory_usage_mb;
+    };
+    
+    /**
+     * @brief Structure to hold virtual vs static dispatch comparison results
+     */
+    struct DispatchBenchmarkResult {
+        std::string container_name;
+        size_t data_size;
+        size_t operations;          // Operations per replay
+        double virtual_ns_per_op;   // Through IStudentDatabase&
+        double static_ns_per_op;    // Through the concrete final engine
+        double overhead_ns_per_op;  // virtual - static
+        double overhead_percent;    // Share of the virtual time
+    };
+    
+    /**
+     * @brief Structure to hold engine load (construction) benchmark results
+     */
+    struct LoadBenchmarkResult {
+        std::string container_name;
+        std::string method;         // "per-row add" or "bulk build"
+        size_t data_size;
+        double duration_ms;
+        double rows_per_second;
+        double heap_mb;             // Counted heap of the loaded engine
+    };
+    
+    /**
+     * @brief Structure to hold mapped database build / reopen results
+     */
+    struct MappedOpenResult {
+        std::string file_path;
+        size_t data_size;
+        size_t file_bytes;
+        double build_ms;        // DatabaseMapped(path, rows)
+        double open_ms;         // DatabaseMapped(path) on the existing file
+        double first_query_us;  // First Op2 after reopening (faults in the pages it touches)
+        double csv_load_ms;     // read_csv + DatabaseHybrid of the same rows, for comparison
+    };
+    
+    /**
+     * @brief Pre-generated A:B:C operation sequence, replayed identically by several drivers
+     */
+    struct OperationScript {
+        struct Step {
+            int operation;     // 0 = Op1, 1 = Op2, 2 = Op3
+            size_t key;        // Index into phones / groups / surnames
+            size_t new_group;  // Op1 target group index
+        };
+        
+        std::vector<std::string> phones;
+        std::vector<std::string> groups;
+        std::vector<std::string> surnames;
+        std::vector<Step> steps;
+    };
+    
+    /**
+     * @brief Structure to hold concurrent stress test results
+     */
+    struct StressTestResult {
+        std::string container_name;
+        size_t data_size;
+        size_t reader_threads;
+        size_t writer_threads;
+        size_t reads;               // Op2 + Op3 queries
+        size_t writes;              // Op1 group changes + re-adds
+        size_t consistency_checks;  // Full snapshot verifications
+        size_t forks;               // fork() snapshots checked for isolation from the writers
+        size_t violations;          // Failed checks (must be 0)
+        double duration_seconds;
+    };
+    
     /**
      * @brief Run operations benchmark for specified duration with ratio
      * 
@@ -48,6 +138,7 @@ namespace benchmark {
      * @param op1_ratio Ratio for operation 1 (default 5)
      * @param op2_ratio Ratio for operation 2 (default 10)
      * @param op3_ratio Ratio for operation 3 (default 100)
+     * @param use_views Run Op2/Op3 through the zero-copy view API with reused buffers
      * @return OperationBenchmarkResult with statistics
      */
     OperationBenchmarkResult run_operations_benchmark(
@@ -55,46 +146,171 @@ namespace benchmark {
         double duration_seconds = 10.0,
         int op1_ratio = 5,
         int op2_ratio = 10,
-        int op3_ratio = 100
+        int op3_ratio = 100,
+        bool use_views = false
     );
     
     /**
      * @brief Run operations benchmarks on all three database implementations
      * @param data_sizes Vector of data sizes to test (100, 1000, 10000, 100000)
      * @param duration_seconds Duration for each benchmark
+     * @param use_views Run Op2/Op3 through the zero-copy view API
+     * @param static_dispatch Drive each engine through its concrete type (run_operations_benchmark_static)
      * @return Vector of all benchmark results
      */
     std::vector<OperationBenchmarkResult> run_all_operations_benchmarks(
         const std::vector<size_t>& data_sizes,
+        double duration_seconds = 10.0,
+        bool use_views = false,
+        bool static_dispatch = false
+    );
+    
+    /**
+     * @brief Run operations benchmark issuing every operation as a batch
+     * 
+     * Each step picks an operation with ratio A:B:C and sends batch_size random keys
+     * through change_group_batch / get_students_by_groups_sorted / get_groups_by_surnames.
+     * Every key counts as one operation, so ops/sec is comparable with the unbatched run.
+     * 
+     * @param db Database instance to benchmark
+     * @param batch_size Number of keys per batch call
+     * @param duration_seconds Duration to run benchmark
+     * @return OperationBenchmarkResult with statistics
+     */
+    OperationBenchmarkResult run_batched_operations_benchmark(
+        IStudentDatabase* db,
+        size_t batch_size,
+        double duration_seconds = 10.0,
+        int op1_ratio = 5,
+        int op2_ratio = 10,
+        int op3_ratio = 100
+    );
+    
+    /**
+     * @brief Run batched operations benchmarks for every engine, data size and batch size
+     * @param data_sizes Vector of data sizes to test
+     * @param batch_sizes Vector of batch sizes to test
+     * @param duration_seconds Duration for each benchmark
+     * @return Vector of all benchmark results
+     */
+    std::vector<OperationBenchmarkResult> run_all_batched_benchmarks(
+        const std::vector<size_t>& data_sizes,
+        const std::vector<size_t>& batch_sizes,
         double duration_seconds = 10.0
     );
     
     /**
-     * @brief Measure execution time of a sorting algorithm
-     * @tparam T Type of elements to sort
-     * @param algorithm_name Name of the algorithm
-     * @param data Data to sort (will be copied)
-     * @param sort_func Sorting function
-     * @param comparator Comparison function
-     * @return SortBenchmarkResult containing timing and statistics
-     */
-    template <typename T>
-    SortBenchmarkResult measure_sort(
-        const std::string& algorithm_name,
-        const std::vector<T>& data,
-        std::function<void(std::vector<T>&, std::function<bool(const T&, const T&)>)> sort_func,
-        std::function<bool(const T&, const T&)> comparator
+     * @brief Run one kind of read-only query repeatedly for the specified duration
+     * @param db Database instance to benchmark
+     * @param query_name Label stored in the result
+     * @param query Issues the i-th query and returns the number of rows it produced
+     * @param duration_seconds Duration to run benchmark
+     * @return QueryBenchmarkResult with statistics
+     */
+    QueryBenchmarkResult run_query_benchmark(
+        IStudentDatabase* db,
+        const std::string& query_name,
+        const std::function<size_t(size_t)>& query,
+        double duration_seconds = 2.0
+    );
+    
+    /**
+     * @brief Run the query suite (surname prefixes, rating / birth date ranges, top-K by rating)
+     *        on scan-based and indexed engines
+     * @param data_sizes Vector of data sizes to test
+     * @param duration_seconds Duration for each query benchmark
+     * @return Vector of all benchmark results
+     */
+    std::vector<QueryBenchmarkResult> run_all_query_benchmarks(
+        const std::vector<size_t>& data_sizes,
+        double duration_seconds = 2.0
+    );
+    
+    /**
+     * @brief Compare DatabaseBitmap set-algebra queries (Op3 as intersection tests, group AND surname,
+     *        group OR / ANDNOT filters) with the same answers built from DatabaseHybrid's indices
+     * @param data_sizes Vector of data sizes to test
+     * @param duration_seconds Duration for each query benchmark
+     * @return Vector of all benchmark results
+     */
+    std::vector<QueryBenchmarkResult> run_all_bitmap_query_benchmarks(
+        const std::vector<size_t>& data_sizes,
+        double duration_seconds = 2.0
+    );
+    
+    /**
+     * @brief Grow a dataset to the requested row count by repeating base rows
+     * Repeats get a "-<copy>" phone suffix, so every phone stays unique.
+     */
+    std::vector<Student> scale_dataset(const std::vector<Student>& base, size_t rows);
+    
+    /**
+     * @brief Time per-row add() against the bulk-build constructor for TreeMap and Hybrid
+     * @param data_sizes Row counts; sizes beyond data/students.csv are synthesized with scale_dataset
+     * @return Vector of all benchmark results
+     */
+    std::vector<LoadBenchmarkResult> run_all_load_benchmarks(const std::vector<size_t>& data_sizes);
+    
+    /**
+     * @brief Build a mapped database file, then time reopening it against parsing the CSV
+     * @param file_path Mapped file to create (a "<file_path>.csv" copy of the rows is written too)
+     * @param rows Row count; sizes beyond data/students.csv are synthesized with scale_dataset
+     */
+    MappedOpenResult run_mapped_open_benchmark(const std::string& file_path, size_t rows);
+    
+    /**
+     * @brief Build a reproducible operation script from the records currently in db
+     * @param db Source of phones, groups and surnames
+     * @param length Number of operations
+     * @param seed Random seed (same seed, same script)
+     */
+    OperationScript make_operation_script(
+        const IStudentDatabase& db,
+        size_t length,
+        unsigned seed,
+        int op1_ratio = 5,
+        int op2_ratio = 10,
+        int op3_ratio = 100
+    );
+    
+    /**
+     * @brief Replay a script through the IStudentDatabase vtable (out-of-line on purpose)
+     * @return Elapsed seconds
+     */
+    double replay_operation_script_virtual(IStudentDatabase& db, const OperationScript& script);
+    
+    /**
+     * @brief Compare virtual and static dispatch for every engine, plus std::function vs
+     *        template comparators for the rating sort
+     * @param data_sizes Vector of data sizes to test
+     * @param script_length Operations per replay
+     * @param rounds Replays per driver (best is kept)
+     * @return Vector of all benchmark results
+     */
+    std::vector<DispatchBenchmarkResult> run_all_dispatch_benchmarks(
+        const std::vector<size_t>& data_sizes,
+        size_t script_length = 10000,
+        size_t rounds = 3
     );
     
     /**
-     * @brief Run sorting benchmarks
-     * @param data Data to sort
-     * @param comparator Comparison function
-     * @return Vector of benchmark results
+     * @brief Multi-threaded stress test for DatabaseConcurrent
+     * 
+     * Readers run Op2/Op3 and verify every result (group membership, sort order,
+     * unique sorted groups) plus periodic full snapshot consistency checks, while
+     * writers concurrently change groups and re-add students.
+     * 
+     * @param db Database instance under test
+     * @param reader_threads Number of reader threads
+     * @param writer_threads Number of writer threads
+     * @param duration_seconds Duration of the test
+     * @return StressTestResult with counters and number of violations
      */
-    std::vector<SortBenchmarkResult> run_sorting_benchmarks(
-        const std::vector<Student>& data,
-        std::function<bool(const Student&, const Student&)> comparator
+    StressTestResult run_concurrent_stress_test(
+        DatabaseConcurrent& db,
+        size_t reader_threads,
+        size_t writer_threads,
+        double duration_seconds = 5.0
     );
     
     /**
@@ -115,6 +331,33 @@ namespace benchmark {
     bool save_sort_results(const std::vector<SortBenchmarkResult>& results, 
                           const std::string& filename);
     
+    /**
+     * @brief Save query benchmark results to CSV file
+     * @param results Vector of query benchmark results
+     * @param filename Path to output file
+     * @return true if successful, false otherwise
+     */
+    bool save_query_results(const std::vector<QueryBenchmarkResult>& results,
+                            const std::string& filename);
+    
+    /**
+     * @brief Save load benchmark results to CSV file
+     * @param results Vector of load benchmark results
+     * @param filename Path to output file
+     * @return true if successful, false otherwise
+     */
+    bool save_load_results(const std::vector<LoadBenchmarkResult>& results,
+                           const std::string& filename);
+    
+    /**
+     * @brief Save dispatch benchmark results to CSV file
+     * @param results Vector of dispatch benchmark results
+     * @param filename Path to output file
+     * @return true if successful, false otherwise
+     */
+    bool save_dispatch_results(const std::vector<DispatchBenchmarkResult>& results,
+                               const std::string& filename);
+    
     /**
      * @brief Print operation benchmark results to console
      * @param results Vector of operation benchmark results
@@ -126,4 +369,40 @@ namespace benchmark {
      * @param results Vector of sorting benchmark results
      */
     void print_sort_results(const std::vector<SortBenchmarkResult>& results);
+    
+    /**
+     * @brief Print query benchmark results to console
+     * @param results Vector of query benchmark results
+     */
+    void print_query_results(const std::vector<QueryBenchmarkResult>& results);
+    
+    /**
+     * @brief Print load benchmark results to console
+     * @param results Vector of load benchmark results
+     */
+    void print_load_results(const std::vector<LoadBenchmarkResult>& results);
+    
+    /**
+     * @brief Print mapped database open results to console
+     * @param result Mapped open benchmark result
+     */
+    void print_mapped_open_result(const MappedOpenResult& result);
+    
+    /**
+     * @brief Print dispatch benchmark results to console
+     * @param results Vector of dispatch benchmark results
+     */
+    void print_dispatch_results(const std::vector<DispatchBenchmarkResult>& results);
+    
+    /**
+     * @brief Print concurrent stress test results to console
+     * @param result Stress test result
+     */
+    void print_stress_results(const StressTestResult& result);
+    
+    /**
+     * @brief Print the layout migrations of an adaptive engine (call outside timed regions)
+     * @param db Adaptive engine
+     */
+    void print_migration_log(const DatabaseAdaptive& db);
 }
\ No newline at end of file
@@ -0,0 +1,465 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "sorting.hpp"
+#include "sorting_generic.hpp"
+#include "sorting_parallel.hpp"
+
+/**
+ * @file static_driver.hpp
+ * Benchmark loops templated on the database type.
+ *
+ * Instantiated with IStudentDatabase every call is virtual; instantiated with a concrete
+ * (final) engine every call binds statically, so the same loop body measures both.
+ * The sorting driver likewise runs every algorithm through its std::function wrapper and
+ * through its template with the caller's comparator type.
+ */
+
+namespace benchmark {
+
+    /**
+     * @brief Timed A:B:C operations loop shared by the virtual and static drivers
+     * Fills the counters, duration, throughput and memory fields of result.
+     */
+    template <typename DB>
+    void run_operations_loop(DB& db, OperationBenchmarkResult& result,
+                             double duration_seconds, int op1_ratio, int op2_ratio, int op3_ratio,
+                             bool use_views) {
+        result.data_size = db.size();
+        result.op1_count = 0;
+        result.op2_count = 0;
+        result.op3_count = 0;
+        result.cache_hits = 0;
+        result.cache_misses = 0;
+        result.batch_size = 1;
+        result.duration_seconds = 0;
+        result.total_operations = 0;
+        result.operations_per_second = 0;
+        result.memory_usage_bytes = 0;
+        result.memory_usage_mb = 0;
+        result.load = alloc_tracker::LoadFootprint{};
+
+        // Setup random number generator
+        std::random_device rd;
+        std::mt19937 gen(rd());
+
+        // Create weighted distribution
+        std::vector<int> weights = {op1_ratio, op2_ratio, op3_ratio};
+        std::discrete_distribution<> dist(weights.begin(), weights.end());
+
+        // Get sample data for operations
+        std::vector<Student> all_students = db.to_vector();
+        if (all_students.empty()) {
+            return;
+        }
+
+        // Prepare random phones, groups, and surnames
+        std::vector<std::string> phones, groups, surnames;
+        std::set<std::string> unique_groups, unique_surnames;
+
+        for (const auto& s : all_students) {
+            phones.push_back(s.m_phone_number);
+            unique_groups.insert(s.m_group);
+            unique_surnames.insert(s.m_surname);
+        }
+
+        groups.assign(unique_groups.begin(), unique_groups.end());
+        surnames.assign(unique_surnames.begin(), unique_surnames.end());
+
+        std::uniform_int_distribution<> phone_dist(0, phones.size() - 1);
+        std::uniform_int_distribution<> group_dist(0, groups.size() - 1);
+        std::uniform_int_distribution<> surname_dist(0, surnames.size() - 1);
+        std::uniform_int_distribution<> new_group_dist(0, groups.size() - 1);
+
+        // Result buffers reused by the view API
+        std::vector<const Student*> student_view;
+        std::vector<const std::string*> group_view;
+
+        // Run operations for specified duration
+        auto start_time = std::chrono::high_resolution_clock::now();
+        auto end_time = start_time + std::chrono::duration<double>(duration_seconds);
+
+        while (std::chrono::high_resolution_clock::now() < end_time) {
+            int operation = dist(gen);
+
+            switch (operation) {
+                case 0: // Operation 1: Change group by phone
+                    {
+                        std::string phone = phones[phone_dist(gen)];
+                        std::string new_group = groups[new_group_dist(gen)];
+                        db.change_group_by_phone(phone, new_group);
+                        result.op1_count++;
+                    }
+                    break;
+
+                case 1: // Operation 2: Get students by group sorted
+                    {
+                        std::string group = groups[group_dist(gen)];
+                        if (use_views) {
+                            db.view_students_by_group_sorted(group, student_view);
+                        } else {
+                            auto students = db.get_students_by_group_sorted(group);
+                        }
+                        result.op2_count++;
+                    }
+                    break;
+
+                case 2: // Operation 3: Get groups by surname
+                    {
+                        std::string surname = surnames[surname_dist(gen)];
+                        if (use_views) {
+                            db.view_groups_by_surname(surname, group_view);
+                        } else {
+                            auto result_groups = db.get_groups_by_surname(surname);
+                        }
+                        result.op3_count++;
+                    }
+                    break;
+            }
+        }
+
+        auto actual_end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> actual_duration = actual_end - start_time;
+
+        result.duration_seconds = actual_duration.count();
+        result.total_operations = result.op1_count + result.op2_count + result.op3_count;
+        result.operations_per_second = result.total_operations / result.duration_seconds;
+        result.memory_usage_bytes = db.estimate_memory_usage();
+        result.memory_usage_mb = result.memory_usage_bytes / (1024.0 * 1024.0);
+    }
+
+    /**
+     * @brief run_operations_benchmark with the engine type known at compile time
+     * @tparam Engine Concrete (final) engine; no call goes through the IStudentDatabase vtable
+     */
+    template <typename Engine>
+    OperationBenchmarkResult run_operations_benchmark_static(
+        Engine& db,
+        double duration_seconds = 10.0,
+        int op1_ratio = 5,
+        int op2_ratio = 10,
+        int op3_ratio = 100,
+        bool use_views = false) {
+
+        static_assert(std::is_final_v<Engine>, "static dispatch needs a final engine type");
+
+        OperationBenchmarkResult result;
+        result.container_name = db.get_container_name() + (use_views ? " [views]" : "") + " [static]";
+
+        if constexpr (std::is_same_v<Engine, DatabaseCached>) {
+            db.reset_cache_stats();
+        }
+
+        run_operations_loop(db, result, duration_seconds, op1_ratio, op2_ratio, op3_ratio, use_views);
+
+        if constexpr (std::is_same_v<Engine, DatabaseCached>) {
+            result.cache_hits = db.cache_stats().hits;
+            result.cache_misses = db.cache_stats().misses;
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Replay a fixed operation script through the view API
+     * @return Elapsed seconds
+     */
+    template <typename DB>
+    double replay_operation_script(DB& db, const OperationScript& script) {
+        std::vector<const Student*> student_view;
+        std::vector<const std::string*> group_view;
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        for (const auto& step : script.steps) {
+            switch (step.operation) {
+                case 0:
+                    db.change_group_by_phone(script.phones[step.key], script.groups[step.new_group]);
+                    break;
+                case 1:
+                    db.view_students_by_group_sorted(script.groups[step.key], student_view);
+                    break;
+                case 2:
+                    db.view_groups_by_surname(script.surnames[step.key], group_view);
+                    break;
+            }
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start_time;
+        return elapsed.count();
+    }
+
+    /**
+     * @brief Replay the same script through the vtable and through Engine directly
+     * Runs alternate to spread out drift; the fastest of each is kept.
+     */
+    template <typename Engine>
+    DispatchBenchmarkResult measure_dispatch_overhead(Engine& db, const OperationScript& script, size_t rounds) {
+        static_assert(std::is_final_v<Engine>, "static dispatch needs a final engine type");
+
+        DispatchBenchmarkResult result;
+        result.container_name = db.get_container_name();
+        result.data_size = db.size();
+        result.operations = script.steps.size();
+
+        double best_virtual = 0;
+        double best_static = 0;
+
+        for (size_t round = 0; round < rounds; ++round) {
+            double virtual_seconds = replay_operation_script_virtual(db, script);
+            double static_seconds = replay_operation_script(db, script);
+
+            if (round == 0 || virtual_seconds < best_virtual) {
+                best_virtual = virtual_seconds;
+            }
+            if (round == 0 || static_seconds < best_static) {
+                best_static = static_seconds;
+            }
+        }
+
+        double operations = std::max<size_t>(result.operations, 1);
+        result.virtual_ns_per_op = best_virtual * 1e9 / operations;
+        result.static_ns_per_op = best_static * 1e9 / operations;
+        result.overhead_ns_per_op = result.virtual_ns_per_op - result.static_ns_per_op;
+        result.overhead_percent = result.virtual_ns_per_op > 0
+            ? result.overhead_ns_per_op * 100.0 / result.virtual_ns_per_op
+            : 0.0;
+
+        return result;
+    }
+
+    /**
+     * @brief Measure execution time of one sort of a copy of data
+     * @param algorithm_name Name of the algorithm
+     * @param data Data to sort (will be copied)
+     * @param sort_func Callable sort_func(std::vector<T>&) performing the sort
+     * @return SortBenchmarkResult containing timing and statistics
+     */
+    template <typename T, typename SortFunc>
+    SortBenchmarkResult measure_sort(const std::string& algorithm_name, const std::vector<T>& data,
+                                     SortFunc&& sort_func) {
+        SortBenchmarkResult result;
+        result.algorithm_name = algorithm_name;
+        result.data_size = data.size();
+
+        std::vector<T> data_copy = data;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        sort_func(data_copy);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double, std::milli> elapsed = end - start;
+        result.execution_time_ms = elapsed.count();
+
+        return result;
+    }
+
+    /**
+     * @brief Run sorting benchmarks, each algorithm in every applicable mode
+     *
+     * "<Algorithm>" calls the sort_algorithms wrapper (comparator behind std::function, one
+     * indirect call per comparison); "<Algorithm> [template]" calls sort_algorithms::generic
+     * with Compare itself, so a lambda comparator is inlined; "<Algorithm> [keyed]" sorts
+     * (rating, index) pairs and permutes once (keyed_sort_by_rating). O(n^2) algorithms run
+     * on n <= 10000.
+     *
+     * @param data Data to sort
+     * @param comparator Rating comparison function (pass a lambda to see the inlined cost)
+     * @param ascending Direction of comparator; the keyed rows sort by the rating key in this direction
+     * @return Vector of benchmark results
+     */
+    template <typename Compare>
+    std::vector<SortBenchmarkResult> run_sorting_benchmarks(const std::vector<Student>& data, Compare comparator,
+                                                            bool ascending = true) {
+        using sort_algorithms::Algorithm;
+
+        std::vector<SortBenchmarkResult> results;
+        std::function<bool(const Student&, const Student&)> wrapped = comparator;
+
+        auto run = [&](const std::string& name, bool quadratic, auto&& wrapper, auto&& generic_sort,
+                       const Algorithm* keyed) {
+            if (quadratic && data.size() > 10000) {
+                return;
+            }
+
+            std::cout << "Testing " << name << "..." << std::endl;
+
+            results.push_back(measure_sort(name, data, [&](std::vector<Student>& v) {
+                wrapper(v, wrapped);
+            }));
+            results.push_back(measure_sort(name + " [template]", data, [&](std::vector<Student>& v) {
+                generic_sort(v.begin(), v.end(), comparator);
+            }));
+
+            if (keyed) {
+                results.push_back(measure_sort(name + " [keyed]", data, [&](std::vector<Student>& v) {
+                    sort_algorithms::keyed_sort_by_rating(v, ascending, *keyed);
+                }));
+            }
+        };
+
+        using It = std::vector<Student>::iterator;
+        const Algorithm algorithms[] = {Algorithm::Std, Algorithm::Bubble, Algorithm::Insertion, Algorithm::Selection,
+                                        Algorithm::Merge, Algorithm::Quick, Algorithm::Heap, Algorithm::ParallelMerge,
+                                        Algorithm::Tim};
+
+        run("std::sort", false, sort_algorithms::std_sort,
+            [](It first, It last, Compare& comp) { sort_algorithms::generic::std_sort(first, last, comp); }, &algorithms[0]);
+        run("Bubble Sort", true, sort_algorithms::bubble_sort,
+            [](It first, It last, Compare& comp) { sort_algorithms::generic::bubble_sort(first, last, comp); }, &algorithms[1]);
+        run("Insertion Sort", true, sort_algorithms::insertion_sort,
+            [](It first, It last, Compare& comp) { sort_algorithms::generic::insertion_sort(first, last, comp); }, &algorithms[2]);
+        run("Selection Sort", true, sort_algorithms::selection_sort,
+            [](It first, It last, Compare& comp) { sort_algorithms::generic::selection_sort(first, last, comp); }, &algorithms[3]);
+        run("Merge Sort", false, sort_algorithms::merge_sort,
+            [](It first, It last, Compare& comp) { sort_algorithms::generic::merge_sort(first, last, comp); }, &algorithms[4]);
+        run("Quick Sort", false, sort_algorithms::quick_sort,
+            [](It first, It last, Compare& comp) { sort_algorithms::generic::quick_sort(first, last, comp); }, &algorithms[5]);
+        run("Heap Sort", false, sort_algorithms::heap_sort,
+            [](It first, It last, Compare& comp) { sort_algorithms::generic::heap_sort(first, last, comp); }, &algorithms[6]);
+        run("Tim Sort", false, sort_algorithms::tim_sort,
+            [](It first, It last, Compare& comp) { sort_algorithms::generic::tim_sort(first, last, comp); }, &algorithms[8]);
+        run("Parallel Merge Sort", false,
+            [](std::vector<Student>& v, std::function<bool(const Student&, const Student&)> comp) {
+                sort_algorithms::parallel_merge_sort(v, comp);
+            },
+            [](It first, It last, Compare& comp) {
+                parallel::ThreadPool pool(static_cast<size_t>(last - first) < sort_algorithms::generic::PARALLEL_MERGE_MIN ? 1 : 0);
+                sort_algorithms::generic::parallel_merge_sort(first, last, comp, pool);
+            }, &algorithms[7]);
+        run("Radix Sort", false, sort_algorithms::radix_sort_by_rating,
+            [](It first, It last, Compare& comp) { sort_algorithms::generic::radix_sort_by_rating(first, last, comp); }, nullptr);
+
+        return results;
+    }
+
+    /**
+     * @brief Thread-scaling run of generic::parallel_merge_sort
+     * The pool is started before the clock, so rows measure sorting only.
+     * @param data Data to sort
+     * @param comparator Rating comparison function
+     * @param thread_counts Pool sizes to try (including the caller)
+     * @return One "Parallel Merge Sort [N threads]" result per thread count
+     */
+    template <typename Compare>
+    std::vector<SortBenchmarkResult> run_parallel_scaling_benchmark(const std::vector<Student>& data, Compare comparator,
+                                                                    const std::vector<size_t>& thread_counts) {
+        std::vector<SortBenchmarkResult> results;
+
+        for (size_t threads : thread_counts) {
+            parallel::ThreadPool pool(threads);
+            std::string name = "Parallel Merge Sort [" + std::to_string(pool.size()) + " threads]";
+
+            std::cout << "Testing " << name << "..." << std::endl;
+
+            results.push_back(measure_sort(name, data, [&](std::vector<Student>& v) {
+                sort_algorithms::generic::parallel_merge_sort(v.begin(), v.end(), comparator, pool);
+            }));
+        }
+
+        return results;
+    }
+
+    /**
+     * @brief Sorting on inputs with existing order
+     *
+     * Runs the template variants of std::sort, Merge, Quick, Tim and Radix on the data
+     * shuffled, sorted, reversed, and sorted with k = n / 100 random swaps (a few percent
+     * of records changed since the last export). Rows are named "<Algorithm> [<input>]".
+     *
+     * @param data Data to sort
+     * @param comparator Rating comparison function
+     * @return Vector of benchmark results
+     */
+    template <typename Compare>
+    std::vector<SortBenchmarkResult> run_presorted_benchmarks(const std::vector<Student>& data, Compare comparator) {
+        using It = std::vector<Student>::iterator;
+
+        std::vector<SortBenchmarkResult> results;
+        std::mt19937 rng(42);
+
+        std::vector<Student> sorted = data;
+        std::stable_sort(sorted.begin(), sorted.end(), comparator);
+
+        std::vector<Student> shuffled = data;
+        std::shuffle(shuffled.begin(), shuffled.end(), rng);
+
+        std::vector<Student> reversed(sorted.rbegin(), sorted.rend());
+
+        std::vector<Student> perturbed = sorted;
+        if (!perturbed.empty()) {
+            std::uniform_int_distribution<size_t> position(0, perturbed.size() - 1);
+            for (size_t k = 0; k < perturbed.size() / 100; ++k) {
+                std::swap(perturbed[position(rng)], perturbed[position(rng)]);
+            }
+        }
+
+        const std::pair<std::string, const std::vector<Student>*> inputs[] = {
+            {"random", &shuffled}, {"sorted", &sorted}, {"reversed", &reversed}, {"1% perturbed", &perturbed}
+        };
+
+        auto run = [&](const std::string& name, auto&& sort) {
+            std::cout << "Testing " << name << "..." << std::endl;
+
+            for (const auto& input : inputs) {
+                results.push_back(measure_sort(name + " [" + input.first + "]", *input.second, [&](std::vector<Student>& v) {
+                    sort(v.begin(), v.end(), comparator);
+                }));
+            }
+        };
+
+        run("std::sort", [](It first, It last, Compare& comp) { sort_algorithms::generic::std_sort(first, last, comp); });
+        run("Merge Sort", [](It first, It last, Compare& comp) { sort_algorithms::generic::merge_sort(first, last, comp); });
+        run("Quick Sort", [](It first, It last, Compare& comp) { sort_algorithms::generic::quick_sort(first, last, comp); });
+        run("Tim Sort", [](It first, It last, Compare& comp) { sort_algorithms::generic::tim_sort(first, last, comp); });
+        run("Radix Sort", [](It first, It last, Compare& comp) { sort_algorithms::generic::radix_sort_by_rating(first, last, comp); });
+
+        return results;
+    }
+
+    /**
+     * @brief Surname + name ordering: std::sort with compare_by_surname_and_name against
+     * multikey_sort_by_surname_and_name, on Students and on Student pointers ("[views]",
+     * the op2 view path)
+     *
+     * @param data Data to sort (real surnames, so shared prefixes are realistic)
+     * @return Vector of benchmark results
+     */
+    inline std::vector<SortBenchmarkResult> run_name_sort_benchmarks(const std::vector<Student>& data) {
+        std::vector<SortBenchmarkResult> results;
+
+        std::vector<const Student*> views;
+        views.reserve(data.size());
+        for (const auto& student : data) {
+            views.push_back(&student);
+        }
+
+        std::cout << "Testing std::sort + comparator..." << std::endl;
+        results.push_back(measure_sort("std::sort + comparator", data, [](std::vector<Student>& v) {
+            std::sort(v.begin(), v.end(), student_comparators::compare_by_surname_and_name);
+        }));
+        results.push_back(measure_sort("std::sort + comparator [views]", views, [](std::vector<const Student*>& v) {
+            std::sort(v.begin(), v.end(), student_comparators::compare_ptr_by_surname_and_name);
+        }));
+
+        std::cout << "Testing Multikey Sort..." << std::endl;
+        results.push_back(measure_sort("Multikey Sort", data, [](std::vector<Student>& v) {
+            sort_algorithms::multikey_sort_by_surname_and_name(v);
+        }));
+        results.push_back(measure_sort("Multikey Sort [views]", views, [](std::vector<const Student*>& v) {
+            sort_algorithms::multikey_sort_by_surname_and_name(v);
+        }));
+
+        return results;
+    }
+}
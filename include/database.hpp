@@ -10,3 +10,9 @@
 #include "database_hashmap.hpp"
 #include "database_treemap.hpp"
 #include "database_hybrid.hpp"
+#include "database_indexed.hpp"
+#include "database_concurrent.hpp"
+#include "database_cached.hpp"
+#include "database_adaptive.hpp"
+#include "database_mapped.hpp"
+#include "database_bitmap.hpp"
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "database_base.hpp"
+
+/**
+ * @brief Workload-adaptive Database implementation
+ *
+ * Records always live in a flat std::vector<Student>; on top of it the engine keeps one of
+ * three layouts and migrates between them based on the live data size and op mix:
+ * - Flat:    no indices, every operation scans (best for tiny tables)
+ * - Hashed:  phone -> position hash index (write-heavy mixes)
+ * - Indexed: phone index + group/surname -> positions indices (read-heavy mixes)
+ *
+ * Upward migrations are incremental: every operation indexes at most migration_step records
+ * into a pending index set while queries keep using the current layout. Downward migrations
+ * stop using the dropped indices at once and free them at most migration_step entries per
+ * operation, so no single call pays for the teardown. Every migration is recorded in
+ * migration_log(); the engine never prints.
+ */
+
+class DatabaseAdaptive final : public DatabaseBase<DatabaseAdaptive> {
+public:
+    enum class Layout { Flat, Hashed, Indexed };
+
+    /**
+     * @brief Thresholds driving layout decisions
+     */
+    struct Policy {
+        size_t flat_max_size = 64;            // At or below: always Flat
+        double indexed_min_read_share = 0.5;  // (Op2 + Op3) share of all ops that pays for secondary indices
+        size_t window_ops = 4096;             // Re-evaluate after this many operations...
+        size_t window_scan_budget = 1 << 20;  // ...or after this many records were scanned
+        size_t stable_windows = 2;            // Consecutive windows agreeing before migrating
+        size_t migration_step = 2048;         // Records indexed per operation while migrating
+    };
+
+    struct MigrationEvent {
+        size_t operation;   // Operation counter when the event happened
+        size_t data_size;
+        Layout from;
+        Layout to;
+        bool completed;     // false: incremental migration started, true: layout switched
+    };
+
+private:
+    enum class OpKind { ChangeGroup, GroupQuery, SurnameQuery, Mutation };
+
+    struct Indices {
+        bool phones_enabled = false;
+        bool secondary_enabled = false;
+
+        std::unordered_map<std::string, size_t> phone;                 // phone -> position
+        std::unordered_map<std::string, std::vector<size_t>> group;    // group -> positions
+        std::unordered_map<std::string, std::vector<size_t>> surname;  // surname -> positions
+
+        void configure(Layout layout);
+        void insert(size_t position, const Student& student);
+        void erase(size_t position, const Student& student);
+        void relocate(size_t from, size_t to, const Student& student);
+        void change_group(size_t position, const std::string& old_group, const std::string& new_group);
+        size_t estimate_memory_usage() const;
+    };
+
+    std::vector<Student> records;
+    Policy policy;
+
+    // Layout state changes inside const queries (incremental migration), hence mutable
+    mutable Layout layout = Layout::Flat;
+    mutable Indices active;            // Covers all records
+    mutable Indices pending;           // Covers records [0, migration_cursor) of the target layout
+    mutable Layout target = Layout::Flat;
+    mutable bool migrating = false;
+    mutable size_t migration_cursor = 0;
+    mutable std::vector<Indices> retired; // Dropped indices, released incrementally
+
+    // Cheap op-mix counters for the current window
+    mutable size_t window_counts[4] = {0, 0, 0, 0};
+    mutable size_t window_scanned = 0;
+    mutable size_t total_operations = 0;
+    mutable Layout last_choice = Layout::Flat;
+    mutable size_t agreeing_windows = 0;
+
+    mutable std::vector<MigrationEvent> events;
+
+    Layout choose_layout(double read_share) const;
+    void record_operation(OpKind kind) const;
+    void evaluate() const;
+    void start_migration(Layout to) const;
+    void migrate_step() const;
+    void retire(Indices& indices) const;
+    void release_step() const;
+    void log_event(Layout from, Layout to, bool completed) const;
+    void assign(const std::vector<Student>& students);
+    void rebuild(Layout to);
+
+    size_t find_position(const std::string& phone_number) const;
+
+public:
+    DatabaseAdaptive();
+    explicit DatabaseAdaptive(const std::vector<Student>& initial_data);
+    DatabaseAdaptive(const std::vector<Student>& initial_data, const Policy& adaptive_policy);
+
+    bool load_from_file(const std::string& filename) override;
+    bool save_to_file(const std::string& filename) const override;
+    void add(const Student& student) override;
+    bool remove_by_phone(const std::string& phone_number) override;
+
+    size_t size() const override;
+    bool empty() const override;
+    void clear() override;
+    std::vector<Student> to_vector() const override;
+
+    bool change_group_by_phone(const std::string& phone_number, const std::string& new_group) override;
+    std::vector<Student> get_students_by_group_sorted(const std::string& group) const override;
+    std::vector<std::string> get_groups_by_surname(const std::string& surname) const override;
+    void view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const override;
+    void view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const override;
+    void for_each_student(const std::function<void(const Student&)>& visitor) const override;
+
+    size_t estimate_memory_usage() const override;
+    std::string get_container_name() const override;
+
+    Layout current_layout() const;
+    const std::vector<MigrationEvent>& migration_log() const;
+
+    static std::string layout_name(Layout layout);
+};
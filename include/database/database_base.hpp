@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "database_interface.hpp"
+#include "csv_handler.hpp"
+
+/**
+ * @brief In-memory copy of students for engines that cannot snapshot into their own type
+ * Defined in database_snapshot.cpp, the only place that picks the engine it builds.
+ */
+std::unique_ptr<IStudentDatabase> make_memory_snapshot(const std::vector<Student>& students);
+
+/**
+ * @brief CRTP base for concrete database engines
+ *
+ * Implements the IStudentDatabase members that are identical across engines (CSV save,
+ * rating sort-and-save) once, in terms of the engine's own operations. Engines derive as
+ *     class DatabaseX final : public DatabaseBase<DatabaseX>
+ * and, being final, every call made on a DatabaseX& binds statically. Templated callers
+ * (benchmark::run_operations_loop) therefore see the concrete engine end to end, while the
+ * virtual interface remains a thin adapter for the CLI and mixed-engine containers.
+ */
+template <typename Derived>
+class DatabaseBase : public IStudentDatabase {
+public:
+    /**
+     * @brief Whether snapshot() shares storage with the engine (O(1)) instead of copying it
+     * Engines with copy-on-write storage redeclare it as true; the save and sort paths then
+     * read from a snapshot, so they see one point in time without copying every Student first.
+     */
+    static constexpr bool SHARED_SNAPSHOT = false;
+
+    /**
+     * @brief Whether the records for_each_student visits stay in place after the callback returns
+     * (until the next mutation). Engines that visit decoded temporaries redeclare it as false; the
+     * save and keyed sort paths then copy the students instead of keeping pointers to them.
+     */
+    static constexpr bool STABLE_VISIT = true;
+
+    bool save_to_file(const std::string& filename) const override {
+        if constexpr (!Derived::STABLE_VISIT) {
+            return csv::write_csv(filename, derived().to_vector());
+        } else {
+            return read_frozen([&filename](const IStudentDatabase& db) {
+                return csv::write_csv(filename, stable_records(db));
+            });
+        }
+    }
+
+    /**
+     * @brief Copy every student into a new engine of the same type (O(n)); engines that need more
+     * than the students to be built (e.g. a backing file) get an in-memory copy instead.
+     * Engines with shared storage override this with an O(1) snapshot.
+     */
+    std::unique_ptr<IStudentDatabase> snapshot() const override {
+        if constexpr (std::is_constructible_v<Derived, const std::vector<Student>&>) {
+            return std::make_unique<Derived>(derived().to_vector());
+        } else {
+            return make_memory_snapshot(derived().to_vector());
+        }
+    }
+
+    bool sort_by_rating_and_save(const std::string& filename,
+                                 std::function<void(std::vector<Student>&, std::function<bool(const Student&, const Student&)>)> sort_func,
+                                 bool ascending = true) override {
+        return sort_by_rating_with(filename, sort_func, ascending);
+    }
+
+    bool sort_by_rating_keyed_and_save(const std::string& filename, bool ascending,
+                                       sort_algorithms::Algorithm algorithm, size_t thread_count = 0) override {
+        if constexpr (!Derived::STABLE_VISIT) {
+            std::vector<Student> records = derived().to_vector();
+            sort_algorithms::keyed_sort_by_rating(records, ascending, algorithm, thread_count);
+
+            return csv::write_csv(filename, records);
+        } else {
+            // Only pointers are sorted, so the records are read in place (from a snapshot if it is cheap)
+            return read_frozen([&](const IStudentDatabase& db) {
+                std::vector<const Student*> records = stable_records(db);
+                sort_algorithms::keyed_sort_by_rating(records, ascending, algorithm, thread_count);
+
+                return csv::write_csv(filename, records);
+            });
+        }
+    }
+
+    /**
+     * @brief Statically dispatched counterpart of sort_by_rating_and_save
+     * @param sort_func Any callable sort_func(std::vector<Student>&, Compare); the comparator is
+     *        passed as a lambda, so a templated sort can inline it instead of calling a std::function
+     */
+    template <typename SortFunc>
+    bool sort_by_rating_with(const std::string& filename, SortFunc&& sort_func, bool ascending = true) const {
+        // Comparison sorts rearrange Students, so they get their own copy
+        std::vector<Student> sorted_data = read_frozen([](const IStudentDatabase& db) {
+            return db.to_vector();
+        });
+
+        if (ascending) {
+            sort_func(sorted_data, [](const Student& a, const Student& b) { return a.m_rating < b.m_rating; });
+        } else {
+            sort_func(sorted_data, [](const Student& a, const Student& b) { return a.m_rating > b.m_rating; });
+        }
+
+        return csv::write_csv(filename, sorted_data);
+    }
+
+protected:
+    /**
+     * @brief Order group names for view_groups_by_surname: sorted by name, duplicates removed
+     */
+    static void sort_unique_groups(std::vector<const std::string*>& groups) {
+        std::sort(groups.begin(), groups.end(),
+        [](const std::string* a, const std::string* b) {
+            return *a < *b;
+        });
+
+        groups.erase(std::unique(groups.begin(), groups.end(),
+        [](const std::string* a, const std::string* b) {
+            return *a == *b;
+        }), groups.end());
+    }
+
+    /**
+     * @brief Return read(db) where db is a snapshot if Derived::SHARED_SNAPSHOT, else the engine itself
+     */
+    template <typename Read>
+    auto read_frozen(Read&& read) const {
+        if constexpr (Derived::SHARED_SNAPSHOT) {
+            std::unique_ptr<IStudentDatabase> frozen = derived().snapshot();
+            return read(static_cast<const IStudentDatabase&>(*frozen));
+        } else {
+            return read(static_cast<const IStudentDatabase&>(derived()));
+        }
+    }
+
+    /**
+     * @brief Pointers to every record of db in storage order; only valid if Derived::STABLE_VISIT
+     */
+    static std::vector<const Student*> stable_records(const IStudentDatabase& db) {
+        static_assert(Derived::STABLE_VISIT, "the visited records do not outlive the callback");
+
+        std::vector<const Student*> records;
+        records.reserve(db.size());
+
+        db.for_each_student([&records](const Student& student) {
+            records.push_back(&student);
+        });
+
+        return records;
+    }
+
+    /**
+     * @brief Writable access to a copy-on-write node
+     * A node whose only owner is this engine is changed in place; a node still shared with a
+     * snapshot (or a published Version) is copied first.
+     */
+    template <typename T>
+    static T& make_mutable(std::shared_ptr<const T>& node) {
+        if (node.use_count() != 1) {
+            node = std::make_shared<T>(*node);
+        }
+
+        return const_cast<T&>(*node);
+    }
+
+    const Derived& derived() const {
+        return static_cast<const Derived&>(*this);
+    }
+
+    Derived& derived() {
+        return static_cast<Derived&>(*this);
+    }
+};
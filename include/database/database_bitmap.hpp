@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "database_base.hpp"
+#include "group_code_map.hpp"
+#include "roaring_bitmap.hpp"
+
+/**
+ * @brief Bitmap-indexed Database implementation
+ *
+ * - Primary storage: std::vector<Student> addressed by a dense record id (freed ids are reused)
+ * - Phone index: std::unordered_map<phone, id>
+ * - Group index: GroupCodeMap<group code -> RoaringBitmap of ids>
+ * - Surname index: std::unordered_map<surname, RoaringBitmap of ids>
+ *
+ * Every attribute predicate is a compressed id set, so compound filters are evaluated with
+ * AND / OR / ANDNOT over bitmaps before any record is touched.
+ */
+
+class DatabaseBitmap final : public DatabaseBase<DatabaseBitmap> {
+public:
+    // Op3 plan switch: reading a group per id costs ~1/12 of one group-bitmap intersection test
+    static constexpr size_t WALK_FACTOR = 12;
+
+    /**
+     * @brief Conjunctive filter for get_students / count_students
+     *
+     * Matches (any of groups) AND (any of surnames) AND NOT (any of exclude_groups).
+     * An empty groups or surnames list places no restriction on that attribute.
+     */
+    struct Query {
+        std::vector<std::string> groups;
+        std::vector<std::string> surnames;
+        std::vector<std::string> exclude_groups;
+    };
+
+private:
+    struct GroupBitmap {
+        std::string name;
+        indexing::RoaringBitmap ids;
+    };
+
+    std::vector<Student> records;  // id -> student; ids outside live are free slots
+    std::vector<uint32_t> free_ids;
+    indexing::RoaringBitmap live;
+
+    std::unordered_map<std::string, uint32_t> phone_index;
+    indexing::GroupCodeMap<GroupBitmap> group_index;
+    std::unordered_map<std::string, indexing::RoaringBitmap> surname_index;
+
+    void add_to_indices(uint32_t id);
+    void remove_from_indices(uint32_t id);
+    void remove_from_group(uint32_t id, const std::string& group);
+
+    /**
+     * @brief OR of the group / surname bitmaps for the given keys (unknown keys contribute nothing)
+     */
+    indexing::RoaringBitmap union_of_groups(const std::vector<std::string>& groups) const;
+    indexing::RoaringBitmap union_of_surnames(const std::vector<std::string>& surnames) const;
+
+public:
+    DatabaseBitmap();
+    explicit DatabaseBitmap(const std::vector<Student>& initial_data);
+
+    bool load_from_file(const std::string& filename) override;
+    void add(const Student& student) override;
+    bool remove_by_phone(const std::string& phone_number) override;
+
+    size_t size() const override;
+    bool empty() const override;
+    void clear() override;
+    std::vector<Student> to_vector() const override;
+
+    bool change_group_by_phone(const std::string& phone_number, const std::string& new_group) override;
+    std::vector<Student> get_students_by_group_sorted(const std::string& group) const override;
+
+    /**
+     * @brief Operation 3, choosing the cheaper plan by cardinality
+     *
+     * A surname with fewer ids than WALK_FACTOR * (number of groups) is answered by reading the
+     * group of each id; larger ones by a per-group bitmap intersection test (see below).
+     */
+    std::vector<std::string> get_groups_by_surname(const std::string& surname) const override;
+
+    /**
+     * @brief Operation 3 as pure set algebra: every group whose bitmap intersects the surname's
+     * Cost grows with the number of groups rather than with the number of matching students.
+     */
+    std::vector<std::string> get_groups_by_surname_intersect(const std::string& surname) const;
+
+    void view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const override;
+    void view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const override;
+    void for_each_student(const std::function<void(const Student&)>& visitor) const override;
+
+    /**
+     * @brief Ids of the students matching query
+     */
+    indexing::RoaringBitmap evaluate(const Query& query) const;
+
+    /**
+     * @brief Students matching query, sorted by surname and name
+     */
+    std::vector<Student> get_students(const Query& query) const;
+
+    /**
+     * @brief Number of students matching query, computed on bitmaps only
+     */
+    size_t count_students(const Query& query) const;
+
+    size_t estimate_memory_usage() const override;
+    std::string get_container_name() const override;
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "database_interface.hpp"
+
+/**
+ * @brief Result-caching layer in front of any IStudentDatabase
+ *
+ * - Caches sorted rosters of get_students_by_group_sorted per group
+ * - Every group has a version counter; mutations bump only the affected old/new groups
+ *   and cached rosters with an outdated version are dropped on the next lookup
+ * - LRU eviction bounded by number of cached groups and total cached students
+ * - All other operations are forwarded to the wrapped database
+ * - Roster views point into cached rosters; the roster behind the latest view is pinned,
+ *   so eviction by a later miss does not end it before the next view call
+ */
+
+class DatabaseCached final : public IStudentDatabase {
+public:
+    /**
+     * @brief Cache counters since construction or the last reset_cache_stats()
+     */
+    struct CacheStats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+        size_t invalidations = 0;
+    };
+
+private:
+    using Roster = std::shared_ptr<const std::vector<Student>>;
+
+    struct CacheEntry {
+        std::string group;
+        uint64_t version;
+        Roster roster;
+    };
+
+    std::unique_ptr<IStudentDatabase> inner;
+
+    size_t max_entries;   // Max cached groups
+    size_t max_students;  // Max cached students over all rosters
+
+    mutable std::list<CacheEntry> lru; // Most recently used first
+    mutable std::unordered_map<std::string, std::list<CacheEntry>::iterator> entries;
+    mutable size_t cached_students = 0;
+    mutable Roster viewed_roster; // Backs the latest roster view
+    mutable CacheStats stats;
+
+    std::unordered_map<std::string, uint64_t> group_versions;
+    std::unordered_map<std::string, std::string> phone_to_group; // Needed to find the old group on mutations
+
+    uint64_t group_version(const std::string& group) const;
+    void invalidate_group(const std::string& group);
+    void erase_entry(std::unordered_map<std::string, std::list<CacheEntry>::iterator>::iterator it) const;
+    Roster lookup_roster(const std::string& group) const;
+    Roster insert_entry(const std::string& group, uint64_t version, std::vector<Student> roster) const;
+    void rebuild_phone_index();
+
+public:
+    explicit DatabaseCached(std::unique_ptr<IStudentDatabase> inner_db,
+                            size_t max_cached_groups = 256,
+                            size_t max_cached_students = 100000);
+
+    bool load_from_file(const std::string& filename) override;
+    bool save_to_file(const std::string& filename) const override;
+    void add(const Student& student) override;
+    bool remove_by_phone(const std::string& phone_number) override;
+
+    size_t size() const override;
+    bool empty() const override;
+    void clear() override;
+    std::vector<Student> to_vector() const override;
+
+    bool change_group_by_phone(const std::string& phone_number, const std::string& new_group) override;
+    std::vector<Student> get_students_by_group_sorted(const std::string& group) const override;
+    std::vector<std::string> get_groups_by_surname(const std::string& surname) const override;
+    void view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const override;
+    void view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const override;
+    void for_each_student(const std::function<void(const Student&)>& visitor) const override;
+    size_t change_group_batch(const std::vector<std::pair<std::string, std::string>>& changes) override;
+    std::vector<std::vector<std::string>> get_groups_by_surnames(const std::vector<std::string>& surnames) const override;
+    std::vector<std::vector<Student>> get_students_by_groups_sorted(const std::vector<std::string>& groups) const override;
+    std::vector<Student> get_students_by_surname_prefix(const std::string& prefix, size_t limit) const override;
+    std::vector<Student> get_students_by_rating_range(float min_rating, float max_rating) const override;
+    std::vector<Student> get_students_by_birth_range(int from_date, int to_date) const override;
+    std::vector<Student> top_k_by_rating(const std::string& group, size_t k) const override;
+    std::map<std::string, std::vector<Student>> top_k_by_rating_per_group(size_t k) const override;
+    std::unique_ptr<IStudentDatabase> snapshot() const override;  // Snapshot of the inner database, cold cache
+    bool sort_by_rating_and_save(const std::string& filename,
+                                  std::function<void(std::vector<Student>&, std::function<bool(const Student&, const Student&)>)> sort_func,
+                                  bool ascending = true) override;
+    bool sort_by_rating_keyed_and_save(const std::string& filename, bool ascending,
+                                       sort_algorithms::Algorithm algorithm, size_t thread_count = 0) override;
+
+    size_t estimate_memory_usage() const override;
+    std::string get_container_name() const override;
+
+    CacheStats cache_stats() const;
+    void reset_cache_stats();
+};
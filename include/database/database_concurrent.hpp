@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "database_base.hpp"
+
+/**
+ * @brief Concurrent Database implementation with a lock-free read path (RCU)
+ *
+ * - Every query reads an immutable Version reached through one atomic root pointer
+ * - Readers only announce their epoch (see epoch.hpp); they take no locks and write no shared data
+ * - Writers are serialized by a mutex and publish a new Version by copy-on-write of the
+ *   affected shards and buckets; unchanged parts are structurally shared with the old Version
+ * - Retired Versions are freed once every reader that could see them has left
+ * - fork() / snapshot() copy the root of the current Version (3 * SHARD_COUNT shared pointers),
+ *   so a point-in-time copy costs O(1) in the number of students; either side's later writes
+ *   copy only the shards and buckets they touch
+ * - Views (view_*) point into a copy of the Version root pinned in thread-local storage per
+ *   engine and view kind, so they stay valid under concurrent writers until the same thread
+ *   calls the same view on this engine again; the pin is released when that thread exits.
+ *   Taking a pin is lock-free. for_each_student visits a root copy pinned for the call
+ */
+
+class DatabaseConcurrent final : public DatabaseBase<DatabaseConcurrent> {
+private:
+    static constexpr size_t SHARD_COUNT = 64;
+
+    using Record = std::shared_ptr<const Student>;
+    using Bucket = std::vector<Record>;
+    using PhoneShard = std::unordered_map<std::string, Record>;                    // phone -> Student
+    using IndexShard = std::unordered_map<std::string, std::shared_ptr<const Bucket>>; // key -> Students
+
+    using PhoneShards = std::array<std::shared_ptr<const PhoneShard>, SHARD_COUNT>;
+    using IndexShards = std::array<std::shared_ptr<const IndexShard>, SHARD_COUNT>;
+
+    struct Version {
+        PhoneShards phones;
+        IndexShards groups;    // group -> Students
+        IndexShards surnames;  // surname -> Students
+        size_t size = 0;
+        uint64_t sequence = 0; // Bumped on every publish
+    };
+
+    std::atomic<const Version*> current;
+
+    std::mutex write_mutex;
+    std::vector<std::pair<uint64_t, const Version*>> retired; // (retire epoch, version)
+
+    // Root copies backing each thread's views (one per view kind); a view call re-pins its
+    // slot only if a newer Version was published since
+    enum ViewSlot { StudentsView, GroupsView, ViewSlotCount };
+    using ViewPins = std::array<std::shared_ptr<const Version>, ViewSlotCount>;
+
+    // Keys this engine's pins in each thread's table; expires with the engine so threads
+    // can tell stale entries apart and drop them
+    const std::shared_ptr<const char> pin_owner = std::make_shared<const char>();
+
+    static size_t shard_of(const std::string& key);
+    static const Bucket* find_bucket(const IndexShards& shards, const std::string& key);
+
+    // Copy-on-write helpers, called by writers on a private Version before publishing.
+    // A node whose only owner is the unpublished Version was created by this writer and is
+    // changed in place by make_mutable; any node still shared with a published Version is copied first.
+    static void bucket_insert(IndexShards& shards, const std::string& key, const Record& record);
+    static void bucket_erase(IndexShards& shards, const std::string& key, const std::string& phone);
+    static void bucket_replace(IndexShards& shards, const std::string& key, const Record& record);
+
+    static const Version* build_version(const std::vector<Student>& students);
+
+    void upsert(Version& next, const Student& student);
+    bool apply_group_change(Version& next, const std::string& phone_number, const std::string& new_group);
+    void publish(const Version* next);
+    void reclaim();
+
+    std::shared_ptr<const Version> pin_current() const;
+    const Version& view_version(ViewSlot slot) const;
+
+    explicit DatabaseConcurrent(const Version* version);
+
+public:
+    static constexpr bool SHARED_SNAPSHOT = true;
+
+    DatabaseConcurrent();
+    explicit DatabaseConcurrent(const std::vector<Student>& initial_data);
+    ~DatabaseConcurrent() override;
+
+    DatabaseConcurrent(const DatabaseConcurrent&) = delete;
+    DatabaseConcurrent& operator=(const DatabaseConcurrent&) = delete;
+
+    bool load_from_file(const std::string& filename) override;
+    void add(const Student& student) override;
+    bool remove_by_phone(const std::string& phone_number) override;
+
+    size_t size() const override;
+    bool empty() const override;
+    void clear() override;
+    std::vector<Student> to_vector() const override;
+
+    bool change_group_by_phone(const std::string& phone_number, const std::string& new_group) override;
+    std::vector<Student> get_students_by_group_sorted(const std::string& group) const override;
+    std::vector<std::string> get_groups_by_surname(const std::string& surname) const override;
+    void view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const override;
+    void view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const override;
+    void for_each_student(const std::function<void(const Student&)>& visitor) const override;
+    size_t change_group_batch(const std::vector<std::pair<std::string, std::string>>& changes) override;
+
+    std::unique_ptr<IStudentDatabase> snapshot() const override;
+
+    /**
+     * @brief O(1) snapshot with the concrete type (safe to call concurrently with writers)
+     * @return Independent engine sharing all shards and records with the current Version
+     */
+    std::unique_ptr<DatabaseConcurrent> fork() const;
+
+    size_t estimate_memory_usage() const override;
+    std::string get_container_name() const override;
+
+    /**
+     * @brief Check that phone, group and surname indices agree within one Version
+     * Safe to call concurrently with writers.
+     * @return true if the Version seen by the caller is internally consistent
+     */
+    bool verify_consistency() const;
+};
@@ -3,13 +3,13 @@
 #include <unordered_map>
 #include <string>
 
-#include "database_interface.hpp"
+#include "database_base.hpp"
 
 /**
  * @brief Approach 2: Database implementation using std::unordered_map (Hash Table)
  */
 
-class DatabaseHashMap : public IStudentDatabase {
+class DatabaseHashMap final : public DatabaseBase<DatabaseHashMap> {
 private:
     std::unordered_map<std::string, Student> data; // phone -> Student
 
@@ -18,7 +18,6 @@ public:
     explicit DatabaseHashMap(const std::vector<Student>& initial_data);
     
     bool load_from_file(const std::string& filename) override;
-    bool save_to_file(const std::string& filename) const override;
     void add(const Student& student) override;
     bool remove_by_phone(const std::string& phone_number) override;
 
@@ -30,9 +29,11 @@ public:
     bool change_group_by_phone(const std::string& phone_number, const std::string& new_group) override;
     std::vector<Student> get_students_by_group_sorted(const std::string& group) const override;
     std::vector<std::string> get_groups_by_surname(const std::string& surname) const override;
-    bool sort_by_rating_and_save(const std::string& filename,
-                                  std::function<void(std::vector<Student>&, std::function<bool(const Student&, const Student&)>)> sort_func,
-                                  bool ascending = true) override;
+    void view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const override;
+    void view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const override;
+    void for_each_student(const std::function<void(const Student&)>& visitor) const override;
+    std::vector<std::vector<std::string>> get_groups_by_surnames(const std::vector<std::string>& surnames) const override;
+    std::vector<std::vector<Student>> get_students_by_groups_sorted(const std::vector<std::string>& groups) const override;
     
     size_t estimate_memory_usage() const override;
     std::string get_container_name() const override;
@@ -3,35 +3,47 @@
 #include <unordered_map>
 #include <map>
 #include <string>
+#include <vector>
 
-#include "database_interface.hpp"
+#include "database_base.hpp"
+#include "group_code_map.hpp"
 
 /**
  * @brief Hybrid Database implementation combining multiple data structures
  * 
  * - Primary storage: std::unordered_map<phone, Student> for O(1) phone-based lookups
- * - Group index: std::multimap<group, phone> for O(log n + k) group queries
+ * - Group index: GroupCodeMap<group code -> students> for O(1 + k) group queries
  * - Surname index: std::multimap<surname, phone> for O(log n + k) surname queries
  */
 
-class DatabaseHybrid : public IStudentDatabase {
+class DatabaseHybrid final : public DatabaseBase<DatabaseHybrid> {
 private:
     std::unordered_map<std::string, Student> primary_data;
     
-    std::multimap<std::string, std::string> group_index;    // group -> phone
+    indexing::GroupCodeMap<std::vector<const Student*>> group_index;  // group -> students in primary_data
     std::multimap<std::string, std::string> surname_index;  // surname -> phone
 
     // Helper methods to maintain index consistency
     void add_to_indices(const Student& student);
     void remove_from_indices(const Student& student);
-    void update_group_index(const std::string& phone, const std::string& old_group, const std::string& new_group);
+    void update_group_index(const Student* student, const std::string& old_group);
+    
+    /**
+     * @brief Fill an empty database in one pass: reserve the hash table, file handles by group
+     *        code, then build the surname index from a sorted (surname, phone) run with end hints
+     * Duplicate phones keep the last row, as repeated add() would.
+     */
+    void bulk_load(const std::vector<Student>& students);
 
 public:
     DatabaseHybrid();
     explicit DatabaseHybrid(const std::vector<Student>& initial_data);
     
+    // The group index holds pointers into primary_data
+    DatabaseHybrid(const DatabaseHybrid&) = delete;
+    DatabaseHybrid& operator=(const DatabaseHybrid&) = delete;
+    
     bool load_from_file(const std::string& filename) override;
-    bool save_to_file(const std::string& filename) const override;
     void add(const Student& student) override;
     bool remove_by_phone(const std::string& phone_number) override;
 
@@ -43,9 +55,9 @@ public:
     bool change_group_by_phone(const std::string& phone_number, const std::string& new_group) override;
     std::vector<Student> get_students_by_group_sorted(const std::string& group) const override;
     std::vector<std::string> get_groups_by_surname(const std::string& surname) const override;
-    bool sort_by_rating_and_save(const std::string& filename,
-                                  std::function<void(std::vector<Student>&, std::function<bool(const Student&, const Student&)>)> sort_func,
-                                  bool ascending = true) override;
+    void view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const override;
+    void view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const override;
+    void for_each_student(const std::function<void(const Student&)>& visitor) const override;
     
     size_t estimate_memory_usage() const override;
     std::string get_container_name() const override;
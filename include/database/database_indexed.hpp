@@ -0,0 +1,82 @@
+#pragma once
+
+#include <unordered_map>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "database_base.hpp"
+#include "index_set.hpp"
+
+/**
+ * @brief Database implementation built on the declarative index framework
+ *
+ * - Primary storage: std::unordered_map<phone, Student> (node-stable, so indices hold const Student*)
+ * - Secondary indices are declared in Indices below; insert / erase / modify keep all of them
+ *   in sync without per-index maintenance code. Adding an index is a one-line type change.
+ */
+
+namespace indexing {
+    /**
+     * @brief Ordered rating key (is NaN, rating, phone): NaN ratings collapse to one key after every
+     * number, so the multimap keeps a strict weak order and numeric ranges never include them.
+     * The phone breaks ties, so equal ratings come out in phone order without a post-sort
+     */
+    std::tuple<bool, float, std::string> rating_key(const Student& student);
+
+    /**
+     * @brief Ordered birth key (packed YYYYMMDD date, phone): equal dates in phone order
+     */
+    std::pair<int, std::string> birth_key(const Student& student);
+
+    /**
+     * @brief Composite key (group, is NaN, -rating, phone): each group's students contiguous, highest
+     * rating first, NaN ratings last, ties in phone order
+     */
+    std::tuple<std::string, bool, float, std::string> group_rating_desc(const Student& student);
+}
+
+class DatabaseIndexed final : public DatabaseBase<DatabaseIndexed> {
+private:
+    using GroupIndex = indexing::Index<&Student::m_group, indexing::Ordered>;
+    using SurnameIndex = indexing::Index<&Student::m_surname, indexing::Prefix>;  // Exact and prefix lookups
+    using RatingIndex = indexing::Index<&indexing::rating_key, indexing::Ordered>;
+    using BirthIndex = indexing::Index<&indexing::birth_key, indexing::Ordered>;
+    using GroupRatingIndex = indexing::Index<&indexing::group_rating_desc, indexing::Ordered>;
+    using Indices = indexing::IndexSet<GroupIndex, SurnameIndex, RatingIndex, BirthIndex, GroupRatingIndex>;
+
+    std::unordered_map<std::string, Student> primary_data;  // phone -> student
+    Indices indices;
+
+public:
+    DatabaseIndexed();
+    explicit DatabaseIndexed(const std::vector<Student>& initial_data);
+
+    // Indices hold pointers into primary_data
+    DatabaseIndexed(const DatabaseIndexed&) = delete;
+    DatabaseIndexed& operator=(const DatabaseIndexed&) = delete;
+
+    bool load_from_file(const std::string& filename) override;
+    void add(const Student& student) override;
+    bool remove_by_phone(const std::string& phone_number) override;
+
+    size_t size() const override;
+    bool empty() const override;
+    void clear() override;
+    std::vector<Student> to_vector() const override;
+
+    bool change_group_by_phone(const std::string& phone_number, const std::string& new_group) override;
+    std::vector<Student> get_students_by_group_sorted(const std::string& group) const override;
+    std::vector<std::string> get_groups_by_surname(const std::string& surname) const override;
+    void view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const override;
+    void view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const override;
+    void for_each_student(const std::function<void(const Student&)>& visitor) const override;
+    std::vector<Student> get_students_by_surname_prefix(const std::string& prefix, size_t limit) const override;
+    std::vector<Student> get_students_by_rating_range(float min_rating, float max_rating) const override;
+    std::vector<Student> get_students_by_birth_range(int from_date, int to_date) const override;
+    std::vector<Student> top_k_by_rating(const std::string& group, size_t k) const override;
+    std::map<std::string, std::vector<Student>> top_k_by_rating_per_group(size_t k) const override;
+
+    size_t estimate_memory_usage() const override;
+    std::string get_container_name() const override;
+};
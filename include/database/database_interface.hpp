@@ -3,8 +3,12 @@
 #include <vector>
 #include <string>
 #include <functional>
+#include <map>
+#include <memory>
+#include <utility>
 
 #include "student.hpp"
+#include "sorting.hpp"
 
 /**
  * @brief Base interface for all database implementations
@@ -35,12 +39,76 @@ public:
     // Operation 3: Get list of groups where students with specific surname study
     virtual std::vector<std::string> get_groups_by_surname(const std::string& surname) const = 0;
     
+    // Zero-copy query views
+    // Pointers refer to records owned by the database. They are only guaranteed to stay valid until
+    // the next view call on the same thread or the next mutation, whichever comes first (engines may
+    // back a view with a per-thread buffer or a pinned snapshot that the next view call replaces).
+    // The output buffer is cleared first, so reusing it across calls avoids reallocations.
+    
+    // Operation 2 view: students from specific group sorted by surname and name
+    virtual void view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const = 0;
+    
+    // Operation 3 view: unique groups (sorted) where students with specific surname study
+    virtual void view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const = 0;
+    
+    // Visit every student in storage order without copying. The reference passed to the visitor
+    // is only guaranteed to be valid during that callback (an engine may decode each record into
+    // a temporary); copy the student to keep it.
+    virtual void for_each_student(const std::function<void(const Student&)>& visitor) const = 0;
+    
+    // Batched operations
+    // Engines may hash or sort the keys once, dedupe repeated keys and share scans between them.
+    // Default implementations dedupe keys and fall back to the single-key operations.
+    
+    // Operation 1 batch: apply (phone, new_group) changes in order, returns number of phones found
+    virtual size_t change_group_batch(const std::vector<std::pair<std::string, std::string>>& changes);
+    
+    // Operation 3 batch: result[i] holds the groups for surnames[i]
+    virtual std::vector<std::vector<std::string>> get_groups_by_surnames(const std::vector<std::string>& surnames) const;
+    
+    // Operation 2 batch: result[i] holds the sorted students of groups[i]
+    virtual std::vector<std::vector<Student>> get_students_by_groups_sorted(const std::vector<std::string>& groups) const;
+    
+    // Type-ahead query: students whose surname starts with prefix, ordered by surname, name
+    // and phone number; at most limit results (0 = all). Default implementation scans.
+    virtual std::vector<Student> get_students_by_surname_prefix(const std::string& prefix, size_t limit) const;
+    
+    // Range queries (bounds inclusive). Default implementations filter and then sort.
+    // Students with min_rating <= rating <= max_rating, ascending by rating, ties by phone number
+    virtual std::vector<Student> get_students_by_rating_range(float min_rating, float max_rating) const;
+    
+    // Students born between two packed YYYYMMDD dates (see Student::get_packed_birth_date), ascending by date,
+    // ties by phone number
+    virtual std::vector<Student> get_students_by_birth_range(int from_date, int to_date) const;
+    
+    // Top-K reports: highest-rated students ordered by rating (descending), ties by phone number.
+    // Default implementations make one pass keeping a bounded heap of k students per group.
+    virtual std::vector<Student> top_k_by_rating(const std::string& group, size_t k) const;
+    
+    // Top-K for every group in one call (group -> its top k)
+    virtual std::map<std::string, std::vector<Student>> top_k_by_rating_per_group(size_t k) const;
+    
+    // Point-in-time snapshot: an independent database holding the current contents. Later writes
+    // to either side are not visible to the other. O(1) for the copy-on-write engines (Vector,
+    // Concurrent); every other engine copies all students into a new engine, which is O(n).
+    virtual std::unique_ptr<IStudentDatabase> snapshot() const = 0;
+    
     // Sorting operation for Task III (S2)
     virtual bool sort_by_rating_and_save(const std::string& filename,
                                          std::function<void(std::vector<Student>&, std::function<bool(const Student&, const Student&)>)> sort_func,
                                          bool ascending = true) = 0;
     
+    // Keyed variant: sorts (rating, index) pairs with algorithm and writes the records in that
+    // order without moving them. thread_count applies to Algorithm::ParallelMerge (0 = all cores).
+    virtual bool sort_by_rating_keyed_and_save(const std::string& filename, bool ascending,
+                                               sort_algorithms::Algorithm algorithm, size_t thread_count = 0) = 0;
+    
     virtual size_t estimate_memory_usage() const = 0;
     
     virtual std::string get_container_name() const = 0;
+
+protected:
+    // Single-pass batch helpers for scan-based engines (one for_each_student pass for all keys)
+    std::vector<std::vector<std::string>> scan_groups_by_surnames(const std::vector<std::string>& surnames) const;
+    std::vector<std::vector<Student>> scan_students_by_groups_sorted(const std::vector<std::string>& groups) const;
 };
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "database_base.hpp"
+
+/**
+ * @brief On-disk layout of a DatabaseMapped file
+ *
+ * Header | group table | phone buckets | surname buckets | records | string pool
+ *
+ * Every reference is a section-relative index or pool offset, never a pointer, so a file
+ * is usable as soon as it is mapped. Integers are stored in native byte order.
+ */
+namespace mapped_format {
+    constexpr char MAGIC[8] = {'S', 'T', 'U', 'D', 'B', 'M', 'A', 'P'};
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t NIL = 0xFFFFFFFFu;  // Empty bucket / end of list
+
+    struct StringRef {
+        uint32_t offset;  // Into the string pool
+        uint32_t length;
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t dirty;            // Set before the first write after flush(); links are rebuilt on open
+        uint64_t file_size;
+        uint32_t record_count;     // Live records
+        uint32_t record_slots;     // Slots handed out so far (live + free)
+        uint32_t record_capacity;
+        uint32_t free_head;        // Free slots, linked through Record::phone_next
+        uint32_t group_count;
+        uint32_t group_capacity;
+        uint32_t bucket_count;     // Phone and surname tables, power of two
+        uint32_t reserved;
+        uint64_t pool_size;
+        uint64_t pool_capacity;
+        uint64_t groups_offset;
+        uint64_t phone_buckets_offset;
+        uint64_t surname_buckets_offset;
+        uint64_t records_offset;
+        uint64_t pool_offset;
+    };
+
+    struct GroupEntry {
+        StringRef name;
+        uint32_t head;   // First record of the group list
+        uint32_t count;
+    };
+
+    struct Record {
+        StringRef name;
+        StringRef surname;
+        StringRef email;
+        StringRef phone;
+        uint32_t group;         // Group table index
+        uint32_t group_prev;    // Doubly linked group list: regrouping is O(1)
+        uint32_t group_next;
+        uint32_t phone_next;    // Phone bucket chain (free list while not live)
+        uint32_t surname_next;  // Surname bucket chain
+        int32_t birth_year;
+        uint8_t birth_month;
+        uint8_t birth_day;
+        uint8_t live;
+        uint8_t reserved;
+        float rating;
+    };
+}
+
+/**
+ * @brief Database implementation living in a memory-mapped file
+ *
+ * - Records, hash chains and group lists are stored in place (see mapped_format), so opening
+ *   an existing file is an mmap plus a pass over the (small) group table; record pages are
+ *   faulted in on first access
+ * - change_group_by_phone relinks one record between two group lists without moving it
+ * - Writes go straight to the shared mapping; flush() (and the destructor) msync it. A crash
+ *   between flushes leaves the dirty flag set and the chains are rebuilt on the next open;
+ *   records with torn string references or groups are dropped during the rebuild
+ * - Files grow by rewriting into a larger file that replaces the old one, which also drops
+ *   the pool space of removed or replaced strings
+ * - Views decode into an engine-owned buffer and stay valid until the next view call or mutation
+ */
+
+class DatabaseMapped final : public DatabaseBase<DatabaseMapped> {
+private:
+    std::string path;
+    int fd = -1;
+    char* base = nullptr;
+    size_t mapped_size = 0;
+
+    // Group table mirrored in memory: name -> index and index -> name
+    std::unordered_map<std::string, uint32_t> group_ids;
+    std::vector<std::string> group_names;
+
+    mutable std::vector<Student> view_buffer;  // Backs view_students_by_group_sorted
+
+    // Creates a fresh file with the given capacities (used by grow)
+    DatabaseMapped(const std::string& file_path, uint32_t record_capacity, uint64_t pool_capacity, uint32_t group_capacity);
+
+    static uint64_t hash(std::string_view key);
+
+    bool create(uint32_t record_capacity, uint64_t pool_capacity, uint32_t group_capacity);
+    bool open_existing();
+    void close();
+
+    mapped_format::Header& header() const;
+    mapped_format::GroupEntry* groups() const;
+    uint32_t* phone_buckets() const;
+    uint32_t* surname_buckets() const;
+    mapped_format::Record* records() const;
+    char* pool() const;
+
+    bool in_pool(mapped_format::StringRef ref) const;
+    std::string_view view(mapped_format::StringRef ref) const;
+    Student decode(const mapped_format::Record& record) const;
+    mapped_format::StringRef append_string(std::string_view text);
+    uint32_t find_record(std::string_view phone) const;
+    uint32_t find_or_add_group(const std::string& group);
+
+    void link_keys(uint32_t index);
+    void unlink_keys(uint32_t index);
+    void link_group(uint32_t index);
+    void unlink_group(uint32_t index);
+    void rebuild_links();
+
+    void mark_dirty();
+    bool reserve(uint64_t extra_records, uint64_t extra_pool_bytes, uint32_t extra_groups);
+    bool reserve_for(const Student& student, bool replacing);
+    bool grow(uint32_t record_capacity, uint64_t pool_capacity, uint32_t group_capacity);
+    void insert(const Student& student);
+    void release(uint32_t index);
+
+public:
+    // for_each_student decodes each record into a temporary
+    static constexpr bool STABLE_VISIT = false;
+
+    /**
+     * @brief Open file_path, or create an empty database there if it does not exist
+     */
+    explicit DatabaseMapped(const std::string& file_path);
+
+    /**
+     * @brief Create (or truncate) file_path and fill it with initial_data
+     */
+    DatabaseMapped(const std::string& file_path, const std::vector<Student>& initial_data);
+
+    ~DatabaseMapped() override;
+
+    DatabaseMapped(const DatabaseMapped&) = delete;
+    DatabaseMapped& operator=(const DatabaseMapped&) = delete;
+
+    /**
+     * @brief Check whether the file was opened and validated
+     */
+    bool is_open() const;
+
+    /**
+     * @brief Write all changes back to the file (msync) and clear the dirty flag
+     * @return false if msync failed or no file is open
+     */
+    bool flush();
+
+    /**
+     * @brief Path of the backing file
+     */
+    const std::string& file_path() const;
+
+    bool load_from_file(const std::string& filename) override;
+    void add(const Student& student) override;
+    bool remove_by_phone(const std::string& phone_number) override;
+
+    size_t size() const override;
+    bool empty() const override;
+    void clear() override;
+    std::vector<Student> to_vector() const override;
+
+    bool change_group_by_phone(const std::string& phone_number, const std::string& new_group) override;
+    std::vector<Student> get_students_by_group_sorted(const std::string& group) const override;
+    std::vector<std::string> get_groups_by_surname(const std::string& surname) const override;
+    void view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const override;
+    void view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const override;
+    void for_each_student(const std::function<void(const Student&)>& visitor) const override;
+
+    size_t estimate_memory_usage() const override;
+    std::string get_container_name() const override;
+};
@@ -3,7 +3,7 @@
 #include <map>
 #include <string>
 
-#include "database_interface.hpp"
+#include "database_base.hpp"
 
 /**
  * @brief Approach 3: Database implementation using std::map (Balanced BST - Red-Black Tree)
@@ -11,16 +11,21 @@
  * Container: std::map<std::string, Student>
  */
 
-class DatabaseTreeMap : public IStudentDatabase {
+class DatabaseTreeMap final : public DatabaseBase<DatabaseTreeMap> {
 private:
     std::map<std::string, Student> data; // phone -> Student (sorted by phone)
 
+    /**
+     * @brief Fill an empty map from rows sorted by phone, appending each node at the end hint
+     * Duplicate phones keep the last row, as data[phone] = student would.
+     */
+    void bulk_load(const std::vector<Student>& students);
+
 public:
     DatabaseTreeMap();
     explicit DatabaseTreeMap(const std::vector<Student>& initial_data);
     
     bool load_from_file(const std::string& filename) override;
-    bool save_to_file(const std::string& filename) const override;
     void add(const Student& student) override;
     bool remove_by_phone(const std::string& phone_number) override;
 
@@ -32,9 +37,11 @@ public:
     bool change_group_by_phone(const std::string& phone_number, const std::string& new_group) override;
     std::vector<Student> get_students_by_group_sorted(const std::string& group) const override;
     std::vector<std::string> get_groups_by_surname(const std::string& surname) const override;
-    bool sort_by_rating_and_save(const std::string& filename,
-                                  std::function<void(std::vector<Student>&, std::function<bool(const Student&, const Student&)>)> sort_func,
-                                  bool ascending = true) override;
+    void view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const override;
+    void view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const override;
+    void for_each_student(const std::function<void(const Student&)>& visitor) const override;
+    std::vector<std::vector<std::string>> get_groups_by_surnames(const std::vector<std::string>& surnames) const override;
+    std::vector<std::vector<Student>> get_students_by_groups_sorted(const std::vector<std::string>& groups) const override;
     
     size_t estimate_memory_usage() const override;
     std::string get_container_name() const override;
@@ -1,26 +1,84 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 #include <string>
+#include <unordered_map>
 
-#include "database_interface.hpp"
+#include "database_base.hpp"
 
 /**
  * @brief Approach 1: Database implementation using std::vector
  * 
- * Container: std::vector<Student>
+ * Container: std::vector<Student>, split into blocks of BLOCK_SIZE students
+ * Optional side index: std::unordered_map<phone, position> for O(1) point operations
+ *
+ * add() upserts by phone like the map engines. Removal swaps the last student into the hole
+ * and pops, so storage order is not insertion order once anything has been removed.
+ *
+ * Blocks, the block table and the phone index are shared copy-on-write, so copying the engine
+ * (and snapshot()) is O(1). After a copy, a write copies the block table and the one block it
+ * touches; adding or removing a phone also copies the phone index.
  */
 
-class DatabaseVector : public IStudentDatabase {
+class DatabaseVector final : public DatabaseBase<DatabaseVector> {
 private:
-    std::vector<Student> data;
+    static constexpr size_t BLOCK_SIZE = 4096;
+
+    using Block = std::vector<Student>;                          // Every block but the last is full
+    using BlockTable = std::vector<std::shared_ptr<const Block>>;
+    using PhoneIndex = std::unordered_map<std::string, size_t>;  // phone -> position
+
+    std::shared_ptr<const BlockTable> blocks;
+    size_t count;
+    
+    bool use_phone_index;
+    std::shared_ptr<const PhoneIndex> phone_index;  // Empty unless use_phone_index
+    
+    const Student& at(size_t position) const {
+        return (*(*blocks)[position / BLOCK_SIZE])[position % BLOCK_SIZE];
+    }
+    
+    /**
+     * @brief Writable student at position; copies the block table and block if a snapshot shares them
+     */
+    Student& mutable_at(size_t position);
+    
+    /**
+     * @brief Call visit(student) for every student in storage order
+     */
+    template <typename Visit>
+    void for_each_record(Visit&& visit) const {
+        for (const auto& block : *blocks) {
+            for (const auto& student : *block) {
+                visit(student);
+            }
+        }
+    }
+    
+    void push_back(const Student& student);
+    void pop_back();
+    
+    /**
+     * @brief Position of the student with phone_number, or size() if absent
+     */
+    size_t find_position(const std::string& phone_number) const;
+    
+    /**
+     * @brief Replace the contents, keeping the first position and the last row of each phone
+     */
+    void bulk_load(const std::vector<Student>& students);
 
 public:
-    DatabaseVector();
-    explicit DatabaseVector(const std::vector<Student>& initial_data);
+    static constexpr bool SHARED_SNAPSHOT = true;
+    
+    /**
+     * @param use_phone_index Keep the phone -> position index; without it point operations scan
+     */
+    explicit DatabaseVector(bool use_phone_index = true);
+    explicit DatabaseVector(const std::vector<Student>& initial_data, bool use_phone_index = true);
     
     bool load_from_file(const std::string& filename) override;
-    bool save_to_file(const std::string& filename) const override;
     void add(const Student& student) override;
     bool remove_by_phone(const std::string& phone_number) override;
 
@@ -32,9 +90,14 @@ public:
     bool change_group_by_phone(const std::string& phone_number, const std::string& new_group) override;
     std::vector<Student> get_students_by_group_sorted(const std::string& group) const override;
     std::vector<std::string> get_groups_by_surname(const std::string& surname) const override;
-    bool sort_by_rating_and_save(const std::string& filename,
-                                  std::function<void(std::vector<Student>&, std::function<bool(const Student&, const Student&)>)> sort_func,
-                                  bool ascending = true) override;
+    void view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const override;
+    void view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const override;
+    void for_each_student(const std::function<void(const Student&)>& visitor) const override;
+    size_t change_group_batch(const std::vector<std::pair<std::string, std::string>>& changes) override;
+    std::vector<std::vector<std::string>> get_groups_by_surnames(const std::vector<std::string>& surnames) const override;
+    std::vector<std::vector<Student>> get_students_by_groups_sorted(const std::vector<std::string>& groups) const override;
+    
+    std::unique_ptr<IStudentDatabase> snapshot() const override;  // O(1): shares every block
     
     size_t estimate_memory_usage() const override;
     std::string get_container_name() const override;
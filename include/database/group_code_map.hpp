@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "group_code.hpp"
+
+namespace indexing {
+
+    /**
+     * @brief Group name -> T, keyed by GroupCode in an open-addressed table over occupied codes
+     *
+     * A regular name is encoded arithmetically and found with a Fibonacci-hashed probe into a
+     * flat array (load factor <= 1/2, so the first probe almost always hits); no string is
+     * hashed or compared. A fully direct-addressed table would cost CARDINALITY slots per
+     * engine however few groups exist. Irregular names get codes >= CARDINALITY from a
+     * side dictionary and then share the same table.
+     */
+    template <typename T>
+    class GroupCodeMap {
+    private:
+        std::vector<uint32_t> codes;  // GroupCode::INVALID marks an empty slot
+        std::vector<T> values;
+        size_t occupied = 0;
+        unsigned shift = 32;
+
+        std::unordered_map<std::string, uint32_t> irregular_codes;
+
+        size_t slot_of(uint32_t code) const {
+            return static_cast<uint32_t>(code * 2654435769u) >> shift;
+        }
+
+        size_t probe(uint32_t code) const {
+            size_t mask = codes.size() - 1;
+            size_t slot = slot_of(code);
+
+            while (codes[slot] != code && codes[slot] != GroupCode::INVALID) {
+                slot = (slot + 1) & mask;
+            }
+
+            return slot;
+        }
+
+        void rehash(size_t capacity) {
+            std::vector<uint32_t> old_codes(capacity, GroupCode::INVALID);
+            std::vector<T> old_values(capacity);
+            old_codes.swap(codes);    // codes / values are now the empty new table
+            old_values.swap(values);
+
+            shift = 32;
+            for (size_t c = capacity; c > 1; c >>= 1) {
+                --shift;
+            }
+
+            for (size_t i = 0; i < old_codes.size(); ++i) {
+                if (old_codes[i] != GroupCode::INVALID) {
+                    size_t slot = probe(old_codes[i]);
+                    codes[slot] = old_codes[i];
+                    values[slot] = std::move(old_values[i]);
+                }
+            }
+        }
+
+        uint32_t code_of(const std::string& group) const {
+            GroupCode code = GroupCode::encode(group);
+
+            if (code.value != GroupCode::INVALID) {
+                return code.value;
+            }
+
+            auto it = irregular_codes.find(group);
+            return it != irregular_codes.end() ? it->second : GroupCode::INVALID;
+        }
+
+    public:
+        /**
+         * @brief Value filed under group, or nullptr
+         */
+        const T* find(const std::string& group) const {
+            uint32_t code = code_of(group);
+
+            if (code == GroupCode::INVALID || codes.empty()) {
+                return nullptr;
+            }
+
+            size_t slot = probe(code);
+            return codes[slot] == code ? &values[slot] : nullptr;
+        }
+
+        T* find(const std::string& group) {
+            return const_cast<T*>(static_cast<const GroupCodeMap&>(*this).find(group));
+        }
+
+        /**
+         * @brief Value filed under group, default-constructed on first use
+         */
+        T& operator[](const std::string& group) {
+            uint32_t code = code_of(group);
+
+            if (code == GroupCode::INVALID) {
+                code = GroupCode::CARDINALITY + static_cast<uint32_t>(irregular_codes.size());
+                irregular_codes.emplace(group, code);
+            }
+
+            if ((occupied + 1) * 2 > codes.size()) {
+                rehash(codes.empty() ? 16 : codes.size() * 2);
+            }
+
+            size_t slot = probe(code);
+
+            if (codes[slot] == GroupCode::INVALID) {
+                codes[slot] = code;
+                occupied++;
+            }
+
+            return values[slot];
+        }
+
+        /**
+         * @brief Remove the value filed under group, if any
+         *
+         * Backward-shift deletion: later entries of the probe run move up into the hole, so
+         * lookups never need tombstones. An irregular name keeps its code in the dictionary.
+         */
+        void erase(const std::string& group) {
+            uint32_t code = code_of(group);
+
+            if (code == GroupCode::INVALID || codes.empty()) {
+                return;
+            }
+
+            size_t mask = codes.size() - 1;
+            size_t hole = probe(code);
+
+            if (codes[hole] != code) {
+                return;
+            }
+
+            codes[hole] = GroupCode::INVALID;
+            values[hole] = T();
+            occupied--;
+
+            for (size_t slot = (hole + 1) & mask; codes[slot] != GroupCode::INVALID; slot = (slot + 1) & mask) {
+                size_t home = slot_of(codes[slot]);
+
+                // The entry may fill the hole only if the hole lies between its home slot and its slot
+                if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+                    codes[hole] = codes[slot];
+                    values[hole] = std::move(values[slot]);
+                    codes[slot] = GroupCode::INVALID;
+                    values[slot] = T();
+                    hole = slot;
+                }
+            }
+        }
+
+        /**
+         * @brief Visit (code, value) for every group currently filed
+         */
+        template <typename Visitor>
+        void for_each(Visitor&& visitor) const {
+            for (size_t i = 0; i < codes.size(); ++i) {
+                if (codes[i] != GroupCode::INVALID) {
+                    visitor(GroupCode{codes[i]}, values[i]);
+                }
+            }
+        }
+
+        size_t size() const {
+            return occupied;
+        }
+
+        void clear() {
+            codes.clear();
+            values.clear();
+            irregular_codes.clear();
+            occupied = 0;
+            shift = 32;
+        }
+
+        /**
+         * @brief Table and dictionary bytes, excluding anything owned by the values
+         */
+        size_t estimate_memory_usage() const {
+            size_t memory = codes.capacity() * sizeof(uint32_t) + values.capacity() * sizeof(T);
+
+            memory += irregular_codes.bucket_count() * sizeof(void*);
+            for (const auto& pair : irregular_codes) {
+                memory += sizeof(std::string) + sizeof(uint32_t) + sizeof(void*) + pair.first.capacity();
+            }
+
+            return memory;
+        }
+    };
+}
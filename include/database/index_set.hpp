@@ -0,0 +1,312 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "student.hpp"
+#include "radix_tree.hpp"
+
+/**
+ * @brief Compile-time declarative secondary indices over Student records
+ *
+ * An engine declares its indices as a type list, e.g.
+ *     IndexSet<Index<&Student::m_group, Ordered>, Index<&Student::m_surname, Hashed>>
+ * and calls insert / erase / modify on every mutation. Maintenance for every index is
+ * expanded at compile time (fold expressions over the tuple), with no virtual dispatch.
+ *
+ * The key extractor is anything std::invoke accepts with a const Student& - a data member
+ * pointer or a free function such as a packed birth date. Indices store const Student*
+ * handles, so records must live in node-stable storage (e.g. std::unordered_map values).
+ */
+namespace indexing {
+
+    /**
+     * @brief Index kinds: ordered (std::multimap, supports range scans), hashed (std::unordered_multimap)
+     *        or prefix (RadixTree over a string key, supports prefix scans)
+     */
+    struct Ordered {};
+    struct Hashed {};
+    struct Prefix {};
+
+    template <auto Extractor>
+    using key_of = std::decay_t<std::invoke_result_t<decltype(Extractor), const Student&>>;
+
+    template <typename Kind, typename Key>
+    struct storage_for;
+
+    template <typename Key>
+    struct storage_for<Ordered, Key> {
+        using type = std::multimap<Key, const Student*>;
+        static constexpr size_t node_overhead = sizeof(void*) * 3 + sizeof(int);  // parent, left, right, color
+    };
+
+    template <typename Key>
+    struct storage_for<Hashed, Key> {
+        using type = std::unordered_multimap<Key, const Student*>;
+        static constexpr size_t node_overhead = sizeof(void*) + sizeof(size_t);   // next, cached hash
+    };
+
+    /**
+     * @brief Single secondary index: key(student) -> student handle
+     */
+    template <auto Extractor, typename Kind>
+    class Index {
+    public:
+        using key_type = key_of<Extractor>;
+        using kind = Kind;
+        using storage_type = typename storage_for<Kind, key_type>::type;
+        using const_iterator = typename storage_type::const_iterator;
+
+        static decltype(auto) key(const Student& student) {
+            return std::invoke(Extractor, student);
+        }
+
+        void insert(const Student* student) {
+            entries.emplace(key(*student), student);
+        }
+
+        void erase(const Student* student) {
+            erase(key(*student), student);
+        }
+
+        /**
+         * @brief Remove the entry filed under an explicit (possibly stale) key
+         */
+        void erase(const key_type& indexed_key, const Student* student) {
+            auto range = entries.equal_range(indexed_key);
+
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == student) {
+                    entries.erase(it);
+                    return;
+                }
+            }
+        }
+
+        /**
+         * @brief Move the entry to the student's current key if it differs from old_key
+         */
+        void rekey(const key_type& old_key, const Student* student) {
+            if (key(*student) == old_key) {
+                return;
+            }
+
+            erase(old_key, student);
+            insert(student);
+        }
+
+        void clear() {
+            entries.clear();
+        }
+
+        size_t size() const {
+            return entries.size();
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const key_type& lookup) const {
+            return entries.equal_range(lookup);
+        }
+
+        /**
+         * @brief Call visitor(const Student&) for every record with key == lookup
+         */
+        template <typename Visitor>
+        void for_each_equal(const key_type& lookup, Visitor&& visitor) const {
+            auto range = entries.equal_range(lookup);
+
+            for (auto it = range.first; it != range.second; ++it) {
+                visitor(*it->second);
+            }
+        }
+
+        /**
+         * @brief Call visitor(const Student&) for every record with low <= key <= high (Ordered only)
+         */
+        template <typename Visitor, typename K = Kind>
+        void for_each_in_range(const key_type& low, const key_type& high, Visitor&& visitor) const {
+            static_assert(std::is_same_v<K, Ordered>, "range scans need an Ordered index");
+
+            if (high < low) {
+                return;
+            }
+
+            auto end = entries.upper_bound(high);
+
+            for (auto it = entries.lower_bound(low); it != end; ++it) {
+                visitor(*it->second);
+            }
+        }
+
+        /**
+         * @brief Visit records with key >= low in key order while visitor(const Student&) returns true (Ordered only)
+         */
+        template <typename Visitor, typename K = Kind>
+        void scan_from(const key_type& low, Visitor&& visitor) const {
+            static_assert(std::is_same_v<K, Ordered>, "ordered scans need an Ordered index");
+
+            for (auto it = entries.lower_bound(low); it != entries.end(); ++it) {
+                if (!visitor(*it->second)) {
+                    return;
+                }
+            }
+        }
+
+        size_t estimate_memory_usage() const {
+            size_t memory = entries.size() * (sizeof(typename storage_type::value_type)
+                                              + storage_for<Kind, key_type>::node_overhead);
+
+            if constexpr (std::is_same_v<Kind, Hashed>) {
+                memory += entries.bucket_count() * sizeof(void*);
+            }
+
+            if constexpr (std::is_same_v<key_type, std::string>) {
+                for (const auto& pair : entries) {
+                    memory += pair.first.capacity();
+                }
+            }
+
+            return memory;
+        }
+
+    private:
+        storage_type entries;
+    };
+
+    /**
+     * @brief Prefix index over a string field: exact lookups plus ordered, limited prefix scans
+     */
+    template <auto Extractor>
+    class Index<Extractor, Prefix> {
+    public:
+        using key_type = key_of<Extractor>;
+        using kind = Prefix;
+
+        static_assert(std::is_same_v<key_type, std::string>, "prefix indices need a string key");
+
+        static decltype(auto) key(const Student& student) {
+            return std::invoke(Extractor, student);
+        }
+
+        void insert(const Student* student) {
+            tree.insert(key(*student), student);
+        }
+
+        void erase(const Student* student) {
+            tree.erase(key(*student), student);
+        }
+
+        void erase(const key_type& indexed_key, const Student* student) {
+            tree.erase(indexed_key, student);
+        }
+
+        void rekey(const key_type& old_key, const Student* student) {
+            if (key(*student) == old_key) {
+                return;
+            }
+
+            tree.erase(old_key, student);
+            insert(student);
+        }
+
+        void clear() {
+            tree.clear();
+        }
+
+        size_t size() const {
+            return tree.size();
+        }
+
+        template <typename Visitor>
+        void for_each_equal(const key_type& lookup, Visitor&& visitor) const {
+            const auto* handles = tree.find(lookup);
+
+            if (!handles) {
+                return;
+            }
+
+            for (const Student* student : *handles) {
+                visitor(*student);
+            }
+        }
+
+        size_t count_prefix(const std::string& prefix) const {
+            return tree.count_prefix(prefix);
+        }
+
+        /**
+         * @brief Append up to limit (0 = all) records whose key starts with prefix, in key order
+         */
+        void collect_prefix(const std::string& prefix, size_t limit, std::vector<const Student*>& out) const {
+            tree.collect_prefix(prefix, limit, out);
+        }
+
+        size_t estimate_memory_usage() const {
+            return tree.estimate_memory_usage();
+        }
+
+    private:
+        RadixTree tree;
+    };
+
+    /**
+     * @brief Fixed set of indices maintained together; indices are looked up by type
+     */
+    template <typename... Indices>
+    class IndexSet {
+    public:
+        template <typename I>
+        I& get() {
+            return std::get<I>(indices);
+        }
+
+        template <typename I>
+        const I& get() const {
+            return std::get<I>(indices);
+        }
+
+        void insert(const Student* student) {
+            std::apply([student](auto&... index) { (index.insert(student), ...); }, indices);
+        }
+
+        void erase(const Student* student) {
+            std::apply([student](auto&... index) { (index.erase(student), ...); }, indices);
+        }
+
+        void clear() {
+            std::apply([](auto&... index) { (index.clear(), ...); }, indices);
+        }
+
+        /**
+         * @brief Apply mutate(Student&) to an indexed record and re-file it where its keys changed
+         */
+        template <typename Mutator>
+        void modify(Student& student, Mutator&& mutate) {
+            modify_impl(student, mutate, std::index_sequence_for<Indices...>{});
+        }
+
+        size_t estimate_memory_usage() const {
+            return std::apply([](const auto&... index) {
+                return (size_t(0) + ... + index.estimate_memory_usage());
+            }, indices);
+        }
+
+    private:
+        std::tuple<Indices...> indices;
+
+        template <typename Mutator, size_t... I>
+        void modify_impl(Student& student, Mutator& mutate, std::index_sequence<I...>) {
+            std::tuple<typename Indices::key_type...> old_keys{Indices::key(student)...};
+
+            mutate(student);
+
+            (std::get<I>(indices).rekey(std::get<I>(old_keys), &student), ...);
+        }
+    };
+}
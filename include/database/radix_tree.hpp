@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "student.hpp"
+
+namespace indexing {
+
+    /**
+     * @brief Compressed trie (radix tree) from string keys to Student handles
+     *
+     * Edges carry whole substrings and nodes with a single child and no values are merged
+     * on removal, so depth is bounded by the number of distinct branching points rather than
+     * key length. Every node keeps the number of handles in its subtree, which makes prefix
+     * counts O(|prefix|) and lets limited prefix scans size their output up front.
+     */
+    class RadixTree {
+    public:
+        using Handle = const Student*;
+
+        void insert(const std::string& key, Handle handle);
+
+        /**
+         * @brief Remove handle filed under key
+         * @return true if it was present
+         */
+        bool erase(const std::string& key, Handle handle);
+
+        void clear();
+        size_t size() const;
+
+        /**
+         * @brief Handles stored under exactly key, nullptr if none (unordered)
+         */
+        const std::vector<Handle>* find(const std::string& key) const;
+
+        /**
+         * @brief Number of handles whose key starts with prefix
+         */
+        size_t count_prefix(const std::string& prefix) const;
+
+        /**
+         * @brief Append handles whose key starts with prefix, ordered by key, then by
+         *        student_comparators::compare_by_surname_name_and_phone
+         * @param limit Maximum number of handles to append (0 = no limit)
+         */
+        void collect_prefix(const std::string& prefix, size_t limit, std::vector<Handle>& out) const;
+
+        size_t estimate_memory_usage() const;
+
+    private:
+        struct Node {
+            std::string label;                           // Edge label from the parent
+            std::vector<std::unique_ptr<Node>> children; // Sorted by first label character
+            std::vector<Handle> values;                  // Handles whose key ends here
+            size_t count = 0;                            // Handles in this subtree
+        };
+
+        Node root;
+
+        using ChildIterator = std::vector<std::unique_ptr<Node>>::iterator;
+        using ConstChildIterator = std::vector<std::unique_ptr<Node>>::const_iterator;
+
+        static ChildIterator find_child(Node& node, char first);
+        static ConstChildIterator find_child(const Node& node, char first);
+        static void insert(Node& node, const std::string& key, size_t pos, Handle handle);
+        static bool erase(Node& node, const std::string& key, size_t pos, Handle handle);
+        static void collect(const Node& node, size_t limit, std::vector<Handle>& out);
+        static size_t node_memory(const Node& node);
+
+        const Node* find_prefix_node(const std::string& prefix) const;
+    };
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace indexing {
+
+    /**
+     * @brief Compressed bitmap over 32-bit record ids (roaring layout)
+     *
+     * Ids are split into a 16-bit chunk key and a 16-bit low part. Each non-empty chunk is a
+     * container: a sorted uint16_t array while it holds at most ARRAY_MAX values, or a fixed
+     * 65536-bit bitmap above that. Sparse sets cost ~2 bytes per id, dense sets 1 bit per id,
+     * and set algebra runs container by container with the cheapest kernel for each pair.
+     * Run-length containers are not implemented.
+     */
+    class RoaringBitmap {
+    public:
+        static constexpr uint32_t ARRAY_MAX = 4096;  // Array beyond this is larger than a bitmap
+
+        void add(uint32_t value);
+
+        /**
+         * @return true if value was present
+         */
+        bool remove(uint32_t value);
+
+        bool contains(uint32_t value) const;
+        uint64_t cardinality() const;
+        bool empty() const;
+        void clear();
+
+        /**
+         * @brief a AND b
+         */
+        static RoaringBitmap intersect(const RoaringBitmap& a, const RoaringBitmap& b);
+
+        /**
+         * @brief a OR b
+         */
+        static RoaringBitmap unite(const RoaringBitmap& a, const RoaringBitmap& b);
+
+        /**
+         * @brief a AND NOT b
+         */
+        static RoaringBitmap subtract(const RoaringBitmap& a, const RoaringBitmap& b);
+
+        /**
+         * @brief |a AND b| without materializing the result
+         */
+        static uint64_t intersect_cardinality(const RoaringBitmap& a, const RoaringBitmap& b);
+
+        /**
+         * @brief (a AND b) is non-empty; stops at the first common id
+         */
+        static bool intersects(const RoaringBitmap& a, const RoaringBitmap& b);
+
+        /**
+         * @brief Visit every id in ascending order
+         */
+        template <typename Visitor>
+        void for_each(Visitor&& visitor) const {
+            for (size_t i = 0; i < containers.size(); ++i) {
+                uint32_t high = uint32_t(keys[i]) << 16;
+                const Container& container = containers[i];
+
+                if (container.is_bitmap()) {
+                    for (uint32_t word = 0; word < BITMAP_WORDS; ++word) {
+                        uint64_t bits = container.bits[word];
+
+                        while (bits) {
+                            visitor(high | (word * 64 + uint32_t(__builtin_ctzll(bits))));
+                            bits &= bits - 1;
+                        }
+                    }
+                } else {
+                    for (uint16_t low : container.array) {
+                        visitor(high | low);
+                    }
+                }
+            }
+        }
+
+        size_t estimate_memory_usage() const;
+
+    private:
+        static constexpr uint32_t BITMAP_WORDS = 65536 / 64;
+
+        struct Container {
+            std::vector<uint16_t> array;  // Sorted low parts (array form)
+            std::vector<uint64_t> bits;   // BITMAP_WORDS words (bitmap form), empty otherwise
+            uint32_t cardinality = 0;
+
+            bool is_bitmap() const {
+                return !bits.empty();
+            }
+        };
+
+        std::vector<uint16_t> keys;  // Sorted chunk keys, parallel to containers
+        std::vector<Container> containers;
+
+        static void to_bitmap(Container& container);
+        static void to_array(Container& container);
+        static void normalize(Container& container);
+
+        static Container intersect(const Container& a, const Container& b);
+        static Container unite(const Container& a, const Container& b);
+        static Container subtract(const Container& a, const Container& b);
+        static uint32_t intersect_cardinality(const Container& a, const Container& b);
+        static bool intersects(const Container& a, const Container& b);
+
+        void append(uint16_t key, Container&& container);
+    };
+}
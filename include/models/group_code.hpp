@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Dense integer code for group names of the form [A-Z][A-Z][A-Z]-[0-9][0-9]
+ *
+ * The 26^3 * 100 = 1,757,600 regular names map bijectively onto [0, CARDINALITY), which fits
+ * in 21 bits. Encoding and decoding are straight-line arithmetic with no per-character branches.
+ * Names outside the format have no code (INVALID); engines give them codes >= CARDINALITY
+ * from a side dictionary, so one integer key space covers every group.
+ */
+struct GroupCode {
+    static constexpr uint32_t CARDINALITY = 26u * 26u * 26u * 100u;
+    static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+
+    uint32_t value;
+
+    /**
+     * @brief Encode a group name
+     * @return Code in [0, CARDINALITY), or INVALID if the name does not match the format
+     */
+    static GroupCode encode(const std::string& group) {
+        if (group.size() != 6) {
+            return GroupCode{INVALID};
+        }
+
+        uint32_t l0 = static_cast<unsigned char>(group[0]) - uint32_t('A');
+        uint32_t l1 = static_cast<unsigned char>(group[1]) - uint32_t('A');
+        uint32_t l2 = static_cast<unsigned char>(group[2]) - uint32_t('A');
+        uint32_t d0 = static_cast<unsigned char>(group[4]) - uint32_t('0');
+        uint32_t d1 = static_cast<unsigned char>(group[5]) - uint32_t('0');
+
+        // Unsigned wrap-around turns each range check into one comparison; combine without branching
+        uint32_t valid = (l0 < 26) & (l1 < 26) & (l2 < 26) & (group[3] == '-') & (d0 < 10) & (d1 < 10);
+        uint32_t code = ((l0 * 26 + l1) * 26 + l2) * 100 + d0 * 10 + d1;
+
+        return GroupCode{valid ? code : INVALID};
+    }
+
+    /**
+     * @brief Decode a regular code back to its name (is_regular() must hold)
+     */
+    std::string decode() const {
+        std::string group(6, '-');
+
+        group[5] = static_cast<char>('0' + value % 10);
+        group[4] = static_cast<char>('0' + value / 10 % 10);
+        group[2] = static_cast<char>('A' + value / 100 % 26);
+        group[1] = static_cast<char>('A' + value / 2600 % 26);
+        group[0] = static_cast<char>('A' + value / 67600);
+
+        return group;
+    }
+
+    /**
+     * @brief Check whether the code came from a name in the documented format
+     */
+    bool is_regular() const {
+        return value < CARDINALITY;
+    }
+
+    bool operator==(GroupCode other) const {
+        return value == other.value;
+    }
+
+    bool operator!=(GroupCode other) const {
+        return value != other.value;
+    }
+};
@@ -30,6 +30,12 @@ struct Student {
      * @return Full name (surname + name)
      */
     std::string get_full_name() const;
+    
+    /**
+     * @brief Get birth date packed as YYYYMMDD
+     * @return Integer that orders the same way as the date (e.g. 20010315)
+     */
+    int get_packed_birth_date() const;
         
 };
 
@@ -42,6 +48,31 @@ namespace student_comparators {
      */
     bool compare_by_surname_and_name(const Student& a, const Student& b);
     
+    /**
+     * @brief Same ordering as compare_by_surname_and_name for zero-copy views
+     */
+    bool compare_ptr_by_surname_and_name(const Student* a, const Student* b);
+    
+    /**
+     * @brief Total order for prefix queries: surname, name, then phone number
+     */
+    bool compare_by_surname_name_and_phone(const Student& a, const Student& b);
+    
+    /**
+     * @brief Total order for top-K reports: rating (descending, NaN last), then phone number
+     */
+    bool compare_by_rating_desc_and_phone(const Student& a, const Student& b);
+    
+    /**
+     * @brief Total order for rating range queries: rating (ascending), then phone number
+     */
+    bool compare_by_rating_and_phone(const Student& a, const Student& b);
+    
+    /**
+     * @brief Total order for birth range queries: birth date, then phone number
+     */
+    bool compare_by_birth_date_and_phone(const Student& a, const Student& b);
+    
     /**
      * @brief Compare students by rating (ascending order)
      */
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief External-memory sort of a student CSV by rating
+ *
+ * The input is read in chunks whose in-memory size stays under the memory budget; each
+ * chunk is sorted (stable radix sort on the float rating) and spilled to a temporary run
+ * file in a compact binary form. The runs are then k-way merged through a loser tree
+ * straight into the CSV writer; when there are more runs than the budget allows read
+ * buffers for, groups of adjacent runs are merged into longer runs first. Equal ratings
+ * keep their input order, so the output matches an in-memory stable sort.
+ */
+namespace external_sort {
+
+    struct Options {
+        size_t memory_budget = size_t(64) << 20;  // Bytes for the current chunk / merge buffers
+        bool ascending = true;
+        std::string temp_dir;                     // Run files directory; empty: system temp directory
+    };
+
+    struct Stats {
+        size_t records = 0;
+        size_t runs = 0;           // Sorted runs spilled by the chunking phase
+        size_t merge_passes = 0;   // Passes over the data after chunking (0: a single chunk)
+        size_t fan_in = 0;         // Runs merged at once
+    };
+
+    /**
+     * @brief Sort the CSV at input by rating into output without loading it whole
+     * @param input Student CSV (with header line)
+     * @param output CSV to write, same format as csv::write_csv
+     * @param options Memory budget, direction and temporary directory
+     * @param stats Optional counters filled on success
+     * @return true if successful, false otherwise (temporary files are removed either way)
+     */
+    bool sort_csv_by_rating(const std::string& input, const std::string& output, const Options& options,
+                            Stats* stats = nullptr);
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <vector>
 #include <functional>
 
@@ -35,12 +36,22 @@ namespace sort_algorithms {
     void merge_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator);
     
     /**
-     * @brief Quick sort implementation
+     * @brief Quick sort implementation (pattern-defeating quicksort, O(n log n) worst case)
+     * Linear on already sorted input and on runs of equal ratings. Not stable.
      * @param data Vector of Students to sort
      * @param comparator Comparison function
      */
     void quick_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator);
     
+    /**
+     * @brief Tim sort implementation (adaptive natural merge sort, powersort merge order)
+     * Detects existing runs and gallops through merges: O(n) on sorted, reversed or
+     * nearly sorted input. Stable.
+     * @param data Vector of Students to sort
+     * @param comparator Comparison function
+     */
+    void tim_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator);
+    
     /**
      * @brief Heap sort implementation
      * @param data Vector of Students to sort
@@ -57,11 +68,86 @@ namespace sort_algorithms {
     
     /**
      * @brief Radix Sort implementation for floating point values (rating)
-     * This is a custom implementation optimized for Student rating sorting
-     * Uses counting sort on the integer and fractional parts separately
+     * LSD radix sort on the order-preserving bits of the float rating, so ratings are never
+     * bucketed or truncated. Stable.
      * @param data Vector of Students to sort
-     * @param comparator Comparison function (ascending/descending)
+     * @param comparator Comparison function, only probed once for the direction
      */
     void radix_sort_by_rating(std::vector<Student>& data, 
                              std::function<bool(const Student&, const Student&)> comparator);
-}
\ No newline at end of file
+    
+    /**
+     * @brief Student fields radix_sort_students can sort by
+     */
+    enum class RadixKey {
+        Rating,     // float, via ordered_float_bits
+        BirthDate   // packed YYYYMMDD int, via ordered_int_bits
+    };
+    
+    /**
+     * @brief Stable LSD radix sort with an explicit direction
+     * @param data Vector of Students to sort
+     * @param key Field to sort by
+     * @param ascending Sort direction
+     */
+    void radix_sort_students(std::vector<Student>& data, RadixKey key, bool ascending);
+    
+    /**
+     * @brief Sort by surname, then name (the compare_by_surname_and_name order)
+     * Multikey quicksort over (surname, name) key views: partitions on one character at a
+     * time, so a prefix shared by many keys is read once per level instead of once per
+     * comparison. Students with equal surname and name keep their input order.
+     * @param data Vector of Students to sort
+     */
+    void multikey_sort_by_surname_and_name(std::vector<Student>& data);
+    
+    /**
+     * @brief multikey_sort_by_surname_and_name for zero-copy views (sorts the pointers)
+     * @param data Vector of Student pointers to sort
+     */
+    void multikey_sort_by_surname_and_name(std::vector<const Student*>& data);
+    
+    /**
+     * @brief Stable parallel merge sort on a work-stealing pool
+     * Leaf blocks are sorted in parallel, then runs are merged in parallel slices found by
+     * merge-path splitting, using one scratch buffer of n elements. Inputs shorter than
+     * generic::PARALLEL_MERGE_MIN are sorted on the calling thread.
+     * @param data Vector of Students to sort
+     * @param comparator Comparison function (called concurrently)
+     * @param thread_count Threads including the caller (0 means hardware_concurrency)
+     */
+    void parallel_merge_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator,
+                             size_t thread_count = 0);
+    
+    /**
+     * @brief Comparison sorts available in keyed mode
+     */
+    enum class Algorithm {
+        Std,
+        Bubble,
+        Insertion,
+        Selection,
+        Merge,
+        Quick,
+        Heap,
+        ParallelMerge,
+        Tim
+    };
+    
+    /**
+     * @brief Keyed rating sort: never moves a Student while sorting
+     * Sorts compact (rating key, index) pairs with the chosen algorithm, then applies one
+     * permutation pass that moves every Student once. Equal ratings keep their input order.
+     * @param data Vector of Students to sort
+     * @param ascending Sort direction
+     * @param algorithm Algorithm that sorts the pairs
+     * @param thread_count Threads for Algorithm::ParallelMerge, including the caller (0 means hardware_concurrency)
+     */
+    void keyed_sort_by_rating(std::vector<Student>& data, bool ascending, Algorithm algorithm, size_t thread_count = 0);
+    
+    /**
+     * @brief Keyed rating sort of pointers: orders the pointers, the Students stay where they are
+     */
+    void keyed_sort_by_rating(std::vector<const Student*>& data, bool ascending, Algorithm algorithm,
+                              size_t thread_count = 0);
+}
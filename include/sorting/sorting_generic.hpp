@@ -0,0 +1,1109 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @file sorting_generic.hpp
+ * Sorting algorithms templated on iterator and comparator type.
+ *
+ * The comparator is taken by value once at the entry point and passed by reference to every
+ * helper, so recursion never copies it. Given a lambda or function object the comparison is
+ * inlined; given a std::function each comparison is one indirect call (the sort_algorithms
+ * wrappers in sorting.hpp do exactly that).
+ */
+
+namespace sort_algorithms::generic {
+
+    // Bubble Sort
+    template <typename RandomIt, typename Compare>
+    void bubble_sort(RandomIt first, RandomIt last, Compare comp) {
+        auto n = last - first;
+
+        for (decltype(n) i = 0; i + 1 < n; ++i) {
+            bool swapped = false;
+
+            for (decltype(n) j = 0; j < n - i - 1; ++j) {
+                if (!comp(first[j], first[j + 1])) {
+                    std::iter_swap(first + j, first + j + 1);
+                    swapped = true;
+                }
+            }
+
+            if (!swapped) {
+                break;
+            }
+        }
+    }
+
+    // Insertion Sort
+    template <typename RandomIt, typename Compare>
+    void insertion_sort(RandomIt first, RandomIt last, Compare comp) {
+        if (first == last) {
+            return;
+        }
+
+        for (RandomIt it = first + 1; it != last; ++it) {
+            auto key = std::move(*it);
+            RandomIt hole = it;
+
+            while (hole != first && !comp(*(hole - 1), key)) {
+                *hole = std::move(*(hole - 1));
+                --hole;
+            }
+
+            *hole = std::move(key);
+        }
+    }
+
+    // Selection Sort
+    template <typename RandomIt, typename Compare>
+    void selection_sort(RandomIt first, RandomIt last, Compare comp) {
+        for (RandomIt it = first; it != last; ++it) {
+            RandomIt min_it = it;
+
+            for (RandomIt scan = it + 1; scan != last; ++scan) {
+                if (comp(*scan, *min_it)) {
+                    min_it = scan;
+                }
+            }
+
+            if (min_it != it) {
+                std::iter_swap(it, min_it);
+            }
+        }
+    }
+
+    namespace detail {
+
+        // Stable merge of [first, mid) and [mid, last) through buffer (holds at least mid - first)
+        template <typename RandomIt, typename Buffer, typename Compare>
+        void merge(RandomIt first, RandomIt mid, RandomIt last, Buffer& buffer, Compare& comp) {
+            buffer.assign(std::make_move_iterator(first), std::make_move_iterator(mid));
+
+            auto left = buffer.begin();
+            RandomIt right = mid;
+            RandomIt out = first;
+
+            while (left != buffer.end() && right != last) {
+                if (comp(*right, *left)) {
+                    *out++ = std::move(*right++);
+                } else {
+                    *out++ = std::move(*left++);
+                }
+            }
+
+            std::move(left, buffer.end(), out);
+        }
+
+        template <typename RandomIt, typename Buffer, typename Compare>
+        void merge_sort(RandomIt first, RandomIt last, Buffer& buffer, Compare& comp) {
+            if (last - first < 2) {
+                return;
+            }
+
+            RandomIt mid = first + (last - first) / 2;
+
+            detail::merge_sort(first, mid, buffer, comp);
+            detail::merge_sort(mid, last, buffer, comp);
+
+            detail::merge(first, mid, last, buffer, comp);
+        }
+
+        // Sift the element at root down a max-heap of n elements
+        template <typename RandomIt, typename Compare>
+        void sift_down(RandomIt first, std::ptrdiff_t n, std::ptrdiff_t root, Compare& comp) {
+            while (true) {
+                std::ptrdiff_t largest = root;
+                std::ptrdiff_t left = 2 * root + 1;
+                std::ptrdiff_t right = 2 * root + 2;
+
+                if (left < n && !comp(first[left], first[largest])) {
+                    largest = left;
+                }
+
+                if (right < n && !comp(first[right], first[largest])) {
+                    largest = right;
+                }
+
+                if (largest == root) {
+                    return;
+                }
+
+                std::iter_swap(first + root, first + largest);
+                root = largest;
+            }
+        }
+
+        template <typename RandomIt, typename Compare>
+        void heap_sort(RandomIt first, RandomIt last, Compare& comp) {
+            std::ptrdiff_t n = last - first;
+
+            for (std::ptrdiff_t i = n / 2 - 1; i >= 0; --i) {
+                detail::sift_down(first, n, i, comp);
+            }
+
+            for (std::ptrdiff_t i = n - 1; i > 0; --i) {
+                std::iter_swap(first, first + i);
+                detail::sift_down(first, i, 0, comp);
+            }
+        }
+
+        // Pattern-defeating quicksort (after Orson Peters' pdqsort)
+
+        constexpr std::ptrdiff_t PDQ_INSERTION_THRESHOLD = 24;
+        constexpr std::ptrdiff_t PDQ_NINTHER_THRESHOLD = 128;
+        constexpr std::ptrdiff_t PDQ_PARTIAL_INSERTION_LIMIT = 8;
+        constexpr std::ptrdiff_t PDQ_BLOCK = 64;
+
+        // Insertion sort of [first, last); unguarded requires *(first - 1) <= every element
+        template <bool Guarded, typename RandomIt, typename Compare>
+        void pdq_insertion_sort(RandomIt first, RandomIt last, Compare& comp) {
+            if (first == last) {
+                return;
+            }
+
+            for (RandomIt cur = first + 1; cur != last; ++cur) {
+                RandomIt hole = cur;
+
+                if (comp(*hole, *(hole - 1))) {
+                    auto key = std::move(*hole);
+
+                    do {
+                        *hole = std::move(*(hole - 1));
+                        --hole;
+                    } while ((!Guarded || hole != first) && comp(key, *(hole - 1)));
+
+                    *hole = std::move(key);
+                }
+            }
+        }
+
+        // Insertion sort that gives up after PDQ_PARTIAL_INSERTION_LIMIT moves; true if it finished
+        template <typename RandomIt, typename Compare>
+        bool pdq_partial_insertion_sort(RandomIt first, RandomIt last, Compare& comp) {
+            if (first == last) {
+                return true;
+            }
+
+            std::ptrdiff_t moves = 0;
+
+            for (RandomIt cur = first + 1; cur != last; ++cur) {
+                RandomIt hole = cur;
+
+                if (comp(*hole, *(hole - 1))) {
+                    auto key = std::move(*hole);
+
+                    do {
+                        *hole = std::move(*(hole - 1));
+                        --hole;
+                    } while (hole != first && comp(key, *(hole - 1)));
+
+                    *hole = std::move(key);
+                    moves += cur - hole;
+                }
+
+                if (moves > PDQ_PARTIAL_INSERTION_LIMIT) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        template <typename RandomIt, typename Compare>
+        void sort2(RandomIt a, RandomIt b, Compare& comp) {
+            if (comp(*b, *a)) {
+                std::iter_swap(a, b);
+            }
+        }
+
+        template <typename RandomIt, typename Compare>
+        void sort3(RandomIt a, RandomIt b, RandomIt c, Compare& comp) {
+            detail::sort2(a, b, comp);
+            detail::sort2(b, c, comp);
+            detail::sort2(a, b, comp);
+        }
+
+        /**
+         * @brief Partition [first, last) around *first: [< pivot] pivot [>= pivot]
+         * @return Pivot position, and whether the range was already partitioned (no swaps)
+         */
+        template <typename RandomIt, typename Compare>
+        std::pair<RandomIt, bool> partition_right(RandomIt first, RandomIt last, Compare& comp) {
+            auto pivot = std::move(*first);
+            RandomIt begin = first;
+
+            // The median-of-3 guarantees an element >= pivot on the right, so the first scan is unguarded
+            while (comp(*++first, pivot)) {}
+
+            if (first - 1 == begin) {
+                while (first < last && !comp(*--last, pivot)) {}
+            } else {
+                while (!comp(*--last, pivot)) {}
+            }
+
+            bool already_partitioned = first >= last;
+
+            while (first < last) {
+                std::iter_swap(first, last);
+                while (comp(*++first, pivot)) {}
+                while (!comp(*--last, pivot)) {}
+            }
+
+            RandomIt pivot_pos = first - 1;
+            *begin = std::move(*pivot_pos);
+            *pivot_pos = std::move(pivot);
+
+            return {pivot_pos, already_partitioned};
+        }
+
+        // Move the num misplaced elements recorded in offsets_l / offsets_r across the partition
+        template <typename RandomIt>
+        void swap_offsets(RandomIt first, RandomIt last, const unsigned char* offsets_l,
+                          const unsigned char* offsets_r, size_t num, bool use_swaps) {
+            if (use_swaps) {
+                // Equal counts: the cyclic rotation below would not close, swap pairwise
+                for (size_t i = 0; i < num; ++i) {
+                    std::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+                }
+            } else if (num > 0) {
+                RandomIt l = first + offsets_l[0];
+                RandomIt r = last - offsets_r[0];
+                auto carried = std::move(*l);
+                *l = std::move(*r);
+
+                for (size_t i = 1; i < num; ++i) {
+                    l = first + offsets_l[i];
+                    *r = std::move(*l);
+                    r = last - offsets_r[i];
+                    *l = std::move(*r);
+                }
+
+                *r = std::move(carried);
+            }
+        }
+
+        /**
+         * @brief partition_right without data-dependent branches in the scan (BlockQuicksort)
+         * Compares a block of PDQ_BLOCK elements from each side, recording the offsets of the
+         * misplaced ones with unconditional stores, then swaps them in one go.
+         */
+        template <typename RandomIt, typename Compare>
+        std::pair<RandomIt, bool> partition_right_branchless(RandomIt first, RandomIt last, Compare& comp) {
+            auto pivot = std::move(*first);
+            RandomIt begin = first;
+
+            while (comp(*++first, pivot)) {}
+
+            if (first - 1 == begin) {
+                while (first < last && !comp(*--last, pivot)) {}
+            } else {
+                while (!comp(*--last, pivot)) {}
+            }
+
+            bool already_partitioned = first >= last;
+
+            if (!already_partitioned) {
+                std::iter_swap(first, last);
+                ++first;
+
+                alignas(64) unsigned char offsets_l[PDQ_BLOCK];
+                alignas(64) unsigned char offsets_r[PDQ_BLOCK];
+
+                RandomIt offsets_l_base = first;
+                RandomIt offsets_r_base = last;
+                size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+                while (first < last) {
+                    // Refill whichever side ran out; split the remainder if both did
+                    size_t num_unknown = static_cast<size_t>(last - first);
+                    size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+                    size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+                    size_t left_count = std::min<size_t>(left_split, PDQ_BLOCK);
+                    for (size_t i = 0; i < left_count; ++i) {
+                        offsets_l[num_l] = static_cast<unsigned char>(i);
+                        num_l += !comp(*first, pivot);
+                        ++first;
+                    }
+
+                    size_t right_count = std::min<size_t>(right_split, PDQ_BLOCK);
+                    for (size_t i = 0; i < right_count; ) {
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(*--last, pivot);
+                    }
+
+                    size_t num = std::min(num_l, num_r);
+                    detail::swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r,
+                                         num, num_l == num_r);
+
+                    num_l -= num;
+                    num_r -= num;
+                    start_l += num;
+                    start_r += num;
+
+                    if (num_l == 0) {
+                        start_l = 0;
+                        offsets_l_base = first;
+                    }
+
+                    if (num_r == 0) {
+                        start_r = 0;
+                        offsets_r_base = last;
+                    }
+                }
+
+                // One side has leftovers: move them to the boundary
+                if (num_l) {
+                    while (num_l--) {
+                        std::iter_swap(offsets_l_base + offsets_l[start_l + num_l], --last);
+                    }
+                    first = last;
+                }
+
+                if (num_r) {
+                    while (num_r--) {
+                        std::iter_swap(offsets_r_base - offsets_r[start_r + num_r], first);
+                        ++first;
+                    }
+                    last = first;
+                }
+            }
+
+            RandomIt pivot_pos = first - 1;
+            *begin = std::move(*pivot_pos);
+            *pivot_pos = std::move(pivot);
+
+            return {pivot_pos, already_partitioned};
+        }
+
+        /**
+         * @brief Partition [first, last) around *first: [<= pivot] pivot [> pivot]
+         * Used when the pivot equals the element left of the range, so every element equal to
+         * it is already in its final place (runs of equal keys cost linear time).
+         */
+        template <typename RandomIt, typename Compare>
+        RandomIt partition_left(RandomIt first, RandomIt last, Compare& comp) {
+            auto pivot = std::move(*first);
+            RandomIt begin = first;
+            RandomIt end = last;
+
+            while (comp(pivot, *--last)) {}
+
+            if (last + 1 == end) {
+                while (first < last && !comp(pivot, *++first)) {}
+            } else {
+                while (!comp(pivot, *++first)) {}
+            }
+
+            while (first < last) {
+                std::iter_swap(first, last);
+                while (comp(pivot, *--last)) {}
+                while (!comp(pivot, *++first)) {}
+            }
+
+            RandomIt pivot_pos = last;
+            *begin = std::move(*pivot_pos);
+            *pivot_pos = std::move(pivot);
+
+            return pivot_pos;
+        }
+
+        /**
+         * @brief pdqsort main loop
+         * @param bad_allowed Highly unbalanced partitions left before falling back to heap sort
+         * @param leftmost Whether [first, last) is the leftmost part (no sentinel on its left)
+         */
+        template <bool Branchless, typename RandomIt, typename Compare>
+        void pdq_loop(RandomIt first, RandomIt last, Compare& comp, int bad_allowed, bool leftmost) {
+            while (true) {
+                std::ptrdiff_t size = last - first;
+
+                if (size < PDQ_INSERTION_THRESHOLD) {
+                    if (leftmost) {
+                        detail::pdq_insertion_sort<true>(first, last, comp);
+                    } else {
+                        detail::pdq_insertion_sort<false>(first, last, comp);
+                    }
+                    return;
+                }
+
+                // Pivot to *first: median of 3, or Tukey's ninther on larger ranges
+                std::ptrdiff_t half = size / 2;
+                if (size > PDQ_NINTHER_THRESHOLD) {
+                    detail::sort3(first, first + half, last - 1, comp);
+                    detail::sort3(first + 1, first + (half - 1), last - 2, comp);
+                    detail::sort3(first + 2, first + (half + 1), last - 3, comp);
+                    detail::sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                    std::iter_swap(first, first + half);
+                } else {
+                    detail::sort3(first + half, first, last - 1, comp);
+                }
+
+                // Pivot equal to the element before the range: everything equal to it is done
+                if (!leftmost && !comp(*(first - 1), *first)) {
+                    first = detail::partition_left(first, last, comp) + 1;
+                    continue;
+                }
+
+                auto partitioned = Branchless ? detail::partition_right_branchless(first, last, comp)
+                                              : detail::partition_right(first, last, comp);
+                RandomIt pivot_pos = partitioned.first;
+
+                std::ptrdiff_t left_size = pivot_pos - first;
+                std::ptrdiff_t right_size = last - (pivot_pos + 1);
+
+                if (left_size < size / 8 || right_size < size / 8) {
+                    if (--bad_allowed == 0) {
+                        detail::heap_sort(first, last, comp);
+                        return;
+                    }
+
+                    // Break up patterns that produced the bad pivot
+                    if (left_size >= PDQ_INSERTION_THRESHOLD) {
+                        std::iter_swap(first, first + left_size / 4);
+                        std::iter_swap(pivot_pos - 1, pivot_pos - left_size / 4);
+
+                        if (left_size > PDQ_NINTHER_THRESHOLD) {
+                            std::iter_swap(first + 1, first + (left_size / 4 + 1));
+                            std::iter_swap(first + 2, first + (left_size / 4 + 2));
+                            std::iter_swap(pivot_pos - 2, pivot_pos - (left_size / 4 + 1));
+                            std::iter_swap(pivot_pos - 3, pivot_pos - (left_size / 4 + 2));
+                        }
+                    }
+
+                    if (right_size >= PDQ_INSERTION_THRESHOLD) {
+                        std::iter_swap(pivot_pos + 1, pivot_pos + (1 + right_size / 4));
+                        std::iter_swap(last - 1, last - right_size / 4);
+
+                        if (right_size > PDQ_NINTHER_THRESHOLD) {
+                            std::iter_swap(pivot_pos + 2, pivot_pos + (2 + right_size / 4));
+                            std::iter_swap(pivot_pos + 3, pivot_pos + (3 + right_size / 4));
+                            std::iter_swap(last - 2, last - (1 + right_size / 4));
+                            std::iter_swap(last - 3, last - (2 + right_size / 4));
+                        }
+                    }
+                } else if (partitioned.second
+                           && detail::pdq_partial_insertion_sort(first, pivot_pos, comp)
+                           && detail::pdq_partial_insertion_sort(pivot_pos + 1, last, comp)) {
+                    // No swaps were needed and both sides were (nearly) sorted: input was sorted
+                    return;
+                }
+
+                // Recurse into the smaller side, loop on the larger: stack depth stays O(log n)
+                if (left_size < right_size) {
+                    detail::pdq_loop<Branchless>(first, pivot_pos, comp, bad_allowed, leftmost);
+                    first = pivot_pos + 1;
+                    leftmost = false;
+                } else {
+                    detail::pdq_loop<Branchless>(pivot_pos + 1, last, comp, bad_allowed, false);
+                    last = pivot_pos;
+                }
+            }
+        }
+    }
+
+    // Merge Sort (top-down, one buffer of n/2 elements reused by every merge)
+    template <typename RandomIt, typename Compare>
+    void merge_sort(RandomIt first, RandomIt last, Compare comp) {
+        std::vector<typename std::iterator_traits<RandomIt>::value_type> buffer;
+        buffer.reserve(static_cast<size_t>(last - first) / 2 + 1);
+
+        detail::merge_sort(first, last, buffer, comp);
+    }
+
+    namespace detail {
+
+        constexpr std::ptrdiff_t TIM_MIN_GALLOP = 7;
+
+        /**
+         * @brief First position in [first, last) where pred turns false (pred true..true false..false)
+         * Probes 1, 2, 4, ... elements from first before bisecting, so the cost is logarithmic in
+         * the distance to the answer rather than in the range length.
+         */
+        template <typename RandomIt, typename Pred>
+        RandomIt gallop_forward(RandomIt first, RandomIt last, Pred pred) {
+            std::ptrdiff_t size = last - first;
+            std::ptrdiff_t bound = 1;
+
+            while (bound <= size && pred(first[bound - 1])) {
+                bound *= 2;
+            }
+
+            return std::partition_point(first + bound / 2, first + std::min(bound, size), pred);
+        }
+
+        /**
+         * @brief First position of the suffix of [first, last) on which pred holds (pred false..false true..true)
+         * Galloping from last, the mirror image of gallop_forward.
+         */
+        template <typename RandomIt, typename Pred>
+        RandomIt gallop_backward(RandomIt first, RandomIt last, Pred pred) {
+            std::ptrdiff_t size = last - first;
+            std::ptrdiff_t bound = 1;
+
+            while (bound <= size && pred(*(last - bound))) {
+                bound *= 2;
+            }
+
+            return std::partition_point(last - std::min(bound, size), last - bound / 2,
+                                        [&pred](const auto& value) { return !pred(value); });
+        }
+
+        /**
+         * @brief Length of the run at first
+         * A descending run (non-increasing, starting with a strict descent) is reversed in place,
+         * then each block of equal elements is reversed back, so the sort stays stable even on
+         * reversed input with many duplicate keys.
+         */
+        template <typename RandomIt, typename Compare>
+        std::ptrdiff_t tim_count_run(RandomIt first, RandomIt last, Compare& comp) {
+            RandomIt run_end = first + 1;
+
+            if (run_end == last) {
+                return 1;
+            }
+
+            if (comp(*run_end, *first)) {
+                bool has_equal = false;
+
+                while (++run_end != last && !comp(*(run_end - 1), *run_end)) {
+                    has_equal |= !comp(*run_end, *(run_end - 1));
+                }
+
+                std::reverse(first, run_end);
+
+                if (has_equal) {
+                    for (RandomIt block = first; block != run_end; ) {
+                        RandomIt block_end = block + 1;
+
+                        while (block_end != run_end && !comp(*(block_end - 1), *block_end)) {
+                            ++block_end;
+                        }
+
+                        std::reverse(block, block_end);
+                        block = block_end;
+                    }
+                }
+            } else {
+                while (++run_end != last && !comp(*run_end, *(run_end - 1))) {}
+            }
+
+            return run_end - first;
+        }
+
+        // Extend the sorted prefix [first, sorted) to [first, last) by stable binary insertion
+        template <typename RandomIt, typename Compare>
+        void tim_binary_insertion(RandomIt first, RandomIt sorted, RandomIt last, Compare& comp) {
+            for (; sorted != last; ++sorted) {
+                RandomIt pos = std::upper_bound(first, sorted, *sorted, comp);
+
+                if (pos != sorted) {
+                    auto key = std::move(*sorted);
+                    std::move_backward(pos, sorted, sorted + 1);
+                    *pos = std::move(key);
+                }
+            }
+        }
+
+        /**
+         * @brief Minimum run length: n shifted into [32, 64) so n / min_run is at or just
+         * below a power of two (balanced merges)
+         */
+        inline std::ptrdiff_t tim_min_run(std::ptrdiff_t n) {
+            std::ptrdiff_t low_bits = 0;
+
+            while (n >= 64) {
+                low_bits |= n & 1;
+                n >>= 1;
+            }
+
+            return n + low_bits;
+        }
+
+        /**
+         * @brief Powersort node power of the boundary between runs [a, b) and [b, c) of n elements
+         * The depth at which the boundary would sit in a perfectly balanced merge tree over
+         * [0, n): the first bit in which the two run midpoints, as fractions of n, differ.
+         */
+        inline unsigned tim_node_power(size_t n, size_t a, size_t b, size_t c) {
+            // Midpoints scaled by 2n: (a + b) / 2n and (b + c) / 2n, both in [0, 1)
+            size_t left = a + b;
+            size_t right = b + c;
+            unsigned power = 0;
+
+            while (true) {
+                ++power;
+
+                bool left_bit = left >= n;
+                bool right_bit = right >= n;
+
+                if (left_bit != right_bit) {
+                    return power;
+                }
+
+                if (left_bit) {
+                    left -= n;
+                    right -= n;
+                }
+
+                left *= 2;
+                right *= 2;
+            }
+        }
+
+        /**
+         * @brief Stable galloping merge of sorted [first, mid) and [mid, last)
+         *
+         * Elements of the left run that precede the whole right run, and elements of the right
+         * run that follow the whole left run, are found by galloping and never moved. Only the
+         * shorter remainder goes through buffer. Once one side wins TIM_MIN_GALLOP times in a
+         * row, the merge gallops to find how far that streak extends and moves it in bulk.
+         */
+        template <typename RandomIt, typename Buffer, typename Compare>
+        void tim_merge(RandomIt first, RandomIt mid, RandomIt last, Buffer& buffer, Compare& comp) {
+            // Left elements <= right's first are already in place
+            first = detail::gallop_forward(first, mid, [&](const auto& x) { return !comp(*mid, x); });
+            if (first == mid) {
+                return;
+            }
+
+            // Right elements >= left's last are already in place
+            last = detail::gallop_backward(mid, last, [&](const auto& x) { return !comp(x, *(mid - 1)); });
+            if (mid == last) {
+                return;
+            }
+
+            if (mid - first <= last - mid) {
+                // Merge low: left remainder to the buffer, fill from the front
+                buffer.assign(std::make_move_iterator(first), std::make_move_iterator(mid));
+
+                auto a = buffer.begin();
+                auto a_end = buffer.end();
+                RandomIt b = mid;
+                RandomIt out = first;
+                std::ptrdiff_t a_wins = 0;
+                std::ptrdiff_t b_wins = 0;
+
+                while (a != a_end && b != last) {
+                    if (comp(*b, *a)) {
+                        *out++ = std::move(*b++);
+                        a_wins = 0;
+
+                        if (++b_wins >= TIM_MIN_GALLOP && b != last) {
+                            RandomIt run_end = detail::gallop_forward(b, last, [&](const auto& x) { return comp(x, *a); });
+                            out = std::move(b, run_end, out);
+                            b = run_end;
+                            b_wins = 0;
+                        }
+                    } else {
+                        *out++ = std::move(*a++);
+                        b_wins = 0;
+
+                        if (++a_wins >= TIM_MIN_GALLOP && a != a_end) {
+                            auto run_end = detail::gallop_forward(a, a_end, [&](const auto& x) { return !comp(*b, x); });
+                            out = std::move(a, run_end, out);
+                            a = run_end;
+                            a_wins = 0;
+                        }
+                    }
+                }
+
+                std::move(a, a_end, out);
+            } else {
+                // Merge high: right remainder to the buffer, fill from the back
+                buffer.assign(std::make_move_iterator(mid), std::make_move_iterator(last));
+
+                RandomIt a_end = mid;
+                auto b_begin = buffer.begin();
+                auto b_end = buffer.end();
+                RandomIt out = last;
+                std::ptrdiff_t a_wins = 0;
+                std::ptrdiff_t b_wins = 0;
+
+                while (a_end != first && b_end != b_begin) {
+                    if (comp(*(b_end - 1), *(a_end - 1))) {
+                        *--out = std::move(*--a_end);
+                        b_wins = 0;
+
+                        if (++a_wins >= TIM_MIN_GALLOP && a_end != first) {
+                            RandomIt run_begin = detail::gallop_backward(first, a_end,
+                                [&](const auto& x) { return comp(*(b_end - 1), x); });
+                            out = std::move_backward(run_begin, a_end, out);
+                            a_end = run_begin;
+                            a_wins = 0;
+                        }
+                    } else {
+                        *--out = std::move(*--b_end);
+                        a_wins = 0;
+
+                        if (++b_wins >= TIM_MIN_GALLOP && b_end != b_begin) {
+                            auto run_begin = detail::gallop_backward(b_begin, b_end,
+                                [&](const auto& x) { return !comp(x, *(a_end - 1)); });
+                            out = std::move_backward(run_begin, b_end, out);
+                            b_end = run_begin;
+                            b_wins = 0;
+                        }
+                    }
+                }
+
+                std::move_backward(b_begin, b_end, out);
+            }
+        }
+    }
+
+    /**
+     * @brief Tim Sort: adaptive natural merge sort with the powersort merge policy
+     *
+     * Existing ascending and strictly descending runs are detected (descending ones are
+     * reversed); runs shorter than a min run of 32-64 are extended by binary insertion.
+     * Runs are merged in the order given by their powersort node powers, which keeps the
+     * merge tree near-optimal for the actual run lengths. Merges gallop (see tim_merge)
+     * and share one buffer that only grows to the largest shorter-side remainder.
+     * O(n) comparisons on sorted or reversed input, O(n log n) worst case. Stable.
+     */
+    template <typename RandomIt, typename Compare>
+    void tim_sort(RandomIt first, RandomIt last, Compare comp) {
+        struct Run {
+            size_t begin;
+            size_t end;
+            unsigned power;  // Node power of the boundary on the run's left
+        };
+
+        size_t n = static_cast<size_t>(last - first);
+
+        if (n < 2) {
+            return;
+        }
+
+        std::ptrdiff_t min_run = detail::tim_min_run(static_cast<std::ptrdiff_t>(n));
+        std::vector<typename std::iterator_traits<RandomIt>::value_type> buffer;
+        std::vector<Run> stack;
+
+        auto next_run = [&](size_t begin) {
+            RandomIt run_first = first + begin;
+            std::ptrdiff_t length = detail::tim_count_run(run_first, last, comp);
+
+            if (length < min_run) {
+                std::ptrdiff_t forced = std::min<std::ptrdiff_t>(min_run, last - run_first);
+                detail::tim_binary_insertion(run_first, run_first + length, run_first + forced, comp);
+                length = forced;
+            }
+
+            return begin + static_cast<size_t>(length);
+        };
+
+        // Merge the two runs on top of the stack
+        auto merge_top = [&]() {
+            Run right = stack.back();
+            stack.pop_back();
+            Run& left = stack.back();
+
+            detail::tim_merge(first + left.begin, first + right.begin, first + right.end, buffer, comp);
+            left.end = right.end;
+        };
+
+        stack.push_back({0, next_run(0), 0});
+
+        while (stack.back().end < n) {
+            size_t begin = stack.back().end;
+            size_t end = next_run(begin);
+            unsigned power = detail::tim_node_power(n, stack.back().begin, begin, end);
+
+            while (stack.size() > 1 && stack.back().power > power) {
+                merge_top();
+            }
+
+            stack.push_back({begin, end, power});
+        }
+
+        while (stack.size() > 1) {
+            merge_top();
+        }
+    }
+
+    /**
+     * @brief Quick Sort: pattern-defeating quicksort (pdqsort), O(n log n) worst case
+     *
+     * Median-of-3 / ninther pivots, insertion sort below 24 elements, linear time on sorted
+     * input and on runs of equal keys, pattern-breaking swaps after unbalanced partitions
+     * and a heap sort fallback after log2(n) of them. Small trivially copyable elements
+     * (e.g. keyed-mode pairs) use the branchless block partition. Not stable.
+     */
+    template <typename RandomIt, typename Compare>
+    void quick_sort(RandomIt first, RandomIt last, Compare comp) {
+        using Value = typename std::iterator_traits<RandomIt>::value_type;
+        constexpr bool branchless = std::is_trivially_copyable<Value>::value && sizeof(Value) <= 16;
+
+        std::ptrdiff_t n = last - first;
+
+        if (n < 2) {
+            return;
+        }
+
+        int log2_n = 0;
+        while (n >>= 1) {
+            ++log2_n;
+        }
+
+        detail::pdq_loop<branchless>(first, last, comp, log2_n, true);
+    }
+
+    // Heap Sort
+    template <typename RandomIt, typename Compare>
+    void heap_sort(RandomIt first, RandomIt last, Compare comp) {
+        detail::heap_sort(first, last, comp);
+    }
+
+    // Standard library sort
+    template <typename RandomIt, typename Compare>
+    void std_sort(RandomIt first, RandomIt last, Compare comp) {
+        std::sort(first, last, comp);
+    }
+
+    // Keyed sorting: sort compact (key, index) pairs, then move each record once
+
+    /**
+     * @brief Sort key paired with the position of its record
+     */
+    template <typename Key>
+    struct KeyIndex {
+        Key key;
+        uint32_t index;
+    };
+
+    /**
+     * @brief Unsigned key whose integer order is the numeric order of f (for non-NaN f)
+     * Positive floats get the sign bit set; negative floats have all bits flipped. NaNs land
+     * above +inf (or below -inf if the sign bit is set) rather than out of range.
+     */
+    inline uint32_t ordered_float_bits(float f) {
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+
+        return bits ^ ((bits >> 31) ? 0xFFFFFFFFu : 0x80000000u);
+    }
+
+    /**
+     * @brief Order-preserving unsigned image of a double (for non-NaN d)
+     */
+    inline uint64_t ordered_double_bits(double d) {
+        uint64_t bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+
+        return bits ^ ((bits >> 63) ? ~uint64_t(0) : uint64_t(1) << 63);
+    }
+
+    /**
+     * @brief Order-preserving unsigned image of a signed integer (flips the sign bit)
+     * Packed dates such as Student::get_packed_birth_date() (YYYYMMDD) go through here too.
+     */
+    inline uint32_t ordered_int_bits(int32_t i) {
+        return static_cast<uint32_t>(i) ^ 0x80000000u;
+    }
+
+    inline uint64_t ordered_int_bits(int64_t i) {
+        return static_cast<uint64_t>(i) ^ (uint64_t(1) << 63);
+    }
+
+    /**
+     * @brief Rearrange [first, first + order.size()) so that first[i] becomes the old first[order[i]]
+     * Follows each cycle of the permutation, so every element is moved exactly once (plus
+     * one temporary per cycle). order is consumed.
+     */
+    template <typename RandomIt>
+    void apply_permutation(RandomIt data, std::vector<uint32_t>& order) {
+        for (uint32_t start = 0; start < order.size(); ++start) {
+            if (order[start] == start) {
+                continue;
+            }
+
+            auto carried = std::move(data[start]);
+            uint32_t hole = start;
+
+            while (order[hole] != start) {
+                uint32_t next = order[hole];
+                data[hole] = std::move(data[next]);
+                order[hole] = hole;
+                hole = next;
+            }
+
+            data[hole] = std::move(carried);
+            order[hole] = hole;
+        }
+    }
+
+    /**
+     * @brief Sort data by key_of(element) without moving elements during the sort
+     *
+     * Builds (key_of(data[i]), i) pairs, sorts them with sort_pairs, then applies the resulting
+     * permutation once. Ties on the key are broken by index, so the result is stable whichever
+     * algorithm sorts the pairs.
+     *
+     * @param key_of Key extractor; keys should be small and cheap to copy
+     * @param key_less Strict weak ordering on keys
+     * @param sort_pairs Callable sort_pairs(first, last, pair_less), e.g. a wrapper around
+     *        any algorithm in this namespace
+     */
+    template <typename T, typename KeyOf, typename KeyLess, typename SortPairs>
+    void sort_by_key(std::vector<T>& data, KeyOf key_of, KeyLess key_less, SortPairs&& sort_pairs) {
+        using Key = decltype(key_of(data.front()));
+
+        std::vector<KeyIndex<Key>> pairs;
+        pairs.reserve(data.size());
+
+        for (size_t i = 0; i < data.size(); ++i) {
+            pairs.push_back({key_of(data[i]), static_cast<uint32_t>(i)});
+        }
+
+        sort_pairs(pairs.begin(), pairs.end(), [&key_less](const KeyIndex<Key>& a, const KeyIndex<Key>& b) {
+            if (key_less(a.key, b.key)) {
+                return true;
+            }
+
+            return !key_less(b.key, a.key) && a.index < b.index;
+        });
+
+        std::vector<uint32_t> order;
+        order.reserve(pairs.size());
+
+        for (const auto& pair : pairs) {
+            order.push_back(pair.index);
+        }
+
+        generic::apply_permutation(data.begin(), order);
+    }
+
+    /**
+     * @brief Digit width of radix_sort_pairs: 11 bits, 3 passes over 32-bit keys with
+     * 2048-entry histograms (8 KB each, still L1-resident); 4-5% faster than 8 bits at 10k-200k
+     */
+    constexpr unsigned RADIX_DIGIT_BITS = 11;
+
+    /**
+     * @brief Stable LSD radix sort of (unsigned key, index) pairs
+     *
+     * All digit histograms are built in one read of the keys; a pass whose digit is the same
+     * for every key (one occupied bucket) is skipped. Pairs ping-pong between pairs and
+     * buffer, and the result always ends up in pairs.
+     */
+    template <unsigned DigitBits = RADIX_DIGIT_BITS, typename Key>
+    void radix_sort_pairs(std::vector<KeyIndex<Key>>& pairs, std::vector<KeyIndex<Key>>& buffer) {
+        static_assert(std::is_unsigned<Key>::value, "radix keys must be unsigned; map them with ordered_*_bits");
+
+        constexpr unsigned PASSES = (sizeof(Key) * 8 + DigitBits - 1) / DigitBits;
+        constexpr size_t BUCKETS = size_t(1) << DigitBits;
+        constexpr Key MASK = static_cast<Key>(BUCKETS - 1);
+
+        size_t n = pairs.size();
+
+        if (n < 2) {
+            return;
+        }
+
+        std::vector<uint32_t> counts(PASSES * BUCKETS, 0);
+
+        for (const auto& pair : pairs) {
+            for (unsigned pass = 0; pass < PASSES; ++pass) {
+                ++counts[pass * BUCKETS + ((pair.key >> (pass * DigitBits)) & MASK)];
+            }
+        }
+
+        buffer.resize(n);
+
+        for (unsigned pass = 0; pass < PASSES; ++pass) {
+            uint32_t* count = &counts[pass * BUCKETS];
+            unsigned shift = pass * DigitBits;
+
+            if (count[(pairs.front().key >> shift) & MASK] == n) {
+                continue;
+            }
+
+            // Exclusive prefix sum: first output slot of each digit
+            uint32_t offset = 0;
+            for (size_t digit = 0; digit < BUCKETS; ++digit) {
+                uint32_t c = count[digit];
+                count[digit] = offset;
+                offset += c;
+            }
+
+            for (const auto& pair : pairs) {
+                buffer[count[(pair.key >> shift) & MASK]++] = pair;
+            }
+
+            pairs.swap(buffer);
+        }
+    }
+
+    /**
+     * @brief Stable radix sort of [first, last) by an unsigned key
+     *
+     * Sorts (key, index) pairs with radix_sort_pairs, then moves each element once.
+     * Descending order sorts the complemented keys, so equal keys keep their input order
+     * either way.
+     *
+     * @param key_of Maps an element to uint32_t or uint64_t whose integer order is the
+     *        wanted order (see ordered_float_bits, ordered_double_bits, ordered_int_bits)
+     * @param ascending Sort direction
+     */
+    template <typename RandomIt, typename KeyOf>
+    void radix_sort_by_key(RandomIt first, RandomIt last, KeyOf key_of, bool ascending) {
+        using Key = decltype(key_of(*first));
+
+        size_t n = static_cast<size_t>(last - first);
+
+        if (n < 2) {
+            return;
+        }
+
+        std::vector<KeyIndex<Key>> pairs;
+        pairs.reserve(n);
+
+        for (size_t i = 0; i < n; ++i) {
+            Key key = key_of(first[i]);
+            pairs.push_back({ascending ? key : static_cast<Key>(~key), static_cast<uint32_t>(i)});
+        }
+
+        std::vector<KeyIndex<Key>> buffer;
+        generic::radix_sort_pairs(pairs, buffer);
+
+        std::vector<uint32_t> order;
+        order.reserve(n);
+
+        for (const auto& pair : pairs) {
+            order.push_back(pair.index);
+        }
+
+        generic::apply_permutation(first, order);
+    }
+
+    /**
+     * @brief Radix sort on m_rating for Student-like elements, exact to the last float bit
+     * For the sort_algorithms comparator interface: the comparator is only consulted once,
+     * to tell ascending from descending. Callers that know the direction should use
+     * radix_sort_by_key directly.
+     */
+    template <typename RandomIt, typename Compare>
+    void radix_sort_by_rating(RandomIt first, RandomIt last, Compare comp) {
+        using Value = typename std::iterator_traits<RandomIt>::value_type;
+
+        if (last - first < 2) {
+            return;
+        }
+
+        Value s1, s2;
+        s1.m_rating = 1;
+        s2.m_rating = 2;
+
+        generic::radix_sort_by_key(first, last, [](const Value& v) {
+            return ordered_float_bits(v.m_rating);
+        }, comp(s1, s2));
+    }
+}
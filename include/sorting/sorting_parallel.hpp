@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+/**
+ * @file sorting_parallel.hpp
+ * Parallel merge sort on a parallel::ThreadPool.
+ *
+ * Leaf blocks are sorted by independent tasks, then each merge level splits every pair of
+ * runs into equal slices of the output along the merge path, so all participants stay busy
+ * up to the final merge. Runs ping-pong between the data and one scratch buffer of n
+ * elements allocated up front; nothing else is allocated while sorting. The comparator is
+ * shared by all tasks and must be safe to call concurrently.
+ */
+
+namespace sort_algorithms::generic {
+
+    /**
+     * @brief Inputs shorter than this are sorted on the calling thread only
+     */
+    constexpr size_t PARALLEL_MERGE_MIN = 16384;
+
+    namespace detail {
+
+        constexpr size_t PARALLEL_LEAF_MIN = PARALLEL_MERGE_MIN / 2;
+        constexpr size_t MERGE_RUN = 32;
+
+        /**
+         * @brief Number of elements of a among the first diagonal outputs of a stable merge of a and b
+         */
+        template <typename It, typename Compare>
+        size_t merge_path(It a, size_t a_size, It b, size_t b_size, size_t diagonal, Compare& comp) {
+            size_t lo = diagonal > b_size ? diagonal - b_size : 0;
+            size_t hi = std::min(diagonal, a_size);
+
+            while (lo < hi) {
+                size_t mid = lo + (hi - lo) / 2;
+
+                if (comp(b[diagonal - mid - 1], a[mid])) {
+                    hi = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+
+            return lo;
+        }
+
+        // Stable move-merge of [a, a_end) and [b, b_end) into out (equal elements: a first)
+        template <typename InIt, typename OutIt, typename Compare>
+        OutIt move_merge(InIt a, InIt a_end, InIt b, InIt b_end, OutIt out, Compare& comp) {
+            while (a != a_end && b != b_end) {
+                if (comp(*b, *a)) {
+                    *out++ = std::move(*b++);
+                } else {
+                    *out++ = std::move(*a++);
+                }
+            }
+
+            out = std::move(a, a_end, out);
+
+            return std::move(b, b_end, out);
+        }
+
+        // Merge adjacent runs of width from src into dst over [0, n)
+        template <typename SrcIt, typename DstIt, typename Compare>
+        void merge_pass(SrcIt src, DstIt dst, size_t n, size_t width, Compare& comp) {
+            for (size_t lo = 0; lo < n; lo += 2 * width) {
+                size_t mid = std::min(lo + width, n);
+                size_t hi = std::min(lo + 2 * width, n);
+
+                detail::move_merge(src + lo, src + mid, src + mid, src + hi, dst + lo, comp);
+            }
+        }
+
+        /**
+         * @brief Stable sort of [first, first + n) using scratch[0, n) as the merge buffer
+         * Insertion-sorts runs of MERGE_RUN, then merges bottom-up between data and scratch.
+         */
+        template <typename RandomIt, typename ScratchIt, typename Compare>
+        void block_merge_sort(RandomIt first, size_t n, ScratchIt scratch, Compare& comp) {
+            for (size_t lo = 0; lo < n; lo += MERGE_RUN) {
+                RandomIt run_first = first + lo;
+                RandomIt run_last = first + std::min(lo + MERGE_RUN, n);
+
+                for (RandomIt it = run_first + 1; it < run_last; ++it) {
+                    auto key = std::move(*it);
+                    RandomIt hole = it;
+
+                    while (hole != run_first && comp(key, *(hole - 1))) {
+                        *hole = std::move(*(hole - 1));
+                        --hole;
+                    }
+
+                    *hole = std::move(key);
+                }
+            }
+
+            bool in_data = true;
+
+            for (size_t width = MERGE_RUN; width < n; width *= 2) {
+                if (in_data) {
+                    detail::merge_pass(first, scratch, n, width, comp);
+                } else {
+                    detail::merge_pass(scratch, first, n, width, comp);
+                }
+
+                in_data = !in_data;
+            }
+
+            if (!in_data) {
+                std::move(scratch, scratch + n, first);
+            }
+        }
+    }
+
+    /**
+     * @brief Stable parallel merge sort
+     * @param pool Pool whose participants (including the caller) run the leaf sorts and merges
+     */
+    template <typename RandomIt, typename Compare>
+    void parallel_merge_sort(RandomIt first, RandomIt last, Compare comp, parallel::ThreadPool& pool) {
+        using Value = typename std::iterator_traits<RandomIt>::value_type;
+
+        size_t n = static_cast<size_t>(last - first);
+
+        if (n < 2) {
+            return;
+        }
+
+        std::vector<Value> scratch(n);
+        auto buffer = scratch.begin();
+        size_t threads = pool.size();
+
+        if (threads == 1 || n < PARALLEL_MERGE_MIN) {
+            detail::block_merge_sort(first, n, buffer, comp);
+            return;
+        }
+
+        // Power-of-two leaf count, about four leaves per participant for load balance
+        size_t leaves = 1;
+        while (leaves < 4 * threads && n / (2 * leaves) >= detail::PARALLEL_LEAF_MIN) {
+            leaves *= 2;
+        }
+
+        // Run r of `runs` equal runs starts at n * r / runs (leaf boundaries nest exactly)
+        auto bound = [n](size_t r, size_t runs) {
+            return n * r / runs;
+        };
+
+        {
+            parallel::TaskGroup group(pool);
+
+            for (size_t leaf = 0; leaf < leaves; ++leaf) {
+                size_t lo = bound(leaf, leaves);
+                size_t hi = bound(leaf + 1, leaves);
+
+                group.run([first, buffer, lo, hi, &comp] {
+                    detail::block_merge_sort(first + lo, hi - lo, buffer + lo, comp);
+                });
+            }
+
+            group.wait();
+        }
+
+        bool in_data = true;
+
+        for (size_t runs = leaves; runs > 1; runs /= 2) {
+            size_t pairs = runs / 2;
+            size_t slices = std::max<size_t>(1, 4 * threads / pairs);
+
+            parallel::TaskGroup group(pool);
+
+            for (size_t pair = 0; pair < pairs; ++pair) {
+                size_t lo = bound(2 * pair, runs);
+                size_t mid = bound(2 * pair + 1, runs);
+                size_t hi = bound(2 * pair + 2, runs);
+
+                for (size_t slice = 0; slice < slices; ++slice) {
+                    size_t d0 = (hi - lo) * slice / slices;
+                    size_t d1 = (hi - lo) * (slice + 1) / slices;
+
+                    auto merge_slice = [lo, mid, hi, d0, d1, &comp](auto src, auto dst) {
+                        size_t a_size = mid - lo;
+                        size_t b_size = hi - mid;
+
+                        size_t i0 = detail::merge_path(src + lo, a_size, src + mid, b_size, d0, comp);
+                        size_t i1 = detail::merge_path(src + lo, a_size, src + mid, b_size, d1, comp);
+
+                        detail::move_merge(src + lo + i0, src + lo + i1,
+                                           src + mid + (d0 - i0), src + mid + (d1 - i1),
+                                           dst + lo + d0, comp);
+                    };
+
+                    group.run([first, buffer, in_data, merge_slice] {
+                        if (in_data) {
+                            merge_slice(first, buffer);
+                        } else {
+                            merge_slice(buffer, first);
+                        }
+                    });
+                }
+            }
+
+            group.wait();
+            in_data = !in_data;
+        }
+
+        if (!in_data) {
+            parallel::TaskGroup group(pool);
+
+            for (size_t leaf = 0; leaf < leaves; ++leaf) {
+                size_t lo = bound(leaf, leaves);
+                size_t hi = bound(leaf + 1, leaves);
+
+                group.run([first, buffer, lo, hi] {
+                    std::move(buffer + lo, buffer + hi, first + lo);
+                });
+            }
+
+            group.wait();
+        }
+    }
+}
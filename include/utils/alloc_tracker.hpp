@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Process-wide heap accounting
+ *
+ * alloc_tracker.cpp replaces the global operator new / delete and, while a LoadScope is
+ * active, counts every block through malloc_usable_size, so the numbers include allocator
+ * size-class rounding and cover everything an engine owns (container nodes, buckets, Student
+ * strings beyond SSO). Outside a scope the hook costs one relaxed load per call, so timed
+ * benchmark loops run at plain malloc speed.
+ * Counters are global: measure a load on one thread while no other thread allocates.
+ */
+namespace alloc_tracker {
+
+    /**
+     * @brief Snapshot of the global heap counters
+     * The counters only move while a LoadScope is active, so only differences between two
+     * snapshots taken inside the same scope are meaningful.
+     */
+    struct Counters {
+        size_t live_bytes;    // Usable bytes of all live blocks
+        size_t live_blocks;   // Live blocks
+        size_t allocations;   // Counted operator new calls
+    };
+
+    /**
+     * @brief Resident set size read from /proc/self/status
+     */
+    struct ProcessMemory {
+        size_t rss_bytes;       // VmRSS
+        size_t peak_rss_bytes;  // VmHWM
+    };
+
+    /**
+     * @brief Heap and RSS cost of building one engine
+     */
+    struct LoadFootprint {
+        size_t heap_bytes;        // Live usable bytes plus one malloc chunk header per live block
+        size_t heap_blocks;       // Live blocks added by the load
+        size_t allocations;       // operator new calls during the load, temporaries included
+        size_t rss_before_bytes;
+        size_t rss_after_bytes;
+        size_t peak_rss_bytes;    // VmHWM after the load (reset at scope start where the kernel allows)
+    };
+
+    /**
+     * @brief Current global heap counters
+     */
+    Counters counters();
+
+    /**
+     * @brief Current and peak RSS of this process
+     * @return Zeros if /proc/self/status is unavailable
+     */
+    ProcessMemory process_memory();
+
+    /**
+     * @brief Reset VmHWM to the current RSS via /proc/self/clear_refs
+     * @return false if the kernel refused the write
+     */
+    bool reset_peak_rss();
+
+    /**
+     * @brief Measures the heap and RSS delta between construction and finish()
+     * Allocations are counted from construction until finish() (or destruction, if finish()
+     * is never called). Blocks freed inside the scope do not count towards heap_bytes.
+     */
+    class LoadScope {
+    private:
+        Counters start_counters;
+        ProcessMemory start_memory;
+        bool tracking;
+
+        void stop_tracking();
+
+    public:
+        LoadScope();
+        ~LoadScope();
+
+        LoadScope(const LoadScope&) = delete;
+        LoadScope& operator=(const LoadScope&) = delete;
+
+        /**
+         * @brief Stop counting and return the footprint since construction
+         */
+        LoadFootprint finish();
+    };
+}
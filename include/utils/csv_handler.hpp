@@ -7,6 +7,12 @@
 
 namespace csv {
 
+    /**
+     * @brief Header line written at the top of every student CSV
+     */
+    inline constexpr const char* HEADER =
+        "m_name,m_surname,m_email,m_birth_year,m_birth_month,m_birth_day,m_group,m_rating,m_phone_number\n";
+
     /**
      * @brief Split line by coma
      * @param Line Line with student's info
@@ -28,6 +34,14 @@ namespace csv {
      * @return true if successful, false otherwise
      */
     bool write_csv(const std::string& filename, const std::vector<Student>& students);
+
+    /**
+     * @brief Write students referenced by pointer, in the given order, without copying them
+     * @param filename Path to the output CSV file
+     * @param students Pointers to the Student objects to write
+     * @return true if successful, false otherwise
+     */
+    bool write_csv(const std::string& filename, const std::vector<const Student*>& students);
     
     /**
      * @brief Parse a single line from CSV
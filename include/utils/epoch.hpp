@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Process-wide epoch-based reclamation (EBR) domain
+ *
+ * Readers announce the epoch they entered in a per-thread, cache-line padded
+ * slot and never touch any other shared state. Writers retire old objects
+ * tagged with the epoch returned by advance() and free them once
+ * is_quiescent() reports that no reader can still hold a reference.
+ */
+namespace epoch {
+
+    /**
+     * @brief RAII guard marking the calling thread as an active reader
+     * Guards must not be nested on the same thread.
+     */
+    class ReadGuard {
+    public:
+        ReadGuard();
+        ~ReadGuard();
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+    };
+
+    /**
+     * @brief Advance the global epoch
+     * Call after publishing a new version; tag the retired version with the result.
+     * @return The new global epoch
+     */
+    uint64_t advance();
+
+    /**
+     * @brief Oldest epoch announced by any active reader
+     * @return Minimum active epoch, or UINT64_MAX if no reader is active
+     */
+    uint64_t min_active();
+
+    /**
+     * @brief Check whether an object retired at the given epoch can be freed
+     * @param retired_epoch Value returned by advance() when the object was retired
+     * @return true if no active reader entered before retired_epoch
+     */
+    bool is_quiescent(uint64_t retired_epoch);
+}
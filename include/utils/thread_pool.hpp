@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Work-stealing thread pool for fork-join parallelism
+ *
+ * Every participant owns a task deque: it pushes and pops at the back (LIFO, cache-warm
+ * subtasks first) and idle participants steal from the front of the others (FIFO, the
+ * largest pending pieces). Threads outside the pool share deque 0.
+ */
+namespace parallel {
+
+    class ThreadPool {
+    public:
+        /**
+         * @brief Start the pool
+         * @param thread_count Participants including the thread that waits on a TaskGroup,
+         *        so thread_count - 1 workers are spawned (0 means hardware_concurrency)
+         */
+        explicit ThreadPool(size_t thread_count = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Number of participants (workers plus the waiting caller)
+         */
+        size_t size() const;
+
+        /**
+         * @brief Queue a task on the calling participant's deque
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief Run one queued task on the calling thread, own deque first, then steal
+         * @return false if every deque was empty
+         */
+        bool try_run_one();
+
+        /**
+         * @brief Sleep until a task is queued or done() holds (checked under the sleep lock)
+         */
+        void wait_for_work(const std::function<bool()>& done);
+
+        /**
+         * @brief Wake every sleeping participant so it re-checks its wait condition
+         */
+        void notify_waiters();
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> workers;
+
+        std::atomic<size_t> pending{0};
+        std::atomic<bool> stopping{false};
+        std::mutex sleep_mutex;
+        std::condition_variable wake;
+
+        size_t local_index() const;
+        bool pop(size_t index, std::function<void()>& task);
+        bool steal(size_t thief, std::function<void()>& task);
+        void worker_loop(size_t index);
+    };
+
+    /**
+     * @brief Set of tasks that one caller forks and then joins
+     *
+     * wait() runs queued tasks (its own or stolen) instead of blocking, so tasks may
+     * themselves fork and wait on nested groups without starving the pool. With nothing
+     * left to run it sleeps until new work is queued or the group's last task finishes.
+     * Tasks must not throw.
+     */
+    class TaskGroup {
+    public:
+        explicit TaskGroup(ThreadPool& pool);
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        void run(std::function<void()> task);
+        void wait();
+
+    private:
+        ThreadPool& pool;
+        std::atomic<size_t> outstanding{0};
+    };
+}
@@ -4,75 +4,483 @@
 #include <random>
 #include <algorithm>
 #include <set>
+#include <thread>
+#include <atomic>
 
 #include "benchmark.hpp"
+#include "static_driver.hpp"
 #include "sorting.hpp"
 #include "student.hpp"
 #include "csv_handler.hpp"
 
 namespace benchmark {
     
-    // Measure sorting algorithm performance
-    template <typename T>
-    SortBenchmarkResult measure_sort(
-        const std::string& algorithm_name,
-        const std::vector<T>& data,
-        std::function<void(std::vector<T>&, std::function<bool(const T&, const T&)>)> sort_func,
-        std::function<bool(const T&, const T&)> comparator) {
-        
-        SortBenchmarkResult result;
-        result.algorithm_name = algorithm_name;
-        result.data_size = data.size();
+    // Operations benchmark with ratio support
+    OperationBenchmarkResult run_operations_benchmark(
+        IStudentDatabase* db,
+        double duration_seconds,
+        int op1_ratio,
+        int op2_ratio,
+        int op3_ratio,
+        bool use_views) {
+        
+        OperationBenchmarkResult result;
+        result.container_name = db->get_container_name() + (use_views ? " [views]" : "");
+        
+        DatabaseCached* cached_db = dynamic_cast<DatabaseCached*>(db);
+        if (cached_db) {
+            cached_db->reset_cache_stats();
+        }
+        
+        run_operations_loop(*db, result, duration_seconds, op1_ratio, op2_ratio, op3_ratio, use_views);
         
-        std::vector<T> data_copy = data;
+        if (cached_db) {
+            DatabaseCached::CacheStats stats = cached_db->cache_stats();
+            result.cache_hits = stats.hits;
+            result.cache_misses = stats.misses;
+        }
+        
+        return result;
+    }
+    
+    // Run benchmarks on all database implementations
+    std::vector<OperationBenchmarkResult> run_all_operations_benchmarks(
+        const std::vector<size_t>& data_sizes,
+        double duration_seconds,
+        bool use_views,
+        bool static_dispatch) {
+        
+        std::vector<OperationBenchmarkResult> all_results;
+        
+        std::vector<Student> full_data = csv::read_csv("data/students.csv");
+        
+        for (size_t data_size : data_sizes) {
+            std::cout << "\n=== Testing with data size: " << data_size << " ===\n" << std::endl;
+            
+            // Prepare subset of data
+            std::vector<Student> subset(full_data.begin(), 
+                                       full_data.begin() + std::min(data_size, full_data.size()));
+            
+            // Variant V3 ratios: 5:10:100
+            const int OP1_RATIO = 5;   // Change group by phone
+            const int OP2_RATIO = 10;  // Get students by group sorted
+            const int OP3_RATIO = 100; // Get groups by surname
+            
+            // Virtual calls through IStudentDatabase*, or statically bound calls on the concrete engine
+            auto run = [&](auto& db, alloc_tracker::LoadScope& load_scope) {
+                alloc_tracker::LoadFootprint load = load_scope.finish();
+                OperationBenchmarkResult result = static_dispatch
+                    ? run_operations_benchmark_static(db, duration_seconds, OP1_RATIO, OP2_RATIO, OP3_RATIO, use_views)
+                    : run_operations_benchmark(&db, duration_seconds, OP1_RATIO, OP2_RATIO, OP3_RATIO, use_views);
+                result.load = load;
+                return result;
+            };
+            
+            // Test DatabaseVector with and without the phone index
+            std::cout << "Testing DatabaseVector (std::vector, scans)..." << std::endl;
+            alloc_tracker::LoadScope load_vector_scan;
+            DatabaseVector db_vector_scan(subset, false);
+            auto result_vector_scan = run(db_vector_scan, load_vector_scan);
+            all_results.push_back(result_vector_scan);
+            
+            std::cout << "Testing DatabaseVector (std::vector + phone index)..." << std::endl;
+            alloc_tracker::LoadScope load_vector;
+            DatabaseVector db_vector(subset);
+            auto result_vector = run(db_vector, load_vector);
+            all_results.push_back(result_vector);
+            
+            // Test DatabaseHashMap
+            std::cout << "Testing DatabaseHashMap (std::unordered_map)..." << std::endl;
+            alloc_tracker::LoadScope load_hashmap;
+            DatabaseHashMap db_hashmap(subset);
+            auto result_hashmap = run(db_hashmap, load_hashmap);
+            all_results.push_back(result_hashmap);
+            
+            // Test DatabaseTreeMap
+            std::cout << "Testing DatabaseTreeMap (std::map)..." << std::endl;
+            alloc_tracker::LoadScope load_treemap;
+            DatabaseTreeMap db_treemap(subset);
+            auto result_treemap = run(db_treemap, load_treemap);
+            all_results.push_back(result_treemap);
+            
+            // Test DatabaseHybrid
+            std::cout << "Testing DatabaseHybrid (unordered_map + multimap indices)..." << std::endl;
+            alloc_tracker::LoadScope load_hybrid;
+            DatabaseHybrid db_hybrid(subset);
+            auto result_hybrid = run(db_hybrid, load_hybrid);
+            all_results.push_back(result_hybrid);
+            
+            // Test DatabaseBitmap
+            std::cout << "Testing DatabaseBitmap (roaring group / surname bitmaps)..." << std::endl;
+            alloc_tracker::LoadScope load_bitmap;
+            DatabaseBitmap db_bitmap(subset);
+            auto result_bitmap = run(db_bitmap, load_bitmap);
+            all_results.push_back(result_bitmap);
+            
+            // Test DatabaseIndexed
+            std::cout << "Testing DatabaseIndexed (unordered_map + declarative IndexSet)..." << std::endl;
+            alloc_tracker::LoadScope load_indexed;
+            DatabaseIndexed db_indexed(subset);
+            auto result_indexed = run(db_indexed, load_indexed);
+            all_results.push_back(result_indexed);
+            
+            // Test DatabaseConcurrent
+            std::cout << "Testing DatabaseConcurrent (RCU sharded hash indices)..." << std::endl;
+            alloc_tracker::LoadScope load_concurrent;
+            DatabaseConcurrent db_concurrent(subset);
+            auto result_concurrent = run(db_concurrent, load_concurrent);
+            all_results.push_back(result_concurrent);
+            
+            // Test DatabaseAdaptive
+            std::cout << "Testing DatabaseAdaptive (flat / hashed / indexed)..." << std::endl;
+            alloc_tracker::LoadScope load_adaptive;
+            DatabaseAdaptive db_adaptive(subset);
+            auto result_adaptive = run(db_adaptive, load_adaptive);
+            all_results.push_back(result_adaptive);
+            print_migration_log(db_adaptive);
+            
+            // Test DatabaseCached in front of a scanning and an indexed engine
+            std::cout << "Testing DatabaseCached (std::vector + group roster cache)..." << std::endl;
+            alloc_tracker::LoadScope load_cached_vector;
+            DatabaseCached db_cached_vector(std::make_unique<DatabaseVector>(subset));
+            auto result_cached_vector = run(db_cached_vector, load_cached_vector);
+            all_results.push_back(result_cached_vector);
+            
+            // Test DatabaseMapped (the file mapping is page cache, not heap)
+            std::cout << "Testing DatabaseMapped (mmap file, offset-linked records)..." << std::endl;
+            alloc_tracker::LoadScope load_mapped;
+            DatabaseMapped db_mapped("results/operations_benchmark.map", subset);
+            auto result_mapped = run(db_mapped, load_mapped);
+            all_results.push_back(result_mapped);
+            
+            std::cout << "Testing DatabaseCached (Hybrid + group roster cache)..." << std::endl;
+            alloc_tracker::LoadScope load_cached_hybrid;
+            DatabaseCached db_cached_hybrid(std::make_unique<DatabaseHybrid>(subset));
+            auto result_cached_hybrid = run(db_cached_hybrid, load_cached_hybrid);
+            all_results.push_back(result_cached_hybrid);
+        }
+        
+        return all_results;
+    }
+    
+    std::vector<Student> scale_dataset(const std::vector<Student>& base, size_t rows) {
+        std::vector<Student> result;
+        
+        if (base.empty()) {
+            return result;
+        }
+        
+        result.reserve(rows);
+        
+        for (size_t i = 0; i < rows; ++i) {
+            result.push_back(base[i % base.size()]);
+            
+            size_t copy = i / base.size();
+            if (copy > 0) {
+                result.back().m_phone_number += "-" + std::to_string(copy);
+            }
+        }
+        
+        return result;
+    }
+    
+    namespace {
+        template <typename Engine>
+        LoadBenchmarkResult measure_load(const std::vector<Student>& rows, bool bulk) {
+            LoadBenchmarkResult result;
+            result.method = bulk ? "bulk build" : "per-row add";
+            result.data_size = rows.size();
+            
+            alloc_tracker::LoadScope load_scope;
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            std::unique_ptr<Engine> db;
+            if (bulk) {
+                db = std::make_unique<Engine>(rows);
+            } else {
+                db = std::make_unique<Engine>();
+                for (const auto& student : rows) {
+                    db->add(student);
+                }
+            }
+            
+            std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+            alloc_tracker::LoadFootprint load = load_scope.finish();
+            
+            result.container_name = db->get_container_name();
+            result.duration_ms = elapsed.count() * 1000.0;
+            result.rows_per_second = elapsed.count() > 0 ? rows.size() / elapsed.count() : 0.0;
+            result.heap_mb = load.heap_bytes / (1024.0 * 1024.0);
+            
+            return result;
+        }
+    }
+    
+    // Per-row add() vs bulk-build constructors
+    std::vector<LoadBenchmarkResult> run_all_load_benchmarks(const std::vector<size_t>& data_sizes) {
+        std::vector<LoadBenchmarkResult> all_results;
+        
+        std::vector<Student> full_data = csv::read_csv("data/students.csv");
+        
+        for (size_t data_size : data_sizes) {
+            std::cout << "\n=== Testing with data size: " << data_size << " ===\n" << std::endl;
+            
+            std::vector<Student> rows = scale_dataset(full_data, data_size);
+            
+            std::cout << "Testing DatabaseTreeMap (std::map)..." << std::endl;
+            all_results.push_back(measure_load<DatabaseTreeMap>(rows, false));
+            all_results.push_back(measure_load<DatabaseTreeMap>(rows, true));
+            
+            std::cout << "Testing DatabaseHybrid (unordered_map + multimap indices)..." << std::endl;
+            all_results.push_back(measure_load<DatabaseHybrid>(rows, false));
+            all_results.push_back(measure_load<DatabaseHybrid>(rows, true));
+        }
+        
+        return all_results;
+    }
+    
+    MappedOpenResult run_mapped_open_benchmark(const std::string& file_path, size_t rows) {
+        MappedOpenResult result;
+        result.file_path = file_path;
+        result.data_size = 0;
+        result.file_bytes = 0;
+        result.build_ms = 0;
+        result.open_ms = 0;
+        result.first_query_us = 0;
+        result.csv_load_ms = 0;
+        
+        std::vector<Student> data = scale_dataset(csv::read_csv("data/students.csv"), rows);
+        if (data.empty()) {
+            return result;
+        }
+        
+        std::string csv_path = file_path + ".csv";
+        csv::write_csv(csv_path, data);
+        std::string group = data.front().m_group;
+        result.data_size = data.size();
         
-        // Measure time
         auto start = std::chrono::high_resolution_clock::now();
-        sort_func(data_copy, comparator);
-        auto end = std::chrono::high_resolution_clock::now();
+        {
+            DatabaseMapped db(file_path, data);
+        }
+        std::chrono::duration<double> build_elapsed = std::chrono::high_resolution_clock::now() - start;
+        result.build_ms = build_elapsed.count() * 1000.0;
+        result.file_bytes = static_cast<size_t>(std::ifstream(file_path, std::ios::binary | std::ios::ate).tellg());
+        
+        data.clear();
+        data.shrink_to_fit();
         
-        // Calculate elapsed time in milliseconds
-        std::chrono::duration<double, std::milli> elapsed = end - start;
-        result.execution_time_ms = elapsed.count();
+        start = std::chrono::high_resolution_clock::now();
+        DatabaseMapped reopened(file_path);
+        auto opened = std::chrono::high_resolution_clock::now();
+        auto students = reopened.get_students_by_group_sorted(group);
+        auto queried = std::chrono::high_resolution_clock::now();
+        
+        result.open_ms = std::chrono::duration<double>(opened - start).count() * 1000.0;
+        result.first_query_us = std::chrono::duration<double>(queried - opened).count() * 1e6;
+        
+        start = std::chrono::high_resolution_clock::now();
+        {
+            DatabaseHybrid parsed(csv::read_csv(csv_path));
+        }
+        std::chrono::duration<double> csv_elapsed = std::chrono::high_resolution_clock::now() - start;
+        result.csv_load_ms = csv_elapsed.count() * 1000.0;
         
         return result;
     }
     
-    // Operations benchmark with ratio support
-    OperationBenchmarkResult run_operations_benchmark(
+    OperationScript make_operation_script(
+        const IStudentDatabase& db,
+        size_t length,
+        unsigned seed,
+        int op1_ratio,
+        int op2_ratio,
+        int op3_ratio) {
+        
+        OperationScript script;
+        std::set<std::string> unique_groups, unique_surnames;
+        
+        db.for_each_student([&script, &unique_groups, &unique_surnames](const Student& s) {
+            script.phones.push_back(s.m_phone_number);
+            unique_groups.insert(s.m_group);
+            unique_surnames.insert(s.m_surname);
+        });
+        
+        if (script.phones.empty()) {
+            return script;
+        }
+        
+        script.groups.assign(unique_groups.begin(), unique_groups.end());
+        script.surnames.assign(unique_surnames.begin(), unique_surnames.end());
+        
+        std::mt19937 gen(seed);
+        std::vector<int> weights = {op1_ratio, op2_ratio, op3_ratio};
+        std::discrete_distribution<> dist(weights.begin(), weights.end());
+        std::uniform_int_distribution<size_t> phone_dist(0, script.phones.size() - 1);
+        std::uniform_int_distribution<size_t> group_dist(0, script.groups.size() - 1);
+        std::uniform_int_distribution<size_t> surname_dist(0, script.surnames.size() - 1);
+        
+        script.steps.reserve(length);
+        
+        for (size_t i = 0; i < length; ++i) {
+            OperationScript::Step step;
+            step.operation = dist(gen);
+            step.new_group = 0;
+            
+            switch (step.operation) {
+                case 0:
+                    step.key = phone_dist(gen);
+                    step.new_group = group_dist(gen);
+                    break;
+                case 1:
+                    step.key = group_dist(gen);
+                    break;
+                default:
+                    step.key = surname_dist(gen);
+                    break;
+            }
+            
+            script.steps.push_back(step);
+        }
+        
+        return script;
+    }
+    
+    double replay_operation_script_virtual(IStudentDatabase& db, const OperationScript& script) {
+        return replay_operation_script(db, script);
+    }
+    
+    namespace {
+        template <typename Engine>
+        DispatchBenchmarkResult measure_dispatch_on(Engine& db, size_t script_length, size_t rounds) {
+            std::cout << "Testing " << db.get_container_name() << "..." << std::endl;
+            
+            OperationScript script = make_operation_script(db, script_length, 42);
+            return measure_dispatch_overhead(db, script, rounds);
+        }
+        
+        template <typename Engine>
+        DispatchBenchmarkResult measure_engine_dispatch(const std::vector<Student>& subset,
+                                                        size_t script_length, size_t rounds) {
+            Engine db(subset);
+            return measure_dispatch_on(db, script_length, rounds);
+        }
+        
+        // Same std::sort, comparator behind std::function vs an inlinable lambda
+        DispatchBenchmarkResult measure_comparator_dispatch(const std::vector<Student>& subset, size_t rounds) {
+            std::cout << "Testing rating sort comparators..." << std::endl;
+            
+            DispatchBenchmarkResult result;
+            result.container_name = "std::sort by rating (std::function vs lambda comparator)";
+            result.data_size = subset.size();
+            result.operations = subset.size();
+            
+            std::function<bool(const Student&, const Student&)> wrapped = student_comparators::compare_by_rating;
+            double best_virtual = 0;
+            double best_static = 0;
+            
+            for (size_t round = 0; round < rounds; ++round) {
+                std::vector<Student> data = subset;
+                auto start = std::chrono::high_resolution_clock::now();
+                sort_algorithms::std_sort(data, wrapped);
+                std::chrono::duration<double> virtual_seconds = std::chrono::high_resolution_clock::now() - start;
+                
+                data = subset;
+                start = std::chrono::high_resolution_clock::now();
+                std::sort(data.begin(), data.end(), [](const Student& a, const Student& b) {
+                    return a.m_rating < b.m_rating;
+                });
+                std::chrono::duration<double> static_seconds = std::chrono::high_resolution_clock::now() - start;
+                
+                if (round == 0 || virtual_seconds.count() < best_virtual) {
+                    best_virtual = virtual_seconds.count();
+                }
+                if (round == 0 || static_seconds.count() < best_static) {
+                    best_static = static_seconds.count();
+                }
+            }
+            
+            double elements = std::max<size_t>(result.operations, 1);
+            result.virtual_ns_per_op = best_virtual * 1e9 / elements;
+            result.static_ns_per_op = best_static * 1e9 / elements;
+            result.overhead_ns_per_op = result.virtual_ns_per_op - result.static_ns_per_op;
+            result.overhead_percent = result.virtual_ns_per_op > 0
+                ? result.overhead_ns_per_op * 100.0 / result.virtual_ns_per_op
+                : 0.0;
+            
+            return result;
+        }
+    }
+    
+    // Virtual vs static dispatch on every engine
+    std::vector<DispatchBenchmarkResult> run_all_dispatch_benchmarks(
+        const std::vector<size_t>& data_sizes,
+        size_t script_length,
+        size_t rounds) {
+        
+        std::vector<DispatchBenchmarkResult> all_results;
+        
+        std::vector<Student> full_data = csv::read_csv("data/students.csv");
+        
+        for (size_t data_size : data_sizes) {
+            std::cout << "\n=== Testing with data size: " << data_size << " ===\n" << std::endl;
+            
+            std::vector<Student> subset(full_data.begin(), 
+                                       full_data.begin() + std::min(data_size, full_data.size()));
+            
+            all_results.push_back(measure_engine_dispatch<DatabaseVector>(subset, script_length, rounds));
+            all_results.push_back(measure_engine_dispatch<DatabaseHashMap>(subset, script_length, rounds));
+            all_results.push_back(measure_engine_dispatch<DatabaseTreeMap>(subset, script_length, rounds));
+            all_results.push_back(measure_engine_dispatch<DatabaseHybrid>(subset, script_length, rounds));
+            all_results.push_back(measure_engine_dispatch<DatabaseIndexed>(subset, script_length, rounds));
+            all_results.push_back(measure_engine_dispatch<DatabaseConcurrent>(subset, script_length, rounds));
+            all_results.push_back(measure_engine_dispatch<DatabaseAdaptive>(subset, script_length, rounds));
+            
+            DatabaseCached db_cached_hybrid(std::make_unique<DatabaseHybrid>(subset));
+            all_results.push_back(measure_dispatch_on(db_cached_hybrid, script_length, rounds));
+            
+            all_results.push_back(measure_comparator_dispatch(subset, rounds));
+        }
+        
+        return all_results;
+    }
+    
+    // Batched operations benchmark: every step sends batch_size keys of one operation
+    OperationBenchmarkResult run_batched_operations_benchmark(
         IStudentDatabase* db,
+        size_t batch_size,
         double duration_seconds,
         int op1_ratio,
         int op2_ratio,
         int op3_ratio) {
         
         OperationBenchmarkResult result;
-        result.container_name = db->get_container_name();
+        result.container_name = db->get_container_name() + " [batch " + std::to_string(batch_size) + "]";
         result.data_size = db->size();
         result.op1_count = 0;
         result.op2_count = 0;
         result.op3_count = 0;
+        result.cache_hits = 0;
+        result.cache_misses = 0;
+        result.batch_size = batch_size;
+        result.duration_seconds = 0;
+        result.total_operations = 0;
+        result.operations_per_second = 0;
+        result.memory_usage_bytes = 0;
+        result.memory_usage_mb = 0;
+        result.load = alloc_tracker::LoadFootprint{};
+        
+        std::vector<Student> all_students = db->to_vector();
+        if (all_students.empty() || batch_size == 0) {
+            return result;
+        }
         
-        // Setup random number generator
         std::random_device rd;
         std::mt19937 gen(rd());
         
-        // Create weighted distribution
         std::vector<int> weights = {op1_ratio, op2_ratio, op3_ratio};
         std::discrete_distribution<> dist(weights.begin(), weights.end());
         
-        // Get sample data for operations
-        std::vector<Student> all_students = db->to_vector();
-        if (all_students.empty()) {
-            result.duration_seconds = 0;
-            result.total_operations = 0;
-            result.operations_per_second = 0;
-            result.memory_usage_bytes = 0;
-            result.memory_usage_mb = 0;
-            return result;
-        }
-        
-        // Prepare random phones, groups, and surnames
         std::vector<std::string> phones, groups, surnames;
         std::set<std::string> unique_groups, unique_surnames;
         
@@ -81,16 +489,18 @@ namespace benchmark {
             unique_groups.insert(s.m_group);
             unique_surnames.insert(s.m_surname);
         }
-    
+        
         groups.assign(unique_groups.begin(), unique_groups.end());
         surnames.assign(unique_surnames.begin(), unique_surnames.end());
         
         std::uniform_int_distribution<> phone_dist(0, phones.size() - 1);
         std::uniform_int_distribution<> group_dist(0, groups.size() - 1);
         std::uniform_int_distribution<> surname_dist(0, surnames.size() - 1);
-        std::uniform_int_distribution<> new_group_dist(0, groups.size() - 1);
         
-        // Run operations for specified duration
+        // Key buffers reused across batches
+        std::vector<std::pair<std::string, std::string>> changes(batch_size);
+        std::vector<std::string> keys(batch_size);
+        
         auto start_time = std::chrono::high_resolution_clock::now();
         auto end_time = start_time + std::chrono::duration<double>(duration_seconds);
         
@@ -98,35 +508,38 @@ namespace benchmark {
             int operation = dist(gen);
             
             switch (operation) {
-                case 0: // Operation 1: Change group by phone
-                    {
-                        std::string phone = phones[phone_dist(gen)];
-                        std::string new_group = groups[new_group_dist(gen)];
-                        db->change_group_by_phone(phone, new_group);
-                        result.op1_count++;
+                case 0: // Operation 1 batch: change groups by phone
+                    for (auto& change : changes) {
+                        change.first = phones[phone_dist(gen)];
+                        change.second = groups[group_dist(gen)];
                     }
+                    db->change_group_batch(changes);
+                    result.op1_count += batch_size;
                     break;
                     
-                case 1: // Operation 2: Get students by group sorted
+                case 1: // Operation 2 batch: students by groups sorted
+                    for (auto& key : keys) {
+                        key = groups[group_dist(gen)];
+                    }
                     {
-                        std::string group = groups[group_dist(gen)];
-                        auto students = db->get_students_by_group_sorted(group);
-                        result.op2_count++;
+                        auto rosters = db->get_students_by_groups_sorted(keys);
                     }
+                    result.op2_count += batch_size;
                     break;
                     
-                case 2: // Operation 3: Get groups by surname
+                case 2: // Operation 3 batch: groups by surnames
+                    for (auto& key : keys) {
+                        key = surnames[surname_dist(gen)];
+                    }
                     {
-                        std::string surname = surnames[surname_dist(gen)];
-                        auto result_groups = db->get_groups_by_surname(surname);
-                        result.op3_count++;
+                        auto result_groups = db->get_groups_by_surnames(keys);
                     }
+                    result.op3_count += batch_size;
                     break;
             }
         }
         
-        auto actual_end = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> actual_duration = actual_end - start_time;
+        std::chrono::duration<double> actual_duration = std::chrono::high_resolution_clock::now() - start_time;
         
         result.duration_seconds = actual_duration.count();
         result.total_operations = result.op1_count + result.op2_count + result.op3_count;
@@ -137,9 +550,10 @@ namespace benchmark {
         return result;
     }
     
-    // Run benchmarks on all database implementations
-    std::vector<OperationBenchmarkResult> run_all_operations_benchmarks(
+    // Batched benchmarks on all database implementations
+    std::vector<OperationBenchmarkResult> run_all_batched_benchmarks(
         const std::vector<size_t>& data_sizes,
+        const std::vector<size_t>& batch_sizes,
         double duration_seconds) {
         
         std::vector<OperationBenchmarkResult> all_results;
@@ -149,97 +563,530 @@ namespace benchmark {
         for (size_t data_size : data_sizes) {
             std::cout << "\n=== Testing with data size: " << data_size << " ===\n" << std::endl;
             
-            // Prepare subset of data
             std::vector<Student> subset(full_data.begin(), 
                                        full_data.begin() + std::min(data_size, full_data.size()));
             
-            // Variant V3 ratios: 5:10:100
-            const int OP1_RATIO = 5;   // Change group by phone
-            const int OP2_RATIO = 10;  // Get students by group sorted
-            const int OP3_RATIO = 100; // Get groups by surname
+            std::vector<std::unique_ptr<IStudentDatabase>> databases;
+            databases.push_back(std::make_unique<DatabaseVector>(subset));
+            databases.push_back(std::make_unique<DatabaseHashMap>(subset));
+            databases.push_back(std::make_unique<DatabaseTreeMap>(subset));
+            databases.push_back(std::make_unique<DatabaseHybrid>(subset));
+            databases.push_back(std::make_unique<DatabaseBitmap>(subset));
+            databases.push_back(std::make_unique<DatabaseIndexed>(subset));
+            databases.push_back(std::make_unique<DatabaseConcurrent>(subset));
+            databases.push_back(std::make_unique<DatabaseAdaptive>(subset));
+            databases.push_back(std::make_unique<DatabaseCached>(std::make_unique<DatabaseHybrid>(subset)));
             
-            // Test DatabaseVector
-            std::cout << "Testing DatabaseVector (std::vector)..." << std::endl;
-            DatabaseVector db_vector(subset);
-            auto result_vector = run_operations_benchmark(&db_vector, duration_seconds, OP1_RATIO, OP2_RATIO, OP3_RATIO);
-            all_results.push_back(result_vector);
+            for (const auto& db : databases) {
+                for (size_t batch_size : batch_sizes) {
+                    std::cout << "Testing " << db->get_container_name() << " with batch size " << batch_size << "..." << std::endl;
+                    all_results.push_back(run_batched_operations_benchmark(db.get(), batch_size, duration_seconds));
+                }
+            }
+        }
+        
+        return all_results;
+    }
+    
+    // Read-only query benchmark
+    QueryBenchmarkResult run_query_benchmark(
+        IStudentDatabase* db,
+        const std::string& query_name,
+        const std::function<size_t(size_t)>& query,
+        double duration_seconds) {
+        
+        QueryBenchmarkResult result;
+        result.container_name = db->get_container_name();
+        result.query_name = query_name;
+        result.data_size = db->size();
+        result.query_count = 0;
+        result.rows_returned = 0;
+        
+        auto start_time = std::chrono::high_resolution_clock::now();
+        auto end_time = start_time + std::chrono::duration<double>(duration_seconds);
+        
+        while (std::chrono::high_resolution_clock::now() < end_time) {
+            result.rows_returned += query(result.query_count);
+            ++result.query_count;
+        }
+        
+        std::chrono::duration<double> actual_duration = std::chrono::high_resolution_clock::now() - start_time;
+        
+        result.duration_seconds = actual_duration.count();
+        result.queries_per_second = result.query_count / result.duration_seconds;
+        result.avg_latency_us = result.duration_seconds * 1e6 / std::max<size_t>(result.query_count, 1);
+        result.memory_usage_mb = db->estimate_memory_usage() / (1024.0 * 1024.0);
+        
+        return result;
+    }
+    
+    // Query suite on scan-based and indexed engines
+    std::vector<QueryBenchmarkResult> run_all_query_benchmarks(
+        const std::vector<size_t>& data_sizes,
+        double duration_seconds) {
+        
+        const size_t QUERY_KEYS = 1024;
+        const size_t TYPE_AHEAD_LIMIT = 20;
+        
+        std::vector<QueryBenchmarkResult> all_results;
+        
+        std::vector<Student> full_data = csv::read_csv("data/students.csv");
+        
+        std::random_device rd;
+        std::mt19937 gen(rd());
+        
+        for (size_t data_size : data_sizes) {
+            std::cout << "\n=== Testing with data size: " << data_size << " ===\n" << std::endl;
             
-            // Test DatabaseHashMap
-            std::cout << "Testing DatabaseHashMap (std::unordered_map)..." << std::endl;
-            DatabaseHashMap db_hashmap(subset);
-            auto result_hashmap = run_operations_benchmark(&db_hashmap, duration_seconds, OP1_RATIO, OP2_RATIO, OP3_RATIO);
-            all_results.push_back(result_hashmap);
+            std::vector<Student> subset(full_data.begin(), 
+                                       full_data.begin() + std::min(data_size, full_data.size()));
             
-            // Test DatabaseTreeMap
-            std::cout << "Testing DatabaseTreeMap (std::map)..." << std::endl;
-            DatabaseTreeMap db_treemap(subset);
-            auto result_treemap = run_operations_benchmark(&db_treemap, duration_seconds, OP1_RATIO, OP2_RATIO, OP3_RATIO);
-            all_results.push_back(result_treemap);
+            if (subset.empty()) {
+                continue;
+            }
             
-            // Test DatabaseHybrid
-            std::cout << "Testing DatabaseHybrid (unordered_map + multimap indices)..." << std::endl;
-            DatabaseHybrid db_hybrid(subset);
-            auto result_hybrid = run_operations_benchmark(&db_hybrid, duration_seconds, OP1_RATIO, OP2_RATIO, OP3_RATIO);
-            all_results.push_back(result_hybrid);
+            // Prefixes of existing surnames, as typed into a search box
+            std::uniform_int_distribution<size_t> student_dist(0, subset.size() - 1);
+            std::vector<std::string> short_prefixes, long_prefixes;
+            
+            for (size_t i = 0; i < QUERY_KEYS; ++i) {
+                const std::string& surname = subset[student_dist(gen)].m_surname;
+                short_prefixes.push_back(surname.substr(0, 1));
+                long_prefixes.push_back(surname.substr(0, 3));
+            }
+            
+            // Range bounds: rating windows and 18-month birth windows (e.g. 2000-01 .. 2002-06)
+            std::uniform_real_distribution<float> rating_dist(0.0f, 90.0f);
+            std::uniform_int_distribution<int> year_dist(1950, 2008);
+            std::vector<float> rating_bounds;
+            std::vector<std::pair<int, int>> birth_bounds;
+            
+            for (size_t i = 0; i < QUERY_KEYS; ++i) {
+                rating_bounds.push_back(rating_dist(gen));
+                
+                int year = year_dist(gen);
+                birth_bounds.push_back({year * 10000 + 100, (year + 2) * 10000 + 699});
+            }
+            
+            std::set<std::string> unique_groups;
+            for (const auto& s : subset) {
+                unique_groups.insert(s.m_group);
+            }
+            std::vector<std::string> groups(unique_groups.begin(), unique_groups.end());
+            
+            std::vector<std::unique_ptr<IStudentDatabase>> databases;
+            databases.push_back(std::make_unique<DatabaseVector>(subset));
+            databases.push_back(std::make_unique<DatabaseHybrid>(subset));
+            databases.push_back(std::make_unique<DatabaseIndexed>(subset));
+            
+            for (const auto& db : databases) {
+                IStudentDatabase* engine = db.get();
+                std::cout << "Testing " << engine->get_container_name() << "..." << std::endl;
+                
+                all_results.push_back(run_query_benchmark(engine, "surname prefix len 1 (limit 20)",
+                    [&](size_t i) {
+                        return engine->get_students_by_surname_prefix(short_prefixes[i % QUERY_KEYS], TYPE_AHEAD_LIMIT).size();
+                    }, duration_seconds));
+                
+                all_results.push_back(run_query_benchmark(engine, "surname prefix len 3 (limit 20)",
+                    [&](size_t i) {
+                        return engine->get_students_by_surname_prefix(long_prefixes[i % QUERY_KEYS], TYPE_AHEAD_LIMIT).size();
+                    }, duration_seconds));
+                
+                all_results.push_back(run_query_benchmark(engine, "surname prefix len 3 (all)",
+                    [&](size_t i) {
+                        return engine->get_students_by_surname_prefix(long_prefixes[i % QUERY_KEYS], 0).size();
+                    }, duration_seconds));
+                
+                all_results.push_back(run_query_benchmark(engine, "rating range width 1",
+                    [&](size_t i) {
+                        float low = rating_bounds[i % QUERY_KEYS];
+                        return engine->get_students_by_rating_range(low, low + 1.0f).size();
+                    }, duration_seconds));
+                
+                all_results.push_back(run_query_benchmark(engine, "rating range width 10",
+                    [&](size_t i) {
+                        float low = rating_bounds[i % QUERY_KEYS];
+                        return engine->get_students_by_rating_range(low, low + 10.0f).size();
+                    }, duration_seconds));
+                
+                all_results.push_back(run_query_benchmark(engine, "birth range 18 months",
+                    [&](size_t i) {
+                        const auto& bounds = birth_bounds[i % QUERY_KEYS];
+                        return engine->get_students_by_birth_range(bounds.first, bounds.second).size();
+                    }, duration_seconds));
+                
+                all_results.push_back(run_query_benchmark(engine, "top-10 by rating in group",
+                    [&](size_t i) {
+                        return engine->top_k_by_rating(groups[i % groups.size()], 10).size();
+                    }, duration_seconds));
+                
+                all_results.push_back(run_query_benchmark(engine, "top-10 by rating per group",
+                    [&](size_t) {
+                        size_t rows = 0;
+                        for (const auto& pair : engine->top_k_by_rating_per_group(10)) {
+                            rows += pair.second.size();
+                        }
+                        return rows;
+                    }, duration_seconds));
+            }
+        }
+        
+        return all_results;
+    }
+    
+    // Bitmap set-algebra queries against the multimap / group-vector indices of DatabaseHybrid
+    std::vector<QueryBenchmarkResult> run_all_bitmap_query_benchmarks(
+        const std::vector<size_t>& data_sizes,
+        double duration_seconds) {
+        
+        const size_t QUERY_KEYS = 1024;
+        
+        std::vector<QueryBenchmarkResult> all_results;
+        
+        std::vector<Student> full_data = csv::read_csv("data/students.csv");
+        
+        std::random_device rd;
+        std::mt19937 gen(rd());
+        
+        for (size_t data_size : data_sizes) {
+            std::cout << "\n=== Testing with data size: " << data_size << " ===\n" << std::endl;
+            
+            std::vector<Student> subset(full_data.begin(), 
+                                       full_data.begin() + std::min(data_size, full_data.size()));
+            
+            if (subset.empty()) {
+                continue;
+            }
+            
+            // Surnames and groups drawn from existing rows; group_sets[i] are three groups to OR,
+            // excluded[i] one group to subtract
+            std::uniform_int_distribution<size_t> student_dist(0, subset.size() - 1);
+            std::vector<std::string> surnames, groups, excluded;
+            std::vector<std::vector<std::string>> group_sets;
+            
+            for (size_t i = 0; i < QUERY_KEYS; ++i) {
+                surnames.push_back(subset[student_dist(gen)].m_surname);
+                groups.push_back(subset[student_dist(gen)].m_group);
+                excluded.push_back(subset[student_dist(gen)].m_group);
+                group_sets.push_back({subset[student_dist(gen)].m_group,
+                                      subset[student_dist(gen)].m_group,
+                                      subset[student_dist(gen)].m_group});
+            }
+            
+            DatabaseHybrid hybrid(subset);
+            DatabaseBitmap bitmap(subset);
+            
+            std::cout << "Testing " << hybrid.get_container_name() << "..." << std::endl;
+            
+            std::vector<const Student*> view;
+            
+            all_results.push_back(run_query_benchmark(&hybrid, "Op3 groups by surname",
+                [&](size_t i) {
+                    return hybrid.get_groups_by_surname(surnames[i % QUERY_KEYS]).size();
+                }, duration_seconds));
+            
+            // Hybrid has one index per attribute: take the group roster and filter it
+            all_results.push_back(run_query_benchmark(&hybrid, "group AND surname (count)",
+                [&](size_t i) {
+                    const std::string& surname = surnames[i % QUERY_KEYS];
+                    size_t count = 0;
+                    
+                    hybrid.view_students_by_group_sorted(groups[i % QUERY_KEYS], view);
+                    for (const Student* s : view) {
+                        count += s->m_surname == surname;
+                    }
+                    return count;
+                }, duration_seconds));
+            
+            all_results.push_back(run_query_benchmark(&hybrid, "group AND surname (rows)",
+                [&](size_t i) {
+                    const std::string& surname = surnames[i % QUERY_KEYS];
+                    std::vector<Student> rows;
+                    
+                    hybrid.view_students_by_group_sorted(groups[i % QUERY_KEYS], view);
+                    for (const Student* s : view) {
+                        if (s->m_surname == surname) {
+                            rows.push_back(*s);
+                        }
+                    }
+                    return rows.size();
+                }, duration_seconds));
+            
+            all_results.push_back(run_query_benchmark(&hybrid, "3 groups AND surname ANDNOT group",
+                [&](size_t i) {
+                    const std::string& surname = surnames[i % QUERY_KEYS];
+                    const std::string& skip = excluded[i % QUERY_KEYS];
+                    std::set<std::string> seen;
+                    std::vector<Student> rows;
+                    
+                    for (const auto& group : group_sets[i % QUERY_KEYS]) {
+                        if (group == skip || !seen.insert(group).second) {
+                            continue;
+                        }
+                        
+                        hybrid.view_students_by_group_sorted(group, view);
+                        for (const Student* s : view) {
+                            if (s->m_surname == surname) {
+                                rows.push_back(*s);
+                            }
+                        }
+                    }
+                    
+                    std::sort(rows.begin(), rows.end(), student_comparators::compare_by_surname_and_name);
+                    return rows.size();
+                }, duration_seconds));
+            
+            std::cout << "Testing " << bitmap.get_container_name() << "..." << std::endl;
+            
+            all_results.push_back(run_query_benchmark(&bitmap, "Op3 groups by surname",
+                [&](size_t i) {
+                    return bitmap.get_groups_by_surname(surnames[i % QUERY_KEYS]).size();
+                }, duration_seconds));
+            
+            all_results.push_back(run_query_benchmark(&bitmap, "Op3 groups by surname (intersect only)",
+                [&](size_t i) {
+                    return bitmap.get_groups_by_surname_intersect(surnames[i % QUERY_KEYS]).size();
+                }, duration_seconds));
+            
+            all_results.push_back(run_query_benchmark(&bitmap, "group AND surname (count)",
+                [&](size_t i) {
+                    return bitmap.count_students({{groups[i % QUERY_KEYS]}, {surnames[i % QUERY_KEYS]}, {}});
+                }, duration_seconds));
+            
+            all_results.push_back(run_query_benchmark(&bitmap, "group AND surname (rows)",
+                [&](size_t i) {
+                    return bitmap.get_students({{groups[i % QUERY_KEYS]}, {surnames[i % QUERY_KEYS]}, {}}).size();
+                }, duration_seconds));
+            
+            all_results.push_back(run_query_benchmark(&bitmap, "3 groups AND surname ANDNOT group",
+                [&](size_t i) {
+                    return bitmap.get_students({group_sets[i % QUERY_KEYS], {surnames[i % QUERY_KEYS]},
+                                                {excluded[i % QUERY_KEYS]}}).size();
+                }, duration_seconds));
         }
         
         return all_results;
     }
     
-    // Sorting benchmarks comparing all 7 sorting algorithms
-    std::vector<SortBenchmarkResult> run_sorting_benchmarks(
-        const std::vector<Student>& data,
-        std::function<bool(const Student&, const Student&)> comparator) {
+    // Concurrent readers verify every result while writers mutate
+    StressTestResult run_concurrent_stress_test(
+        DatabaseConcurrent& db,
+        size_t reader_threads,
+        size_t writer_threads,
+        double duration_seconds) {
         
-        std::vector<SortBenchmarkResult> results;
+        StressTestResult result;
+        result.container_name = db.get_container_name();
+        result.data_size = db.size();
+        result.reader_threads = reader_threads;
+        result.writer_threads = writer_threads;
         
-        // Test std::sort 
-        std::cout << "Testing std::sort..." << std::endl;
-        results.push_back(measure_sort<Student>("std::sort", data, 
-                                      sort_algorithms::std_sort, comparator));
+        std::vector<Student> all_students = db.to_vector();
+        std::vector<std::string> groups, surnames;
+        std::set<std::string> unique_groups, unique_surnames;
         
-        // Test Bubble Sort
-        if (data.size() <= 10000) {
-            std::cout << "Testing Bubble Sort..." << std::endl;
-            results.push_back(measure_sort<Student>("Bubble Sort", data,
-                                          sort_algorithms::bubble_sort, comparator));
+        for (const auto& s : all_students) {
+            unique_groups.insert(s.m_group);
+            unique_surnames.insert(s.m_surname);
         }
         
-        // Test Insertion Sort
-        if (data.size() <= 10000) {
-            std::cout << "Testing Insertion Sort..." << std::endl;
-            results.push_back(measure_sort<Student>("Insertion Sort", data,
-                                          sort_algorithms::insertion_sort, comparator));
+        groups.assign(unique_groups.begin(), unique_groups.end());
+        surnames.assign(unique_surnames.begin(), unique_surnames.end());
+        
+        std::atomic<bool> stop{false};
+        std::atomic<size_t> reads{0}, writes{0}, checks{0}, forks{0}, violations{0};
+        const size_t expected_size = all_students.size();
+        
+        auto reader = [&](unsigned seed) {
+            std::mt19937 gen(seed);
+            std::uniform_int_distribution<size_t> group_dist(0, groups.size() - 1);
+            std::uniform_int_distribution<size_t> surname_dist(0, surnames.size() - 1);
+            size_t local_reads = 0, local_checks = 0, local_forks = 0, local_violations = 0;
+            std::vector<const Student*> view;
+            std::vector<const std::string*> group_view;
+            
+            // Reads issued per round: 2 group reads, 10 + 1 surname reads, 2 batched reads
+            constexpr size_t READS_PER_ROUND = 15;
+            
+            while (!stop.load(std::memory_order_relaxed)) {
+                const std::string& group = groups[group_dist(gen)];
+                auto students = db.get_students_by_group_sorted(group);
+                
+                for (const auto& s : students) {
+                    if (s.m_group != group) {
+                        ++local_violations;
+                    }
+                }
+                
+                if (!std::is_sorted(students.begin(), students.end(), student_comparators::compare_by_surname_and_name)) {
+                    ++local_violations;
+                }
+                
+                // The view is pinned by this thread, so its records survive the writers' publishes
+                db.view_students_by_group_sorted(group, view);
+                
+                for (const Student* s : view) {
+                    if (s->m_group != group) {
+                        ++local_violations;
+                    }
+                }
+                
+                if (!std::is_sorted(view.begin(), view.end(), [](const Student* a, const Student* b) {
+                        return student_comparators::compare_by_surname_and_name(*a, *b);
+                    })) {
+                    ++local_violations;
+                }
+                
+                db.view_groups_by_surname(surnames[surname_dist(gen)], group_view);
+                
+                if (std::adjacent_find(group_view.begin(), group_view.end(), [](const std::string* a, const std::string* b) {
+                        return *a >= *b;
+                    }) != group_view.end()) {
+                    ++local_violations;
+                }
+                
+                // Batched reads must answer every key like the single-key operations
+                std::vector<std::string> batch_surnames = {surnames[surname_dist(gen)], surnames[surname_dist(gen)],
+                                                           surnames[surname_dist(gen)]};
+                auto batch_groups = db.get_groups_by_surnames(batch_surnames);
+                
+                if (batch_groups.size() != batch_surnames.size()) {
+                    ++local_violations;
+                }
+                
+                for (const auto& result_groups : batch_groups) {
+                    if (std::adjacent_find(result_groups.begin(), result_groups.end(),
+                                           std::greater_equal<std::string>()) != result_groups.end()) {
+                        ++local_violations;
+                    }
+                }
+                
+                std::vector<std::string> batch_keys = {groups[group_dist(gen)], groups[group_dist(gen)]};
+                auto batch_rosters = db.get_students_by_groups_sorted(batch_keys);
+                
+                if (batch_rosters.size() != batch_keys.size()) {
+                    ++local_violations;
+                }
+                
+                for (size_t i = 0; i < batch_rosters.size() && i < batch_keys.size(); ++i) {
+                    for (const auto& s : batch_rosters[i]) {
+                        if (s.m_group != batch_keys[i]) {
+                            ++local_violations;
+                        }
+                    }
+                }
+                
+                for (int i = 0; i < 10; ++i) {
+                    auto result_groups = db.get_groups_by_surname(surnames[surname_dist(gen)]);
+                    
+                    if (std::adjacent_find(result_groups.begin(), result_groups.end(),
+                                           std::greater_equal<std::string>()) != result_groups.end()) {
+                        ++local_violations;
+                    }
+                }
+                
+                local_reads += READS_PER_ROUND;
+                
+                if (local_reads % (READS_PER_ROUND * 100) == 0) {
+                    if (!db.verify_consistency() || db.size() != expected_size) {
+                        ++local_violations;
+                    }
+                    ++local_checks;
+                }
+                
+                // A fork must stay frozen while the writers keep publishing
+                if (local_reads % (READS_PER_ROUND * 1000) == 0) {
+                    std::unique_ptr<DatabaseConcurrent> fork = db.fork();
+                    std::vector<Student> before = fork->to_vector();
+                    
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    
+                    std::vector<Student> after = fork->to_vector();
+                    bool same = before.size() == after.size()
+                        && std::equal(before.begin(), before.end(), after.begin(),
+                        [](const Student& a, const Student& b) {
+                            return a.m_phone_number == b.m_phone_number && a.m_group == b.m_group;
+                        });
+                    
+                    if (!same || !fork->verify_consistency() || fork->size() != expected_size) {
+                        ++local_violations;
+                    }
+                    ++local_forks;
+                }
+            }
+            
+            reads += local_reads;
+            checks += local_checks;
+            forks += local_forks;
+            violations += local_violations;
+        };
+        
+        auto writer = [&](unsigned seed) {
+            std::mt19937 gen(seed);
+            std::uniform_int_distribution<size_t> student_dist(0, all_students.size() - 1);
+            std::uniform_int_distribution<size_t> group_dist(0, groups.size() - 1);
+            size_t local_writes = 0;
+            
+            while (!stop.load(std::memory_order_relaxed)) {
+                Student student = all_students[student_dist(gen)];
+                
+                if (local_writes % 20 == 19) {
+                    student.m_group = groups[group_dist(gen)];
+                    db.add(student);
+                } else if (local_writes % 10 == 9) {
+                    // Batched moves apply in order, so a repeated phone ends in its last group
+                    std::vector<std::pair<std::string, std::string>> changes;
+                    
+                    for (int i = 0; i < 4; ++i) {
+                        changes.emplace_back(all_students[student_dist(gen)].m_phone_number, groups[group_dist(gen)]);
+                    }
+                    
+                    db.change_group_batch(changes);
+                } else {
+                    db.change_group_by_phone(student.m_phone_number, groups[group_dist(gen)]);
+                }
+                
+                ++local_writes;
+            }
+            
+            writes += local_writes;
+        };
+        
+        std::vector<std::thread> threads;
+        std::random_device rd;
+        
+        auto start_time = std::chrono::high_resolution_clock::now();
+        
+        for (size_t i = 0; i < reader_threads; ++i) {
+            threads.emplace_back(reader, rd());
         }
         
-        // Test Selection Sort
-        if (data.size() <= 10000) {
-            std::cout << "Testing Selection Sort..." << std::endl;
-            results.push_back(measure_sort<Student>("Selection Sort", data,
-                                          sort_algorithms::selection_sort, comparator));
+        for (size_t i = 0; i < writer_threads; ++i) {
+            threads.emplace_back(writer, rd());
         }
         
-        // Test Merge Sort
-        std::cout << "Testing Merge Sort..." << std::endl;
-        results.push_back(measure_sort<Student>("Merge Sort", data,
-                                      sort_algorithms::merge_sort, comparator));
+        std::this_thread::sleep_for(std::chrono::duration<double>(duration_seconds));
+        stop = true;
         
-        // Test Quick Sort
-        std::cout << "Testing Quick Sort..." << std::endl;
-        results.push_back(measure_sort<Student>("Quick Sort", data,
-                                      sort_algorithms::quick_sort, comparator));
+        for (auto& thread : threads) {
+            thread.join();
+        }
         
-        // Test Heap Sort
-        std::cout << "Testing Heap Sort..." << std::endl;
-        results.push_back(measure_sort<Student>("Heap Sort", data,
-                                      sort_algorithms::heap_sort, comparator));
+        std::chrono::duration<double> actual_duration = std::chrono::high_resolution_clock::now() - start_time;
         
-        // Test Radix Sort
-        std::cout << "Testing Radix Sort..." << std::endl;
-        results.push_back(measure_sort<Student>("Radix Sort", data,
-                                      sort_algorithms::radix_sort_by_rating, comparator));
+        if (!db.verify_consistency() || db.size() != expected_size) {
+            ++violations;
+        }
+        
+        result.reads = reads;
+        result.writes = writes;
+        result.consistency_checks = checks + 1;
+        result.forks = forks;
+        result.violations = violations;
+        result.duration_seconds = actual_duration.count();
         
-        return results;
+        return result;
     }
     
     // Save operation results to CSV
@@ -260,7 +1107,8 @@ namespace benchmark {
         // Write results grouped by data size
         for (const auto& [size, size_results] : grouped_by_size) {
             file << "\n=== Data Size: " << size << " ===\n";
-            file << "Container,Op1 Count,Op2 Count,Op3 Count,Total Ops,Ops/sec,Memory (MB)\n";
+            file << "Container,Op1 Count,Op2 Count,Op3 Count,Total Ops,Ops/sec,Memory (MB),Cache Hits,Cache Misses,"
+                 << "Heap (MB),Heap Blocks,Load Allocations,RSS Before (MB),RSS After (MB),Peak RSS (MB)\n";
             
             for (const auto& result : size_results) {
                 file << result.container_name << ","
@@ -269,7 +1117,15 @@ namespace benchmark {
                      << result.op3_count << ","
                      << result.total_operations << ","
                      << std::fixed << std::setprecision(2) << result.operations_per_second << ","
-                     << std::fixed << std::setprecision(2) << result.memory_usage_mb << "\n";
+                     << std::fixed << std::setprecision(2) << result.memory_usage_mb << ","
+                     << result.cache_hits << ","
+                     << result.cache_misses << ","
+                     << std::fixed << std::setprecision(2) << result.load.heap_bytes / (1024.0 * 1024.0) << ","
+                     << result.load.heap_blocks << ","
+                     << result.load.allocations << ","
+                     << std::fixed << std::setprecision(2) << result.load.rss_before_bytes / (1024.0 * 1024.0) << ","
+                     << std::fixed << std::setprecision(2) << result.load.rss_after_bytes / (1024.0 * 1024.0) << ","
+                     << std::fixed << std::setprecision(2) << result.load.peak_rss_bytes / (1024.0 * 1024.0) << "\n";
             }
         }
         
@@ -303,7 +1159,7 @@ namespace benchmark {
         }
         
         // Memory usage comparison
-        file << "\n=== Memory Usage Comparison (MB) ===\n";
+        file << "\n=== Memory Usage Comparison (MB, estimated) ===\n";
         file << "Container";
         for (const auto& [size, _] : grouped_by_size) {
             file << ",Size " << size;
@@ -326,6 +1182,30 @@ namespace benchmark {
             file << "\n";
         }
         
+        // Counted heap comparison (alloc_tracker), next to the estimates above
+        file << "\n=== Heap Usage Comparison (MB, counted) ===\n";
+        file << "Container";
+        for (const auto& [size, _] : grouped_by_size) {
+            file << ",Size " << size;
+        }
+        file << "\n";
+        
+        for (const auto& container : containers) {
+            file << container;
+            for (const auto& [size, size_results] : grouped_by_size) {
+                bool found = false;
+                for (const auto& result : size_results) {
+                    if (result.container_name == container) {
+                        file << "," << std::fixed << std::setprecision(2) << result.load.heap_bytes / (1024.0 * 1024.0);
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found) file << ",N/A";
+            }
+            file << "\n";
+        }
+        
         file.close();
         std::cout << "Operation benchmark results saved to " << filename << std::endl;
         return true;
@@ -372,7 +1252,88 @@ namespace benchmark {
         return true;
     }
     
-    // Print operation results to console
+    // Save query benchmark results to CSV
+    bool save_query_results(const std::vector<QueryBenchmarkResult>& results,
+                            const std::string& filename) {
+        std::ofstream file(filename);
+        
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not create file " << filename << std::endl;
+            return false;
+        }
+        
+        file << "Container,Query,Data Size,Queries,Rows Returned,Queries/sec,Avg Latency (us),Memory (MB)\n";
+        
+        for (const auto& result : results) {
+            file << result.container_name << ","
+                 << result.query_name << ","
+                 << result.data_size << ","
+                 << result.query_count << ","
+                 << result.rows_returned << ","
+                 << std::fixed << std::setprecision(2) << result.queries_per_second << ","
+                 << std::fixed << std::setprecision(3) << result.avg_latency_us << ","
+                 << std::fixed << std::setprecision(2) << result.memory_usage_mb << "\n";
+        }
+        
+        file.close();
+        std::cout << "Query benchmark results saved to " << filename << std::endl;
+        
+        return true;
+    }
+    
+    bool save_load_results(const std::vector<LoadBenchmarkResult>& results,
+                           const std::string& filename) {
+        std::ofstream file(filename);
+        
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not create file " << filename << std::endl;
+            return false;
+        }
+        
+        file << "Container,Method,Data Size,Duration (ms),Rows/sec,Heap (MB)\n";
+        
+        for (const auto& result : results) {
+            file << result.container_name << ","
+                 << result.method << ","
+                 << result.data_size << ","
+                 << std::fixed << std::setprecision(2) << result.duration_ms << ","
+                 << std::fixed << std::setprecision(2) << result.rows_per_second << ","
+                 << std::fixed << std::setprecision(2) << result.heap_mb << "\n";
+        }
+        
+        file.close();
+        std::cout << "Load benchmark results saved to " << filename << std::endl;
+        
+        return true;
+    }
+    
+    bool save_dispatch_results(const std::vector<DispatchBenchmarkResult>& results,
+                               const std::string& filename) {
+        std::ofstream file(filename);
+        
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not create file " << filename << std::endl;
+            return false;
+        }
+        
+        file << "Container,Data Size,Operations,Virtual (ns/op),Static (ns/op),Overhead (ns/op),Overhead (%)\n";
+        
+        for (const auto& result : results) {
+            file << result.container_name << ","
+                 << result.data_size << ","
+                 << result.operations << ","
+                 << std::fixed << std::setprecision(2) << result.virtual_ns_per_op << ","
+                 << std::fixed << std::setprecision(2) << result.static_ns_per_op << ","
+                 << std::fixed << std::setprecision(2) << result.overhead_ns_per_op << ","
+                 << std::fixed << std::setprecision(2) << result.overhead_percent << "\n";
+        }
+        
+        file.close();
+        std::cout << "Dispatch benchmark results saved to " << filename << std::endl;
+        
+        return true;
+    }
+    
     void print_operation_results(const std::vector<OperationBenchmarkResult>& results) {
         std::cout << "\n" << std::string(120, '=') << std::endl;
         std::cout << "OPERATION BENCHMARK RESULTS" << std::endl;
@@ -386,7 +1347,10 @@ namespace benchmark {
                   << std::setw(10) << "Op3"
                   << std::setw(12) << "Total Ops"
                   << std::setw(12) << "Ops/sec"
-                  << std::setw(15) << "Memory (MB)" << std::endl;
+                  << std::setw(15) << "Memory (MB)"
+                  << std::setw(12) << "Heap (MB)"
+                  << std::setw(12) << "Cache Hits"
+                  << std::setw(12) << "Cache Miss" << std::endl;
         std::cout << std::string(120, '-') << std::endl;
         
         for (const auto& result : results) {
@@ -399,29 +1363,160 @@ namespace benchmark {
                       << std::setw(12) << result.total_operations
                       << std::fixed << std::setprecision(2)
                       << std::setw(12) << result.operations_per_second
-                      << std::setw(15) << result.memory_usage_mb << std::endl;
+                      << std::setw(15) << result.memory_usage_mb
+                      << std::setw(12) << result.load.heap_bytes / (1024.0 * 1024.0)
+                      << std::setw(12) << result.cache_hits
+                      << std::setw(12) << result.cache_misses << std::endl;
         }
         
         std::cout << std::string(120, '=') << std::endl << std::endl;
     }
     
     void print_sort_results(const std::vector<SortBenchmarkResult>& results) {
-        std::cout << "\n" << std::string(60, '=') << std::endl;
+        std::cout << "\n" << std::string(64, '=') << std::endl;
         std::cout << "SORTING BENCHMARK RESULTS" << std::endl;
-        std::cout << std::string(60, '=') << std::endl;
+        std::cout << std::string(64, '=') << std::endl;
         
-        std::cout << std::left << std::setw(20) << "Algorithm"
+        std::cout << std::left << std::setw(32) << "Algorithm"
                   << std::setw(15) << "Data Size"
-                  << std::setw(20) << "Time (ms)" << std::endl;
-        std::cout << std::string(60, '-') << std::endl;
+                  << std::setw(17) << "Time (ms)" << std::endl;
+        std::cout << std::string(64, '-') << std::endl;
         
         for (const auto& result : results) {
-            std::cout << std::left << std::setw(20) << result.algorithm_name
+            std::cout << std::left << std::setw(32) << result.algorithm_name
                       << std::setw(15) << result.data_size
                       << std::fixed << std::setprecision(3) 
                       << std::setw(20) << result.execution_time_ms << std::endl;
         }
         
+        std::cout << std::string(64, '=') << std::endl << std::endl;
+    }
+    
+    void print_query_results(const std::vector<QueryBenchmarkResult>& results) {
+        std::cout << "\n" << std::string(120, '=') << std::endl;
+        std::cout << "QUERY BENCHMARK RESULTS" << std::endl;
+        std::cout << std::string(120, '=') << std::endl;
+        
+        std::cout << std::left
+                  << std::setw(50) << "Container"
+                  << std::setw(34) << "Query"
+                  << std::setw(12) << "Data Size"
+                  << std::setw(14) << "Queries/sec"
+                  << std::setw(10) << "Avg (us)" << std::endl;
+        std::cout << std::string(120, '-') << std::endl;
+        
+        for (const auto& result : results) {
+            std::cout << std::left
+                      << std::setw(50) << result.container_name
+                      << std::setw(34) << result.query_name
+                      << std::setw(12) << result.data_size
+                      << std::fixed << std::setprecision(2)
+                      << std::setw(14) << result.queries_per_second
+                      << std::setw(10) << result.avg_latency_us << std::endl;
+        }
+        
+        std::cout << std::string(120, '=') << std::endl << std::endl;
+    }
+    
+    void print_load_results(const std::vector<LoadBenchmarkResult>& results) {
+        std::cout << "\n" << std::string(110, '=') << std::endl;
+        std::cout << "LOAD BENCHMARK RESULTS" << std::endl;
+        std::cout << std::string(110, '=') << std::endl;
+        
+        std::cout << std::left
+                  << std::setw(48) << "Container"
+                  << std::setw(14) << "Method"
+                  << std::setw(12) << "Data Size"
+                  << std::setw(14) << "Time (ms)"
+                  << std::setw(12) << "Rows/sec"
+                  << std::setw(10) << "Heap (MB)" << std::endl;
+        std::cout << std::string(110, '-') << std::endl;
+        
+        for (const auto& result : results) {
+            std::cout << std::left
+                      << std::setw(48) << result.container_name
+                      << std::setw(14) << result.method
+                      << std::setw(12) << result.data_size
+                      << std::fixed << std::setprecision(2)
+                      << std::setw(14) << result.duration_ms
+                      << std::setw(12) << std::setprecision(0) << result.rows_per_second
+                      << std::setw(10) << std::setprecision(2) << result.heap_mb << std::endl;
+        }
+        
+        std::cout << std::string(110, '=') << std::endl << std::endl;
+    }
+    
+    void print_mapped_open_result(const MappedOpenResult& result) {
+        std::cout << "\n" << std::string(60, '=') << std::endl;
+        std::cout << "MAPPED DATABASE OPEN RESULTS" << std::endl;
+        std::cout << std::string(60, '=') << std::endl;
+        
+        std::cout << std::left << std::fixed << std::setprecision(2)
+                  << std::setw(36) << "File" << result.file_path << "\n"
+                  << std::setw(36) << "Records" << result.data_size << "\n"
+                  << std::setw(36) << "File size (MB)" << result.file_bytes / (1024.0 * 1024.0) << "\n"
+                  << std::setw(36) << "Build (ms)" << result.build_ms << "\n"
+                  << std::setw(36) << "Reopen (ms)" << result.open_ms << "\n"
+                  << std::setw(36) << "First Op2 after reopen (us)" << result.first_query_us << "\n"
+                  << std::setw(36) << "CSV parse + Hybrid build (ms)" << result.csv_load_ms << std::endl;
+        
+        std::cout << std::string(60, '=') << std::endl << std::endl;
+    }
+    
+    void print_dispatch_results(const std::vector<DispatchBenchmarkResult>& results) {
+        std::cout << "\n" << std::string(126, '=') << std::endl;
+        std::cout << "DISPATCH OVERHEAD RESULTS (virtual vs static)" << std::endl;
+        std::cout << std::string(126, '=') << std::endl;
+        
+        std::cout << std::left
+                  << std::setw(64) << "Container"
+                  << std::setw(12) << "Data Size"
+                  << std::setw(14) << "Virtual ns"
+                  << std::setw(14) << "Static ns"
+                  << std::setw(14) << "Overhead ns"
+                  << std::setw(8) << "%" << std::endl;
+        std::cout << std::string(126, '-') << std::endl;
+        
+        for (const auto& result : results) {
+            std::cout << std::left
+                      << std::setw(64) << result.container_name
+                      << std::setw(12) << result.data_size
+                      << std::fixed << std::setprecision(2)
+                      << std::setw(14) << result.virtual_ns_per_op
+                      << std::setw(14) << result.static_ns_per_op
+                      << std::setw(14) << result.overhead_ns_per_op
+                      << std::setw(8) << result.overhead_percent << std::endl;
+        }
+        
+        std::cout << std::string(126, '=') << std::endl << std::endl;
+    }
+    
+    void print_migration_log(const DatabaseAdaptive& db) {
+        for (const auto& event : db.migration_log()) {
+            std::cout << "[adaptive] " << (event.completed ? "migrated " : "migration started ")
+                      << DatabaseAdaptive::layout_name(event.from) << " -> " << DatabaseAdaptive::layout_name(event.to)
+                      << " at op " << event.operation << " (size " << event.data_size << ")" << std::endl;
+        }
+    }
+    
+    void print_stress_results(const StressTestResult& result) {
+        std::cout << "\n" << std::string(60, '=') << std::endl;
+        std::cout << "CONCURRENT STRESS TEST RESULTS" << std::endl;
+        std::cout << std::string(60, '=') << std::endl;
+        
+        std::cout << std::left
+                  << std::setw(24) << "Container" << result.container_name << "\n"
+                  << std::setw(24) << "Data Size" << result.data_size << "\n"
+                  << std::setw(24) << "Readers / Writers" << result.reader_threads << " / " << result.writer_threads << "\n"
+                  << std::setw(24) << "Reads" << result.reads << "\n"
+                  << std::setw(24) << "Writes" << result.writes << "\n"
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(24) << "Reads/sec" << result.reads / result.duration_seconds << "\n"
+                  << std::setw(24) << "Writes/sec" << result.writes / result.duration_seconds << "\n"
+                  << std::setw(24) << "Consistency Checks" << result.consistency_checks << "\n"
+                  << std::setw(24) << "Fork Checks" << result.forks << "\n"
+                  << std::setw(24) << "Violations" << result.violations << std::endl;
+        
         std::cout << std::string(60, '=') << std::endl << std::endl;
     }
     
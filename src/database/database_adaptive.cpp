@@ -0,0 +1,595 @@
+#include <algorithm>
+#include <vector>
+
+#include "database_adaptive.hpp"
+#include "csv_handler.hpp"
+#include "sorting.hpp"
+
+namespace {
+    constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    void erase_position(std::unordered_map<std::string, std::vector<size_t>>& index,
+                        const std::string& key, size_t position) {
+        auto it = index.find(key);
+
+        if (it == index.end()) {
+            return;
+        }
+
+        auto& positions = it->second;
+        auto pos_it = std::find(positions.begin(), positions.end(), position);
+
+        if (pos_it != positions.end()) {
+            *pos_it = positions.back();
+            positions.pop_back();
+        }
+
+        if (positions.empty()) {
+            index.erase(it);
+        }
+    }
+
+    void replace_position(std::unordered_map<std::string, std::vector<size_t>>& index,
+                          const std::string& key, size_t from, size_t to) {
+        auto it = index.find(key);
+
+        if (it != index.end()) {
+            std::replace(it->second.begin(), it->second.end(), from, to);
+        }
+    }
+
+    // Erase up to budget entries; returns how many were erased
+    template <typename Map>
+    size_t release_entries(Map& map, size_t budget) {
+        size_t released = 0;
+
+        while (released < budget && !map.empty()) {
+            map.erase(map.begin());
+            ++released;
+        }
+
+        return released;
+    }
+
+    size_t positions_memory(const std::unordered_map<std::string, std::vector<size_t>>& index) {
+        size_t memory = index.bucket_count() * sizeof(void*);
+        memory += index.size() * (sizeof(std::string) + sizeof(std::vector<size_t>) + sizeof(size_t) + sizeof(void*));
+
+        for (const auto& pair : index) {
+            memory += pair.first.capacity();
+            memory += pair.second.capacity() * sizeof(size_t);
+        }
+
+        return memory;
+    }
+}
+
+// Indices
+
+void DatabaseAdaptive::Indices::configure(Layout layout) {
+    phone.clear();
+    group.clear();
+    surname.clear();
+
+    phones_enabled = layout != Layout::Flat;
+    secondary_enabled = layout == Layout::Indexed;
+}
+
+void DatabaseAdaptive::Indices::insert(size_t position, const Student& student) {
+    if (phones_enabled) {
+        phone[student.m_phone_number] = position;
+    }
+
+    if (secondary_enabled) {
+        group[student.m_group].push_back(position);
+        surname[student.m_surname].push_back(position);
+    }
+}
+
+void DatabaseAdaptive::Indices::erase(size_t position, const Student& student) {
+    if (phones_enabled) {
+        phone.erase(student.m_phone_number);
+    }
+
+    if (secondary_enabled) {
+        erase_position(group, student.m_group, position);
+        erase_position(surname, student.m_surname, position);
+    }
+}
+
+void DatabaseAdaptive::Indices::relocate(size_t from, size_t to, const Student& student) {
+    if (phones_enabled) {
+        phone[student.m_phone_number] = to;
+    }
+
+    if (secondary_enabled) {
+        replace_position(group, student.m_group, from, to);
+        replace_position(surname, student.m_surname, from, to);
+    }
+}
+
+void DatabaseAdaptive::Indices::change_group(size_t position, const std::string& old_group,
+                                             const std::string& new_group) {
+    if (secondary_enabled) {
+        erase_position(group, old_group, position);
+        group[new_group].push_back(position);
+    }
+}
+
+size_t DatabaseAdaptive::Indices::estimate_memory_usage() const {
+    size_t memory = phone.bucket_count() * sizeof(void*);
+    memory += phone.size() * (sizeof(std::string) + sizeof(size_t) * 2 + sizeof(void*));
+
+    for (const auto& pair : phone) {
+        memory += pair.first.capacity();
+    }
+
+    return memory + positions_memory(group) + positions_memory(surname);
+}
+
+// Layout management
+
+DatabaseAdaptive::DatabaseAdaptive() {}
+
+DatabaseAdaptive::DatabaseAdaptive(const std::vector<Student>& initial_data) {
+    assign(initial_data);
+}
+
+DatabaseAdaptive::DatabaseAdaptive(const std::vector<Student>& initial_data, const Policy& adaptive_policy)
+    : policy(adaptive_policy) {
+    assign(initial_data);
+}
+
+void DatabaseAdaptive::assign(const std::vector<Student>& students) {
+    records.clear();
+    records.reserve(students.size());
+
+    // Upsert by phone like the map-based engines
+    std::unordered_map<std::string, size_t> positions;
+    positions.reserve(students.size());
+
+    for (const auto& student : students) {
+        auto inserted = positions.emplace(student.m_phone_number, records.size());
+
+        if (inserted.second) {
+            records.push_back(student);
+        } else {
+            records[inserted.first->second] = student;
+        }
+    }
+
+    // Assume a read-mostly mix until the first window has been observed
+    rebuild(choose_layout(1.0));
+}
+
+void DatabaseAdaptive::rebuild(Layout to) {
+    migrating = false;
+    pending = Indices();
+    retired.clear();
+
+    active.configure(to);
+    for (size_t i = 0; i < records.size(); ++i) {
+        active.insert(i, records[i]);
+    }
+
+    layout = to;
+    last_choice = to;
+    agreeing_windows = 0;
+}
+
+DatabaseAdaptive::Layout DatabaseAdaptive::choose_layout(double read_share) const {
+    if (records.size() <= policy.flat_max_size) {
+        return Layout::Flat;
+    }
+
+    return read_share >= policy.indexed_min_read_share ? Layout::Indexed : Layout::Hashed;
+}
+
+void DatabaseAdaptive::record_operation(OpKind kind) const {
+    ++window_counts[static_cast<size_t>(kind)];
+    ++total_operations;
+
+    migrate_step();
+    release_step();
+
+    size_t window_total = window_counts[0] + window_counts[1] + window_counts[2] + window_counts[3];
+
+    if (window_total >= policy.window_ops || window_scanned >= policy.window_scan_budget) {
+        evaluate();
+    }
+}
+
+void DatabaseAdaptive::evaluate() const {
+    size_t reads = window_counts[static_cast<size_t>(OpKind::GroupQuery)]
+                 + window_counts[static_cast<size_t>(OpKind::SurnameQuery)];
+    size_t total = window_counts[0] + window_counts[1] + window_counts[2] + window_counts[3];
+
+    Layout choice = choose_layout(total > 0 ? static_cast<double>(reads) / total : 1.0);
+
+    std::fill(std::begin(window_counts), std::end(window_counts), 0);
+    window_scanned = 0;
+
+    if (choice == last_choice) {
+        ++agreeing_windows;
+    } else {
+        last_choice = choice;
+        agreeing_windows = 1;
+    }
+
+    Layout goal = migrating ? target : layout;
+
+    if (choice == goal || agreeing_windows < policy.stable_windows) {
+        return;
+    }
+
+    if (choice > layout) {
+        start_migration(choice);
+        return;
+    }
+
+    // Same or cheaper layout: cancel any migration and stop maintaining the dropped indices right
+    // away; their memory is released a few entries per operation by release_step()
+    if (migrating) {
+        migrating = false;
+        retire(pending);
+    }
+
+    if (choice == layout) {
+        return;
+    }
+
+    Layout from = layout;
+
+    if (choice == Layout::Flat) {
+        retire(active);
+        active.configure(Layout::Flat);
+    } else {
+        Indices dropped;
+        dropped.group = std::move(active.group);
+        dropped.surname = std::move(active.surname);
+        retire(dropped);
+
+        active.group.clear();
+        active.surname.clear();
+        active.secondary_enabled = false;
+    }
+
+    layout = choice;
+    log_event(from, choice, true);
+}
+
+void DatabaseAdaptive::start_migration(Layout to) const {
+    retire(pending);
+    pending.configure(to);
+
+    target = to;
+    migrating = true;
+    migration_cursor = 0;
+
+    log_event(layout, to, false);
+}
+
+void DatabaseAdaptive::migrate_step() const {
+    if (!migrating) {
+        return;
+    }
+
+    size_t end = std::min(migration_cursor + policy.migration_step, records.size());
+
+    for (size_t i = migration_cursor; i < end; ++i) {
+        pending.insert(i, records[i]);
+    }
+
+    migration_cursor = end;
+
+    if (migration_cursor >= records.size()) {
+        Layout from = layout;
+
+        retire(active);
+        active = std::move(pending);
+        pending = Indices();
+        layout = target;
+        migrating = false;
+
+        log_event(from, layout, true);
+    }
+}
+
+void DatabaseAdaptive::retire(Indices& indices) const {
+    if (!indices.phone.empty() || !indices.group.empty() || !indices.surname.empty()) {
+        retired.push_back(std::move(indices));
+    }
+
+    indices = Indices();
+}
+
+void DatabaseAdaptive::release_step() const {
+    size_t budget = policy.migration_step;
+
+    while (budget > 0 && !retired.empty()) {
+        Indices& dropped = retired.back();
+
+        budget -= release_entries(dropped.phone, budget);
+        budget -= release_entries(dropped.group, budget);
+        budget -= release_entries(dropped.surname, budget);
+
+        if (dropped.phone.empty() && dropped.group.empty() && dropped.surname.empty()) {
+            retired.pop_back();
+        }
+    }
+}
+
+void DatabaseAdaptive::log_event(Layout from, Layout to, bool completed) const {
+    events.push_back({total_operations, records.size(), from, to, completed});
+}
+
+size_t DatabaseAdaptive::find_position(const std::string& phone_number) const {
+    if (active.phones_enabled) {
+        auto it = active.phone.find(phone_number);
+        return it != active.phone.end() ? it->second : NOT_FOUND;
+    }
+
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (records[i].m_phone_number == phone_number) {
+            window_scanned += i + 1;
+            return i;
+        }
+    }
+
+    window_scanned += records.size();
+
+    return NOT_FOUND;
+}
+
+// Basic operations
+
+bool DatabaseAdaptive::load_from_file(const std::string& filename) {
+    assign(csv::read_csv(filename));
+    return !records.empty();
+}
+
+bool DatabaseAdaptive::save_to_file(const std::string& filename) const {
+    return csv::write_csv(filename, records);
+}
+
+void DatabaseAdaptive::add(const Student& student) {
+    record_operation(OpKind::Mutation);
+
+    size_t position = find_position(student.m_phone_number);
+
+    if (position == NOT_FOUND) {
+        records.push_back(student);
+        active.insert(records.size() - 1, student);
+        return;
+    }
+
+    active.erase(position, records[position]);
+    if (migrating && position < migration_cursor) {
+        pending.erase(position, records[position]);
+    }
+
+    records[position] = student;
+
+    active.insert(position, student);
+    if (migrating && position < migration_cursor) {
+        pending.insert(position, student);
+    }
+}
+
+bool DatabaseAdaptive::remove_by_phone(const std::string& phone_number) {
+    record_operation(OpKind::Mutation);
+
+    size_t position = find_position(phone_number);
+
+    if (position == NOT_FOUND) {
+        return false;
+    }
+
+    // Swap-and-pop: the last record takes over the freed position
+    size_t last = records.size() - 1;
+
+    active.erase(position, records[position]);
+    if (position != last) {
+        active.relocate(last, position, records[last]);
+    }
+
+    if (migrating) {
+        if (position < migration_cursor) {
+            pending.erase(position, records[position]);
+        }
+
+        if (position != last) {
+            if (last < migration_cursor) {
+                pending.relocate(last, position, records[last]);
+            } else if (position < migration_cursor) {
+                pending.insert(position, records[last]);
+            }
+        }
+
+        migration_cursor = std::min(migration_cursor, last);
+    }
+
+    if (position != last) {
+        records[position] = std::move(records[last]);
+    }
+    records.pop_back();
+
+    return true;
+}
+
+size_t DatabaseAdaptive::size() const {
+    return records.size();
+}
+
+bool DatabaseAdaptive::empty() const {
+    return records.empty();
+}
+
+void DatabaseAdaptive::clear() {
+    records.clear();
+    rebuild(Layout::Flat);
+}
+
+std::vector<Student> DatabaseAdaptive::to_vector() const {
+    return records;
+}
+
+// Task operations
+
+bool DatabaseAdaptive::change_group_by_phone(const std::string& phone_number, const std::string& new_group) {
+    record_operation(OpKind::ChangeGroup);
+
+    size_t position = find_position(phone_number);
+
+    if (position == NOT_FOUND) {
+        return false;
+    }
+
+    Student& student = records[position];
+
+    if (student.m_group != new_group) {
+        active.change_group(position, student.m_group, new_group);
+        if (migrating && position < migration_cursor) {
+            pending.change_group(position, student.m_group, new_group);
+        }
+
+        student.m_group = new_group;
+    }
+
+    return true;
+}
+
+std::vector<Student> DatabaseAdaptive::get_students_by_group_sorted(const std::string& group) const {
+    std::vector<const Student*> view;
+    view_students_by_group_sorted(group, view);
+
+    std::vector<Student> result;
+    result.reserve(view.size());
+
+    for (const Student* student : view) {
+        result.push_back(*student);
+    }
+
+    return result;
+}
+
+std::vector<std::string> DatabaseAdaptive::get_groups_by_surname(const std::string& surname) const {
+    std::vector<const std::string*> view;
+    view_groups_by_surname(surname, view);
+
+    std::vector<std::string> result;
+    result.reserve(view.size());
+
+    for (const std::string* group : view) {
+        result.push_back(*group);
+    }
+
+    return result;
+}
+
+void DatabaseAdaptive::view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const {
+    record_operation(OpKind::GroupQuery);
+
+    out.clear();
+
+    if (active.secondary_enabled) {
+        auto it = active.group.find(group);
+
+        if (it != active.group.end()) {
+            for (size_t position : it->second) {
+                out.push_back(&records[position]);
+            }
+        }
+    } else {
+        for (const auto& student : records) {
+            if (student.m_group == group) {
+                out.push_back(&student);
+            }
+        }
+
+        window_scanned += records.size();
+    }
+
+    sort_algorithms::multikey_sort_by_surname_and_name(out);
+}
+
+void DatabaseAdaptive::view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const {
+    record_operation(OpKind::SurnameQuery);
+
+    out.clear();
+
+    if (active.secondary_enabled) {
+        auto it = active.surname.find(surname);
+
+        if (it != active.surname.end()) {
+            for (size_t position : it->second) {
+                out.push_back(&records[position].m_group);
+            }
+        }
+    } else {
+        for (const auto& student : records) {
+            if (student.m_surname == surname) {
+                out.push_back(&student.m_group);
+            }
+        }
+
+        window_scanned += records.size();
+    }
+
+    sort_unique_groups(out);
+}
+
+void DatabaseAdaptive::for_each_student(const std::function<void(const Student&)>& visitor) const {
+    for (const auto& student : records) {
+        visitor(student);
+    }
+}
+
+size_t DatabaseAdaptive::estimate_memory_usage() const {
+    size_t memory = sizeof(DatabaseAdaptive);
+    memory += records.capacity() * sizeof(Student);
+
+    for (const auto& student : records) {
+        memory += student.m_name.capacity();
+        memory += student.m_surname.capacity();
+        memory += student.m_email.capacity();
+        memory += student.m_group.capacity();
+        memory += student.m_phone_number.capacity();
+    }
+
+    memory += active.estimate_memory_usage();
+    memory += pending.estimate_memory_usage();
+
+    for (const auto& dropped : retired) {
+        memory += dropped.estimate_memory_usage();
+    }
+
+    memory += events.capacity() * sizeof(MigrationEvent);
+
+    return memory;
+}
+
+std::string DatabaseAdaptive::get_container_name() const {
+    return "Adaptive (flat / hashed / indexed)";
+}
+
+DatabaseAdaptive::Layout DatabaseAdaptive::current_layout() const {
+    return layout;
+}
+
+const std::vector<DatabaseAdaptive::MigrationEvent>& DatabaseAdaptive::migration_log() const {
+    return events;
+}
+
+std::string DatabaseAdaptive::layout_name(Layout layout) {
+    switch (layout) {
+        case Layout::Flat:
+            return "flat";
+        case Layout::Hashed:
+            return "hashed";
+        case Layout::Indexed:
+            return "indexed";
+    }
+
+    return "unknown";
+}
@@ -0,0 +1,374 @@
+#include <algorithm>
+
+#include "database_bitmap.hpp"
+#include "csv_handler.hpp"
+#include "sorting.hpp"
+
+DatabaseBitmap::DatabaseBitmap() : records(), free_ids(), live(), phone_index(), group_index(), surname_index() {}
+
+DatabaseBitmap::DatabaseBitmap(const std::vector<Student>& initial_data) {
+    records.reserve(initial_data.size());
+    phone_index.reserve(initial_data.size());
+
+    for (const auto& student : initial_data) {
+        add(student);
+    }
+}
+
+void DatabaseBitmap::add_to_indices(uint32_t id) {
+    const Student& student = records[id];
+
+    GroupBitmap& group = group_index[student.m_group];
+    if (group.name.empty()) {
+        group.name = student.m_group;
+    }
+    group.ids.add(id);
+
+    surname_index[student.m_surname].add(id);
+}
+
+void DatabaseBitmap::remove_from_group(uint32_t id, const std::string& group) {
+    // Emptied groups leave the table so they don't count towards the WALK_FACTOR plan switch
+    if (GroupBitmap* bucket = group_index.find(group)) {
+        bucket->ids.remove(id);
+
+        if (bucket->ids.empty()) {
+            group_index.erase(group);
+        }
+    }
+}
+
+void DatabaseBitmap::remove_from_indices(uint32_t id) {
+    const Student& student = records[id];
+
+    remove_from_group(id, student.m_group);
+
+    auto it = surname_index.find(student.m_surname);
+    if (it != surname_index.end()) {
+        it->second.remove(id);
+
+        if (it->second.empty()) {
+            surname_index.erase(it);
+        }
+    }
+}
+
+indexing::RoaringBitmap DatabaseBitmap::union_of_groups(const std::vector<std::string>& groups) const {
+    indexing::RoaringBitmap result;
+
+    for (const auto& group : groups) {
+        if (const GroupBitmap* bucket = group_index.find(group)) {
+            result = result.empty() ? bucket->ids : indexing::RoaringBitmap::unite(result, bucket->ids);
+        }
+    }
+
+    return result;
+}
+
+indexing::RoaringBitmap DatabaseBitmap::union_of_surnames(const std::vector<std::string>& surnames) const {
+    indexing::RoaringBitmap result;
+
+    for (const auto& surname : surnames) {
+        auto it = surname_index.find(surname);
+
+        if (it != surname_index.end()) {
+            result = result.empty() ? it->second : indexing::RoaringBitmap::unite(result, it->second);
+        }
+    }
+
+    return result;
+}
+
+bool DatabaseBitmap::load_from_file(const std::string& filename) {
+    std::vector<Student> temp = csv::read_csv(filename);
+    clear();
+
+    records.reserve(temp.size());
+    phone_index.reserve(temp.size());
+
+    for (const auto& student : temp) {
+        add(student);
+    }
+
+    return !phone_index.empty();
+}
+
+void DatabaseBitmap::add(const Student& student) {
+    auto it = phone_index.find(student.m_phone_number);
+
+    if (it != phone_index.end()) {
+        // Same phone: keep the id, re-file it under the new attributes
+        remove_from_indices(it->second);
+        records[it->second] = student;
+        add_to_indices(it->second);
+        return;
+    }
+
+    uint32_t id;
+
+    if (!free_ids.empty()) {
+        id = free_ids.back();
+        free_ids.pop_back();
+        records[id] = student;
+    } else {
+        id = static_cast<uint32_t>(records.size());
+        records.push_back(student);
+    }
+
+    phone_index.emplace(student.m_phone_number, id);
+    live.add(id);
+    add_to_indices(id);
+}
+
+bool DatabaseBitmap::remove_by_phone(const std::string& phone_number) {
+    auto it = phone_index.find(phone_number);
+
+    if (it == phone_index.end()) {
+        return false;
+    }
+
+    uint32_t id = it->second;
+
+    remove_from_indices(id);
+    live.remove(id);
+    phone_index.erase(it);
+
+    records[id] = Student();
+    free_ids.push_back(id);
+
+    return true;
+}
+
+size_t DatabaseBitmap::size() const {
+    return phone_index.size();
+}
+
+bool DatabaseBitmap::empty() const {
+    return phone_index.empty();
+}
+
+void DatabaseBitmap::clear() {
+    records.clear();
+    free_ids.clear();
+    live.clear();
+    phone_index.clear();
+    group_index.clear();
+    surname_index.clear();
+}
+
+std::vector<Student> DatabaseBitmap::to_vector() const {
+    std::vector<Student> result;
+    result.reserve(phone_index.size());
+
+    live.for_each([this, &result](uint32_t id) {
+        result.push_back(records[id]);
+    });
+
+    return result;
+}
+
+bool DatabaseBitmap::change_group_by_phone(const std::string& phone_number, const std::string& new_group) {
+    auto it = phone_index.find(phone_number);
+
+    if (it == phone_index.end()) {
+        return false;
+    }
+
+    uint32_t id = it->second;
+    Student& student = records[id];
+
+    remove_from_group(id, student.m_group);
+
+    student.m_group = new_group;
+
+    GroupBitmap& group = group_index[new_group];
+    if (group.name.empty()) {
+        group.name = new_group;
+    }
+    group.ids.add(id);
+
+    return true;
+}
+
+std::vector<Student> DatabaseBitmap::get_students_by_group_sorted(const std::string& group) const {
+    std::vector<Student> result;
+
+    if (const GroupBitmap* bucket = group_index.find(group)) {
+        result.reserve(bucket->ids.cardinality());
+
+        bucket->ids.for_each([this, &result](uint32_t id) {
+            result.push_back(records[id]);
+        });
+    }
+
+    sort_algorithms::multikey_sort_by_surname_and_name(result);
+
+    return result;
+}
+
+std::vector<std::string> DatabaseBitmap::get_groups_by_surname(const std::string& surname) const {
+    std::vector<const std::string*> groups;
+    view_groups_by_surname(surname, groups);
+
+    std::vector<std::string> result;
+    result.reserve(groups.size());
+
+    for (const std::string* group : groups) {
+        result.push_back(*group);
+    }
+
+    return result;
+}
+
+std::vector<std::string> DatabaseBitmap::get_groups_by_surname_intersect(const std::string& surname) const {
+    std::vector<std::string> result;
+    auto it = surname_index.find(surname);
+
+    if (it == surname_index.end()) {
+        return result;
+    }
+
+    group_index.for_each([&](GroupCode, const GroupBitmap& group) {
+        if (indexing::RoaringBitmap::intersects(group.ids, it->second)) {
+            result.push_back(group.name);
+        }
+    });
+
+    std::sort(result.begin(), result.end());
+
+    return result;
+}
+
+void DatabaseBitmap::view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const {
+    out.clear();
+
+    if (const GroupBitmap* bucket = group_index.find(group)) {
+        bucket->ids.for_each([this, &out](uint32_t id) {
+            out.push_back(&records[id]);
+        });
+    }
+
+    sort_algorithms::multikey_sort_by_surname_and_name(out);
+}
+
+void DatabaseBitmap::view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const {
+    out.clear();
+
+    auto it = surname_index.find(surname);
+
+    if (it == surname_index.end()) {
+        return;
+    }
+
+    const indexing::RoaringBitmap& ids = it->second;
+
+    if (ids.cardinality() < WALK_FACTOR * group_index.size()) {
+        // Resolve each id to its group's bitmap entry (code probe, no string compares), dedupe by address
+        std::vector<const GroupBitmap*> hits;
+        hits.reserve(ids.cardinality());
+
+        ids.for_each([this, &hits](uint32_t id) {
+            hits.push_back(group_index.find(records[id].m_group));
+        });
+
+        std::sort(hits.begin(), hits.end());
+        hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+
+        for (const GroupBitmap* group : hits) {
+            out.push_back(&group->name);
+        }
+    } else {
+        group_index.for_each([&](GroupCode, const GroupBitmap& group) {
+            if (indexing::RoaringBitmap::intersects(group.ids, ids)) {
+                out.push_back(&group.name);
+            }
+        });
+    }
+
+    sort_unique_groups(out);
+}
+
+void DatabaseBitmap::for_each_student(const std::function<void(const Student&)>& visitor) const {
+    live.for_each([this, &visitor](uint32_t id) {
+        visitor(records[id]);
+    });
+}
+
+indexing::RoaringBitmap DatabaseBitmap::evaluate(const Query& query) const {
+    indexing::RoaringBitmap result = query.groups.empty() ? live : union_of_groups(query.groups);
+
+    if (!query.surnames.empty()) {
+        result = indexing::RoaringBitmap::intersect(result, union_of_surnames(query.surnames));
+    }
+
+    if (!query.exclude_groups.empty()) {
+        result = indexing::RoaringBitmap::subtract(result, union_of_groups(query.exclude_groups));
+    }
+
+    return result;
+}
+
+std::vector<Student> DatabaseBitmap::get_students(const Query& query) const {
+    indexing::RoaringBitmap ids = evaluate(query);
+
+    std::vector<Student> result;
+    result.reserve(ids.cardinality());
+
+    ids.for_each([this, &result](uint32_t id) {
+        result.push_back(records[id]);
+    });
+
+    sort_algorithms::multikey_sort_by_surname_and_name(result);
+
+    return result;
+}
+
+size_t DatabaseBitmap::count_students(const Query& query) const {
+    if (query.exclude_groups.empty() && !query.groups.empty() && !query.surnames.empty()) {
+        return indexing::RoaringBitmap::intersect_cardinality(union_of_groups(query.groups),
+                                                              union_of_surnames(query.surnames));
+    }
+
+    return evaluate(query).cardinality();
+}
+
+size_t DatabaseBitmap::estimate_memory_usage() const {
+    size_t memory = sizeof(DatabaseBitmap);
+
+    memory += records.capacity() * sizeof(Student);
+    for (const auto& student : records) {
+        memory += student.m_name.capacity();
+        memory += student.m_surname.capacity();
+        memory += student.m_email.capacity();
+        memory += student.m_group.capacity();
+        memory += student.m_phone_number.capacity();
+    }
+
+    memory += free_ids.capacity() * sizeof(uint32_t);
+    memory += live.estimate_memory_usage();
+
+    // Phone index (hash nodes: key + id + next pointer)
+    memory += phone_index.bucket_count() * sizeof(void*);
+    for (const auto& pair : phone_index) {
+        memory += sizeof(std::string) + sizeof(uint32_t) + sizeof(size_t) + sizeof(void*) + pair.first.capacity();
+    }
+
+    // Group index (code table + one bitmap per group)
+    memory += group_index.estimate_memory_usage();
+    group_index.for_each([&memory](GroupCode, const GroupBitmap& group) {
+        memory += group.name.capacity() + group.ids.estimate_memory_usage() - sizeof(indexing::RoaringBitmap);
+    });
+
+    // Surname index (hash nodes + one bitmap per surname)
+    memory += surname_index.bucket_count() * sizeof(void*);
+    for (const auto& pair : surname_index) {
+        memory += sizeof(std::string) + sizeof(size_t) + sizeof(void*) + pair.first.capacity();
+        memory += pair.second.estimate_memory_usage();
+    }
+
+    return memory;
+}
+
+std::string DatabaseBitmap::get_container_name() const {
+    return "Bitmap (vector + roaring group/surname bitmaps)";
+}
@@ -0,0 +1,334 @@
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "database_cached.hpp"
+
+DatabaseCached::DatabaseCached(std::unique_ptr<IStudentDatabase> inner_db,
+                               size_t max_cached_groups,
+                               size_t max_cached_students)
+    : inner(std::move(inner_db)), max_entries(max_cached_groups), max_students(max_cached_students) {
+    rebuild_phone_index();
+}
+
+uint64_t DatabaseCached::group_version(const std::string& group) const {
+    auto it = group_versions.find(group);
+    return it != group_versions.end() ? it->second : 0;
+}
+
+void DatabaseCached::invalidate_group(const std::string& group) {
+    ++group_versions[group];
+    ++stats.invalidations;
+}
+
+void DatabaseCached::erase_entry(std::unordered_map<std::string, std::list<CacheEntry>::iterator>::iterator it) const {
+    cached_students -= it->second->roster->size();
+    lru.erase(it->second);
+    entries.erase(it);
+}
+
+DatabaseCached::Roster DatabaseCached::lookup_roster(const std::string& group) const {
+    auto it = entries.find(group);
+
+    if (it != entries.end()) {
+        if (it->second->version == group_version(group)) {
+            ++stats.hits;
+            lru.splice(lru.begin(), lru, it->second);
+            return it->second->roster;
+        }
+
+        erase_entry(it);
+    }
+
+    ++stats.misses;
+
+    return nullptr;
+}
+
+DatabaseCached::Roster DatabaseCached::insert_entry(const std::string& group, uint64_t version,
+                                                   std::vector<Student> roster) const {
+    if (max_entries == 0 || roster.size() > max_students) {
+        return nullptr;
+    }
+
+    auto existing = entries.find(group);
+    if (existing != entries.end()) {
+        erase_entry(existing);
+    }
+
+    cached_students += roster.size();
+    lru.push_front({group, version, std::make_shared<const std::vector<Student>>(std::move(roster))});
+    entries[group] = lru.begin();
+
+    while (entries.size() > max_entries || cached_students > max_students) {
+        erase_entry(entries.find(lru.back().group));
+        ++stats.evictions;
+    }
+
+    return lru.front().roster;
+}
+
+void DatabaseCached::rebuild_phone_index() {
+    lru.clear();
+    entries.clear();
+    viewed_roster.reset();
+    cached_students = 0;
+    group_versions.clear();
+    phone_to_group.clear();
+
+    for (const auto& student : inner->to_vector()) {
+        phone_to_group[student.m_phone_number] = student.m_group;
+    }
+}
+
+bool DatabaseCached::load_from_file(const std::string& filename) {
+    bool loaded = inner->load_from_file(filename);
+    rebuild_phone_index();
+
+    return loaded;
+}
+
+bool DatabaseCached::save_to_file(const std::string& filename) const {
+    return inner->save_to_file(filename);
+}
+
+void DatabaseCached::add(const Student& student) {
+    auto it = phone_to_group.find(student.m_phone_number);
+
+    if (it != phone_to_group.end()) {
+        invalidate_group(it->second);
+    }
+
+    inner->add(student);
+
+    invalidate_group(student.m_group);
+    phone_to_group[student.m_phone_number] = student.m_group;
+}
+
+bool DatabaseCached::remove_by_phone(const std::string& phone_number) {
+    if (!inner->remove_by_phone(phone_number)) {
+        return false;
+    }
+
+    auto it = phone_to_group.find(phone_number);
+
+    if (it != phone_to_group.end()) {
+        invalidate_group(it->second);
+        phone_to_group.erase(it);
+    }
+
+    return true;
+}
+
+size_t DatabaseCached::size() const {
+    return inner->size();
+}
+
+bool DatabaseCached::empty() const {
+    return inner->empty();
+}
+
+void DatabaseCached::clear() {
+    inner->clear();
+    rebuild_phone_index();
+}
+
+std::vector<Student> DatabaseCached::to_vector() const {
+    return inner->to_vector();
+}
+
+bool DatabaseCached::change_group_by_phone(const std::string& phone_number, const std::string& new_group) {
+    if (!inner->change_group_by_phone(phone_number, new_group)) {
+        return false;
+    }
+
+    std::string& group = phone_to_group[phone_number];
+
+    if (group != new_group) {
+        invalidate_group(group);
+        invalidate_group(new_group);
+        group = new_group;
+    }
+
+    return true;
+}
+
+std::vector<Student> DatabaseCached::get_students_by_group_sorted(const std::string& group) const {
+    Roster cached = lookup_roster(group);
+
+    if (cached) {
+        return *cached;
+    }
+
+    std::vector<Student> roster = inner->get_students_by_group_sorted(group);
+    insert_entry(group, group_version(group), roster);
+
+    return roster;
+}
+
+std::vector<std::string> DatabaseCached::get_groups_by_surname(const std::string& surname) const {
+    return inner->get_groups_by_surname(surname);
+}
+
+void DatabaseCached::view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const {
+    Roster roster = lookup_roster(group);
+
+    if (!roster) {
+        roster = insert_entry(group, group_version(group), inner->get_students_by_group_sorted(group));
+    }
+
+    // Keeps the roster behind this view alive even if a later miss evicts its entry
+    viewed_roster = roster;
+
+    if (!roster) {
+        inner->view_students_by_group_sorted(group, out);
+        return;
+    }
+
+    out.clear();
+
+    for (const auto& student : *roster) {
+        out.push_back(&student);
+    }
+}
+
+void DatabaseCached::view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const {
+    inner->view_groups_by_surname(surname, out);
+}
+
+void DatabaseCached::for_each_student(const std::function<void(const Student&)>& visitor) const {
+    inner->for_each_student(visitor);
+}
+
+size_t DatabaseCached::change_group_batch(const std::vector<std::pair<std::string, std::string>>& changes) {
+    size_t changed = inner->change_group_batch(changes);
+
+    for (const auto& change : changes) {
+        auto it = phone_to_group.find(change.first);
+
+        if (it != phone_to_group.end() && it->second != change.second) {
+            invalidate_group(it->second);
+            invalidate_group(change.second);
+            it->second = change.second;
+        }
+    }
+
+    return changed;
+}
+
+std::vector<std::vector<std::string>> DatabaseCached::get_groups_by_surnames(const std::vector<std::string>& surnames) const {
+    return inner->get_groups_by_surnames(surnames);
+}
+
+std::vector<Student> DatabaseCached::get_students_by_surname_prefix(const std::string& prefix, size_t limit) const {
+    return inner->get_students_by_surname_prefix(prefix, limit);
+}
+
+std::vector<Student> DatabaseCached::get_students_by_rating_range(float min_rating, float max_rating) const {
+    return inner->get_students_by_rating_range(min_rating, max_rating);
+}
+
+std::vector<Student> DatabaseCached::get_students_by_birth_range(int from_date, int to_date) const {
+    return inner->get_students_by_birth_range(from_date, to_date);
+}
+
+std::vector<Student> DatabaseCached::top_k_by_rating(const std::string& group, size_t k) const {
+    return inner->top_k_by_rating(group, k);
+}
+
+std::map<std::string, std::vector<Student>> DatabaseCached::top_k_by_rating_per_group(size_t k) const {
+    return inner->top_k_by_rating_per_group(k);
+}
+
+std::vector<std::vector<Student>> DatabaseCached::get_students_by_groups_sorted(const std::vector<std::string>& groups) const {
+    std::vector<std::vector<Student>> result(groups.size());
+    std::vector<std::string> missing;
+    std::vector<size_t> missing_positions;
+
+    for (size_t i = 0; i < groups.size(); ++i) {
+        Roster cached = lookup_roster(groups[i]);
+
+        if (cached) {
+            result[i] = *cached;
+        } else {
+            missing.push_back(groups[i]);
+            missing_positions.push_back(i);
+        }
+    }
+
+    if (missing.empty()) {
+        return result;
+    }
+
+    // All misses go to the wrapped database as one batch
+    std::vector<std::vector<Student>> fetched = inner->get_students_by_groups_sorted(missing);
+
+    for (size_t j = 0; j < missing.size(); ++j) {
+        insert_entry(missing[j], group_version(missing[j]), fetched[j]);
+        result[missing_positions[j]] = std::move(fetched[j]);
+    }
+
+    return result;
+}
+
+std::unique_ptr<IStudentDatabase> DatabaseCached::snapshot() const {
+    return std::make_unique<DatabaseCached>(inner->snapshot(), max_entries, max_students);
+}
+
+bool DatabaseCached::sort_by_rating_and_save(
+    const std::string& filename,
+    std::function<void(std::vector<Student>&, std::function<bool(const Student&, const Student&)>)> sort_func,
+    bool ascending) {
+
+    return inner->sort_by_rating_and_save(filename, sort_func, ascending);
+}
+
+bool DatabaseCached::sort_by_rating_keyed_and_save(const std::string& filename, bool ascending,
+                                                   sort_algorithms::Algorithm algorithm, size_t thread_count) {
+    return inner->sort_by_rating_keyed_and_save(filename, ascending, algorithm, thread_count);
+}
+
+size_t DatabaseCached::estimate_memory_usage() const {
+    size_t memory = sizeof(DatabaseCached) + inner->estimate_memory_usage();
+
+    // Phone -> group map
+    memory += phone_to_group.bucket_count() * sizeof(void*);
+    memory += phone_to_group.size() * (sizeof(std::string) * 2 + sizeof(size_t) + sizeof(void*));
+    for (const auto& pair : phone_to_group) {
+        memory += pair.first.capacity();
+        memory += pair.second.capacity();
+    }
+
+    // Version counters
+    memory += group_versions.bucket_count() * sizeof(void*);
+    memory += group_versions.size() * (sizeof(std::string) + sizeof(uint64_t) + sizeof(size_t) + sizeof(void*));
+
+    // Cached rosters (list node + lookup entry + copied Students)
+    for (const auto& entry : lru) {
+        memory += sizeof(CacheEntry) + sizeof(void*) * 2;
+        memory += sizeof(std::string) + sizeof(void*) * 3;
+        memory += entry.roster->capacity() * sizeof(Student);
+
+        for (const auto& student : *entry.roster) {
+            memory += student.m_name.capacity();
+            memory += student.m_surname.capacity();
+            memory += student.m_email.capacity();
+            memory += student.m_group.capacity();
+            memory += student.m_phone_number.capacity();
+        }
+    }
+
+    return memory;
+}
+
+std::string DatabaseCached::get_container_name() const {
+    return "Cached " + inner->get_container_name();
+}
+
+DatabaseCached::CacheStats DatabaseCached::cache_stats() const {
+    return stats;
+}
+
+void DatabaseCached::reset_cache_stats() {
+    stats = CacheStats();
+}
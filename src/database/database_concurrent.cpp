@@ -0,0 +1,546 @@
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <iostream>
+#include <vector>
+
+#include "database_concurrent.hpp"
+#include "csv_handler.hpp"
+#include "epoch.hpp"
+#include "sorting.hpp"
+
+DatabaseConcurrent::DatabaseConcurrent() : current(build_version({})) {}
+
+DatabaseConcurrent::DatabaseConcurrent(const std::vector<Student>& initial_data)
+    : current(build_version(initial_data)) {}
+
+DatabaseConcurrent::DatabaseConcurrent(const Version* version) : current(version) {}
+
+DatabaseConcurrent::~DatabaseConcurrent() {
+    delete current.load();
+
+    for (const auto& entry : retired) {
+        delete entry.second;
+    }
+}
+
+size_t DatabaseConcurrent::shard_of(const std::string& key) {
+    return std::hash<std::string>{}(key) % SHARD_COUNT;
+}
+
+const DatabaseConcurrent::Bucket* DatabaseConcurrent::find_bucket(const IndexShards& shards,
+                                                                  const std::string& key) {
+    const IndexShard& shard = *shards[shard_of(key)];
+    auto it = shard.find(key);
+
+    return it != shard.end() ? it->second.get() : nullptr;
+}
+
+void DatabaseConcurrent::bucket_insert(IndexShards& shards, const std::string& key, const Record& record) {
+    IndexShard& shard = make_mutable(shards[shard_of(key)]);
+    auto& bucket = shard[key];
+
+    if (!bucket) {
+        bucket = std::make_shared<const Bucket>();
+    }
+
+    make_mutable(bucket).push_back(record);
+}
+
+void DatabaseConcurrent::bucket_erase(IndexShards& shards, const std::string& key, const std::string& phone) {
+    auto& slot = shards[shard_of(key)];
+
+    if (slot->find(key) == slot->end()) {
+        return;
+    }
+
+    IndexShard& shard = make_mutable(slot);
+    auto it = shard.find(key);
+    Bucket& bucket = make_mutable(it->second);
+
+    bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+    [&phone](const Record& record) {
+        return record->m_phone_number == phone;
+    }), bucket.end());
+
+    if (bucket.empty()) {
+        shard.erase(it);
+    }
+}
+
+void DatabaseConcurrent::bucket_replace(IndexShards& shards, const std::string& key, const Record& record) {
+    auto& slot = shards[shard_of(key)];
+
+    if (slot->find(key) == slot->end()) {
+        return;
+    }
+
+    IndexShard& shard = make_mutable(slot);
+
+    for (auto& entry : make_mutable(shard.find(key)->second)) {
+        if (entry->m_phone_number == record->m_phone_number) {
+            entry = record;
+        }
+    }
+}
+
+const DatabaseConcurrent::Version* DatabaseConcurrent::build_version(const std::vector<Student>& students) {
+    std::array<PhoneShard, SHARD_COUNT> phones;
+    std::array<std::unordered_map<std::string, Bucket>, SHARD_COUNT> groups, surnames;
+
+    for (const auto& student : students) {
+        phones[shard_of(student.m_phone_number)][student.m_phone_number] = std::make_shared<const Student>(student);
+    }
+
+    auto* version = new Version();
+
+    for (size_t i = 0; i < SHARD_COUNT; ++i) {
+        for (const auto& pair : phones[i]) {
+            const Record& record = pair.second;
+            groups[shard_of(record->m_group)][record->m_group].push_back(record);
+            surnames[shard_of(record->m_surname)][record->m_surname].push_back(record);
+        }
+
+        version->size += phones[i].size();
+        version->phones[i] = std::make_shared<const PhoneShard>(std::move(phones[i]));
+    }
+
+    for (size_t i = 0; i < SHARD_COUNT; ++i) {
+        IndexShard group_shard, surname_shard;
+
+        for (auto& pair : groups[i]) {
+            group_shard.emplace(pair.first, std::make_shared<const Bucket>(std::move(pair.second)));
+        }
+
+        for (auto& pair : surnames[i]) {
+            surname_shard.emplace(pair.first, std::make_shared<const Bucket>(std::move(pair.second)));
+        }
+
+        version->groups[i] = std::make_shared<const IndexShard>(std::move(group_shard));
+        version->surnames[i] = std::make_shared<const IndexShard>(std::move(surname_shard));
+    }
+
+    return version;
+}
+
+void DatabaseConcurrent::upsert(Version& next, const Student& student) {
+    Record record = std::make_shared<const Student>(student);
+
+    PhoneShard& phones = make_mutable(next.phones[shard_of(student.m_phone_number)]);
+    auto it = phones.find(student.m_phone_number);
+
+    if (it != phones.end()) {
+        bucket_erase(next.groups, it->second->m_group, student.m_phone_number);
+        bucket_erase(next.surnames, it->second->m_surname, student.m_phone_number);
+        it->second = record;
+    } else {
+        phones.emplace(student.m_phone_number, record);
+        ++next.size;
+    }
+
+    bucket_insert(next.groups, student.m_group, record);
+    bucket_insert(next.surnames, student.m_surname, record);
+}
+
+void DatabaseConcurrent::publish(const Version* next) {
+    // next is still private to this writer
+    const_cast<Version*>(next)->sequence = current.load()->sequence + 1;
+
+    const Version* old = current.exchange(next, std::memory_order_seq_cst);
+
+    retired.emplace_back(epoch::advance(), old);
+
+    reclaim();
+}
+
+void DatabaseConcurrent::reclaim() {
+    uint64_t oldest = epoch::min_active();
+
+    auto keep = std::remove_if(retired.begin(), retired.end(),
+    [oldest](const std::pair<uint64_t, const Version*>& entry) {
+        if (entry.first <= oldest) {
+            delete entry.second;
+            return true;
+        }
+
+        return false;
+    });
+
+    retired.erase(keep, retired.end());
+}
+
+std::shared_ptr<const DatabaseConcurrent::Version> DatabaseConcurrent::pin_current() const {
+    // Like fork(): the copied root keeps every shard, bucket and record of the Version alive
+    // after it is retired, and writers see the pinned nodes as shared and copy them
+    epoch::ReadGuard guard;
+    return std::make_shared<const Version>(*current.load());
+}
+
+const DatabaseConcurrent::Version& DatabaseConcurrent::view_version(ViewSlot slot) const {
+    struct ThreadPins {
+        std::weak_ptr<const char> owner;
+        ViewPins pins;
+    };
+
+    // Each thread owns its pins, so readers share no lock and no table; the pins go away with
+    // the thread, and entries of destroyed engines are dropped when the thread pins a new one
+    thread_local std::unordered_map<const char*, ThreadPins> thread_pins;
+
+    auto it = thread_pins.find(pin_owner.get());
+
+    if (it == thread_pins.end() || it->second.owner.expired()) {
+        for (auto entry = thread_pins.begin(); entry != thread_pins.end();) {
+            entry = entry->second.owner.expired() ? thread_pins.erase(entry) : std::next(entry);
+        }
+
+        it = thread_pins.emplace(pin_owner.get(), ThreadPins{pin_owner, {}}).first;
+    }
+
+    std::shared_ptr<const Version>& pin = it->second.pins[slot];
+
+    bool stale;
+    {
+        epoch::ReadGuard guard;
+        stale = !pin || pin->sequence != current.load()->sequence;
+    }
+
+    if (stale) {
+        pin = pin_current();
+    }
+
+    return *pin;
+}
+
+bool DatabaseConcurrent::load_from_file(const std::string& filename) {
+    std::vector<Student> temp = csv::read_csv(filename);
+
+    std::lock_guard<std::mutex> lock(write_mutex);
+    publish(build_version(temp));
+
+    return !temp.empty();
+}
+
+void DatabaseConcurrent::add(const Student& student) {
+    std::lock_guard<std::mutex> lock(write_mutex);
+
+    auto* next = new Version(*current.load());
+    upsert(*next, student);
+
+    publish(next);
+}
+
+bool DatabaseConcurrent::remove_by_phone(const std::string& phone_number) {
+    std::lock_guard<std::mutex> lock(write_mutex);
+
+    const Version* cur = current.load();
+    const PhoneShard& shard = *cur->phones[shard_of(phone_number)];
+    auto it = shard.find(phone_number);
+
+    if (it == shard.end()) {
+        return false;
+    }
+
+    Record old = it->second;
+    auto* next = new Version(*cur);
+
+    make_mutable(next->phones[shard_of(phone_number)]).erase(phone_number);
+    --next->size;
+
+    bucket_erase(next->groups, old->m_group, phone_number);
+    bucket_erase(next->surnames, old->m_surname, phone_number);
+
+    publish(next);
+
+    return true;
+}
+
+size_t DatabaseConcurrent::size() const {
+    epoch::ReadGuard guard;
+    return current.load()->size;
+}
+
+bool DatabaseConcurrent::empty() const {
+    return size() == 0;
+}
+
+void DatabaseConcurrent::clear() {
+    std::lock_guard<std::mutex> lock(write_mutex);
+    publish(build_version({}));
+}
+
+std::vector<Student> DatabaseConcurrent::to_vector() const {
+    epoch::ReadGuard guard;
+    const Version* version = current.load();
+
+    std::vector<Student> result;
+    result.reserve(version->size);
+
+    for (const auto& shard : version->phones) {
+        for (const auto& pair : *shard) {
+            result.push_back(*pair.second);
+        }
+    }
+
+    return result;
+}
+
+bool DatabaseConcurrent::apply_group_change(Version& next, const std::string& phone_number,
+                                            const std::string& new_group) {
+    auto& slot = next.phones[shard_of(phone_number)];
+    auto found = slot->find(phone_number);
+
+    if (found == slot->end()) {
+        return false;
+    }
+
+    Record old = found->second;
+
+    // Unknown phones and no-op changes leave a shared shard shared
+    if (old->m_group == new_group) {
+        return true;
+    }
+
+    PhoneShard& phones = make_mutable(slot);
+    auto it = phones.find(phone_number);
+
+    auto updated = std::make_shared<Student>(*old);
+    updated->m_group = new_group;
+    it->second = std::move(updated);
+
+    bucket_erase(next.groups, old->m_group, phone_number);
+    bucket_insert(next.groups, new_group, it->second);
+    bucket_replace(next.surnames, old->m_surname, it->second);
+
+    return true;
+}
+
+bool DatabaseConcurrent::change_group_by_phone(const std::string& phone_number, const std::string& new_group) {
+    std::lock_guard<std::mutex> lock(write_mutex);
+
+    const Version* cur = current.load();
+    const PhoneShard& shard = *cur->phones[shard_of(phone_number)];
+    auto it = shard.find(phone_number);
+
+    if (it == shard.end()) {
+        return false;
+    }
+
+    if (it->second->m_group == new_group) {
+        return true;
+    }
+
+    auto* next = new Version(*cur);
+    apply_group_change(*next, phone_number, new_group);
+
+    publish(next);
+
+    return true;
+}
+
+size_t DatabaseConcurrent::change_group_batch(const std::vector<std::pair<std::string, std::string>>& changes) {
+    std::lock_guard<std::mutex> lock(write_mutex);
+
+    // The whole batch becomes visible atomically as one Version; shards and buckets
+    // copied by an earlier change of the batch are reused in place by later ones
+    auto* next = new Version(*current.load());
+    size_t changed = 0;
+
+    for (const auto& change : changes) {
+        if (apply_group_change(*next, change.first, change.second)) {
+            ++changed;
+        }
+    }
+
+    if (changed == 0) {
+        delete next;
+        return 0;
+    }
+
+    publish(next);
+
+    return changed;
+}
+
+std::vector<Student> DatabaseConcurrent::get_students_by_group_sorted(const std::string& group) const {
+    std::vector<Student> result;
+
+    {
+        epoch::ReadGuard guard;
+        const Bucket* bucket = find_bucket(current.load()->groups, group);
+
+        if (bucket) {
+            result.reserve(bucket->size());
+
+            for (const auto& record : *bucket) {
+                result.push_back(*record);
+            }
+        }
+    }
+
+    sort_algorithms::multikey_sort_by_surname_and_name(result);
+
+    return result;
+}
+
+std::vector<std::string> DatabaseConcurrent::get_groups_by_surname(const std::string& surname) const {
+    std::set<std::string> unique_groups;
+
+    {
+        epoch::ReadGuard guard;
+        const Bucket* bucket = find_bucket(current.load()->surnames, surname);
+
+        if (bucket) {
+            for (const auto& record : *bucket) {
+                unique_groups.insert(record->m_group);
+            }
+        }
+    }
+
+    return std::vector<std::string>(unique_groups.begin(), unique_groups.end());
+}
+
+void DatabaseConcurrent::view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const {
+    out.clear();
+
+    const Bucket* bucket = find_bucket(view_version(StudentsView).groups, group);
+
+    if (bucket) {
+        for (const auto& record : *bucket) {
+            out.push_back(record.get());
+        }
+    }
+
+    sort_algorithms::multikey_sort_by_surname_and_name(out);
+}
+
+void DatabaseConcurrent::view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const {
+    out.clear();
+
+    const Bucket* bucket = find_bucket(view_version(GroupsView).surnames, surname);
+
+    if (bucket) {
+        for (const auto& record : *bucket) {
+            out.push_back(&record->m_group);
+        }
+    }
+
+    sort_unique_groups(out);
+}
+
+void DatabaseConcurrent::for_each_student(const std::function<void(const Student&)>& visitor) const {
+    // Visit outside the epoch guard, so the visitor may call back into this engine
+    std::shared_ptr<const Version> version = pin_current();
+
+    for (const auto& shard : version->phones) {
+        for (const auto& pair : *shard) {
+            visitor(*pair.second);
+        }
+    }
+}
+
+size_t DatabaseConcurrent::estimate_memory_usage() const {
+    epoch::ReadGuard guard;
+    const Version* version = current.load();
+
+    size_t memory = sizeof(DatabaseConcurrent) + sizeof(Version);
+
+    // Shared control block + Student per record
+    size_t record_overhead = sizeof(Student) + sizeof(long) * 2 + sizeof(void*);
+
+    for (const auto& shard : version->phones) {
+        memory += shard->bucket_count() * sizeof(void*);
+        memory += shard->size() * (sizeof(std::string) + sizeof(Record) + sizeof(size_t) + sizeof(void*));
+
+        for (const auto& pair : *shard) {
+            memory += record_overhead;
+            memory += pair.first.capacity();
+            memory += pair.second->m_name.capacity();
+            memory += pair.second->m_surname.capacity();
+            memory += pair.second->m_email.capacity();
+            memory += pair.second->m_group.capacity();
+            memory += pair.second->m_phone_number.capacity();
+        }
+    }
+
+    for (const IndexShards* index : {&version->groups, &version->surnames}) {
+        for (const auto& shard : *index) {
+            memory += shard->bucket_count() * sizeof(void*);
+            memory += shard->size() * (sizeof(std::string) + sizeof(Record) + sizeof(Bucket) + sizeof(size_t) + sizeof(void*));
+
+            for (const auto& pair : *shard) {
+                memory += pair.first.capacity();
+                memory += pair.second->capacity() * sizeof(Record);
+            }
+        }
+    }
+
+    return memory;
+}
+
+std::string DatabaseConcurrent::get_container_name() const {
+    return "Concurrent (RCU sharded hash indices)";
+}
+
+std::unique_ptr<IStudentDatabase> DatabaseConcurrent::snapshot() const {
+    return fork();
+}
+
+std::unique_ptr<DatabaseConcurrent> DatabaseConcurrent::fork() const {
+    // Copying the root bumps the shard reference counts, so make_mutable on either engine
+    // sees every shared node as shared and copies it before writing
+    epoch::ReadGuard guard;
+    return std::unique_ptr<DatabaseConcurrent>(new DatabaseConcurrent(new Version(*current.load())));
+}
+
+bool DatabaseConcurrent::verify_consistency() const {
+    epoch::ReadGuard guard;
+    const Version* version = current.load();
+
+    auto contains = [](const Bucket* bucket, const Student* record) {
+        return bucket && std::any_of(bucket->begin(), bucket->end(),
+        [record](const Record& entry) {
+            return entry.get() == record;
+        });
+    };
+
+    size_t phone_count = 0;
+
+    for (const auto& shard : version->phones) {
+        for (const auto& pair : *shard) {
+            const Student* record = pair.second.get();
+
+            if (record->m_phone_number != pair.first
+                || !contains(find_bucket(version->groups, record->m_group), record)
+                || !contains(find_bucket(version->surnames, record->m_surname), record)) {
+                return false;
+            }
+
+            ++phone_count;
+        }
+    }
+
+    size_t group_count = 0;
+    size_t surname_count = 0;
+
+    for (const auto& shard : version->groups) {
+        for (const auto& pair : *shard) {
+            for (const auto& record : *pair.second) {
+                if (record->m_group != pair.first) {
+                    return false;
+                }
+            }
+
+            group_count += pair.second->size();
+        }
+    }
+
+    for (const auto& shard : version->surnames) {
+        for (const auto& pair : *shard) {
+            surname_count += pair.second->size();
+        }
+    }
+
+    return phone_count == version->size
+        && group_count == version->size
+        && surname_count == version->size;
+}
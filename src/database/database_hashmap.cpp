@@ -5,6 +5,7 @@
 
 #include "database_hashmap.hpp"
 #include "csv_handler.hpp"
+#include "sorting.hpp"
 
 DatabaseHashMap::DatabaseHashMap() : data() {}
 
@@ -25,10 +26,6 @@ bool DatabaseHashMap::load_from_file(const std::string& filename) {
     return !data.empty();
 }
 
-bool DatabaseHashMap::save_to_file(const std::string& filename) const {
-    return csv::write_csv(filename, to_vector());
-}
-
 void DatabaseHashMap::add(const Student& student) {
     data[student.m_phone_number] = student;
 }
@@ -87,8 +84,7 @@ std::vector<Student> DatabaseHashMap::get_students_by_group_sorted(const std::st
         }
     }
     
-    std::sort(result.begin(), result.end(), 
-              student_comparators::compare_by_surname_and_name);
+    sort_algorithms::multikey_sort_by_surname_and_name(result);
     
     return result;
 }
@@ -105,19 +101,42 @@ std::vector<std::string> DatabaseHashMap::get_groups_by_surname(const std::strin
     return std::vector<std::string>(unique_groups.begin(), unique_groups.end());
 }
 
-bool DatabaseHashMap::sort_by_rating_and_save(
-    const std::string& filename,
-    std::function<void(std::vector<Student>&, std::function<bool(const Student&, const Student&)>)> sort_func,
-    bool ascending) {
-    
-    std::vector<Student> sorted_data = to_vector();
-    
-    auto comparator = ascending ? student_comparators::compare_by_rating 
-                                : student_comparators::compare_by_rating_desc;
-    
-    sort_func(sorted_data, comparator);
-    
-    return csv::write_csv(filename, sorted_data);
+void DatabaseHashMap::view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const {
+    out.clear();
+
+    for (const auto& pair : data) {
+        if (pair.second.m_group == group) {
+            out.push_back(&pair.second);
+        }
+    }
+
+    sort_algorithms::multikey_sort_by_surname_and_name(out);
+}
+
+void DatabaseHashMap::view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const {
+    out.clear();
+
+    for (const auto& pair : data) {
+        if (pair.second.m_surname == surname) {
+            out.push_back(&pair.second.m_group);
+        }
+    }
+
+    sort_unique_groups(out);
+}
+
+void DatabaseHashMap::for_each_student(const std::function<void(const Student&)>& visitor) const {
+    for (const auto& pair : data) {
+        visitor(pair.second);
+    }
+}
+
+std::vector<std::vector<std::string>> DatabaseHashMap::get_groups_by_surnames(const std::vector<std::string>& surnames) const {
+    return scan_groups_by_surnames(surnames);
+}
+
+std::vector<std::vector<Student>> DatabaseHashMap::get_students_by_groups_sorted(const std::vector<std::string>& groups) const {
+    return scan_students_by_groups_sorted(groups);
 }
 
 size_t DatabaseHashMap::estimate_memory_usage() const {
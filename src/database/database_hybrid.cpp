@@ -5,29 +5,68 @@
 
 #include "database_hybrid.hpp"
 #include "csv_handler.hpp"
+#include "sorting.hpp"
+
+namespace {
+    // Swap-and-pop: group order is restored by sorting on every query
+    void erase_handle(std::vector<const Student*>* bucket, const Student* student) {
+        if (!bucket) {
+            return;
+        }
+
+        auto it = std::find(bucket->begin(), bucket->end(), student);
+
+        if (it != bucket->end()) {
+            *it = bucket->back();
+            bucket->pop_back();
+        }
+    }
+}
 
 DatabaseHybrid::DatabaseHybrid() : primary_data(), group_index(), surname_index() {}
 
 DatabaseHybrid::DatabaseHybrid(const std::vector<Student>& initial_data) {
-    for (const auto& student : initial_data) {
-        add(student);
+    bulk_load(initial_data);
+}
+
+void DatabaseHybrid::bulk_load(const std::vector<Student>& students) {
+    primary_data.reserve(students.size());
+
+    for (const auto& student : students) {
+        primary_data.insert_or_assign(student.m_phone_number, student);
+    }
+
+    for (const auto& pair : primary_data) {
+        group_index[pair.second.m_group].push_back(&pair.second);
+    }
+
+    // (surname, phone) handles into primary_data: sorted once, strings copied once into the tree
+    using KeyHandle = std::pair<const std::string*, const std::string*>;
+    auto by_key = [](const KeyHandle& a, const KeyHandle& b) {
+        return *a.first < *b.first;
+    };
+
+    std::vector<KeyHandle> handles;
+    handles.reserve(primary_data.size());
+
+    for (const auto& pair : primary_data) {
+        handles.emplace_back(&pair.second.m_surname, &pair.first);
+    }
+
+    std::sort(handles.begin(), handles.end(), by_key);
+
+    for (const auto& handle : handles) {
+        surname_index.emplace_hint(surname_index.end(), *handle.first, *handle.second);
     }
 }
 
 void DatabaseHybrid::add_to_indices(const Student& student) {
-    group_index.insert({student.m_group, student.m_phone_number});
+    group_index[student.m_group].push_back(&student);
     surname_index.insert({student.m_surname, student.m_phone_number});
 }
 
 void DatabaseHybrid::remove_from_indices(const Student& student) {
-    auto group_range = group_index.equal_range(student.m_group);
-    for (auto it = group_range.first; it != group_range.second; ) {
-        if (it->second == student.m_phone_number) {
-            it = group_index.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    erase_handle(group_index.find(student.m_group), &student);
     
     auto surname_range = surname_index.equal_range(student.m_surname);
     for (auto it = surname_range.first; it != surname_range.second; ) {
@@ -39,37 +78,20 @@ void DatabaseHybrid::remove_from_indices(const Student& student) {
     }
 }
 
-void DatabaseHybrid::update_group_index(const std::string& phone, 
-                                         const std::string& old_group, 
-                                         const std::string& new_group) {
-    auto group_range = group_index.equal_range(old_group);
-    for (auto it = group_range.first; it != group_range.second; ) {
-        if (it->second == phone) {
-            it = group_index.erase(it);
-            break;
-        } else {
-            ++it;
-        }
-    }
-    
-    group_index.insert({new_group, phone});
+void DatabaseHybrid::update_group_index(const Student* student, const std::string& old_group) {
+    erase_handle(group_index.find(old_group), student);
+    group_index[student->m_group].push_back(student);
 }
 
 bool DatabaseHybrid::load_from_file(const std::string& filename) {
     std::vector<Student> temp = csv::read_csv(filename);
     clear();
 
-    for (const auto& student : temp) {
-        add(student);
-    }
+    bulk_load(temp);
 
     return !primary_data.empty();
 }
 
-bool DatabaseHybrid::save_to_file(const std::string& filename) const {
-    return csv::write_csv(filename, to_vector());
-}
-
 void DatabaseHybrid::add(const Student& student) {
     auto it = primary_data.find(student.m_phone_number);
     
@@ -77,9 +99,10 @@ void DatabaseHybrid::add(const Student& student) {
         remove_from_indices(it->second);
     }
     
-    primary_data[student.m_phone_number] = student;
+    Student& stored = primary_data[student.m_phone_number];
+    stored = student;
     
-    add_to_indices(student);
+    add_to_indices(stored);
 }
 
 bool DatabaseHybrid::remove_by_phone(const std::string& phone_number) {
@@ -129,7 +152,7 @@ bool DatabaseHybrid::change_group_by_phone(const std::string& phone_number,
         
         it->second.m_group = new_group;
         
-        update_group_index(phone_number, old_group, new_group);
+        update_group_index(&it->second, old_group);
         
         return true;
     }
@@ -140,19 +163,15 @@ bool DatabaseHybrid::change_group_by_phone(const std::string& phone_number,
 std::vector<Student> DatabaseHybrid::get_students_by_group_sorted(const std::string& group) const {
     std::vector<Student> result;
     
-    auto range = group_index.equal_range(group);
-    
-    for (auto it = range.first; it != range.second; ++it) {
-        const std::string& phone = it->second;
-        auto student_it = primary_data.find(phone);
+    if (const auto* bucket = group_index.find(group)) {
+        result.reserve(bucket->size());
         
-        if (student_it != primary_data.end()) {
-            result.push_back(student_it->second);
+        for (const Student* student : *bucket) {
+            result.push_back(*student);
         }
     }
     
-    std::sort(result.begin(), result.end(), 
-              student_comparators::compare_by_surname_and_name);
+    sort_algorithms::multikey_sort_by_surname_and_name(result);
     
     return result;
 }
@@ -174,19 +193,36 @@ std::vector<std::string> DatabaseHybrid::get_groups_by_surname(const std::string
     return std::vector<std::string>(unique_groups.begin(), unique_groups.end());
 }
 
-bool DatabaseHybrid::sort_by_rating_and_save(
-    const std::string& filename,
-    std::function<void(std::vector<Student>&, std::function<bool(const Student&, const Student&)>)> sort_func,
-    bool ascending) {
-    
-    std::vector<Student> sorted_data = to_vector();
-    
-    auto comparator = ascending ? student_comparators::compare_by_rating 
-                                : student_comparators::compare_by_rating_desc;
-    
-    sort_func(sorted_data, comparator);
-    
-    return csv::write_csv(filename, sorted_data);
+void DatabaseHybrid::view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const {
+    out.clear();
+
+    if (const auto* bucket = group_index.find(group)) {
+        out.assign(bucket->begin(), bucket->end());
+    }
+
+    sort_algorithms::multikey_sort_by_surname_and_name(out);
+}
+
+void DatabaseHybrid::view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const {
+    out.clear();
+
+    auto range = surname_index.equal_range(surname);
+
+    for (auto it = range.first; it != range.second; ++it) {
+        auto student_it = primary_data.find(it->second);
+
+        if (student_it != primary_data.end()) {
+            out.push_back(&student_it->second.m_group);
+        }
+    }
+
+    sort_unique_groups(out);
+}
+
+void DatabaseHybrid::for_each_student(const std::function<void(const Student&)>& visitor) const {
+    for (const auto& pair : primary_data) {
+        visitor(pair.second);
+    }
 }
 
 size_t DatabaseHybrid::estimate_memory_usage() const {
@@ -205,12 +241,11 @@ size_t DatabaseHybrid::estimate_memory_usage() const {
         memory += pair.second.m_phone_number.capacity();
     }
     
-    // Group index (multimap overhead: tree nodes + pointers)
-    memory += group_index.size() * (sizeof(std::string) * 2 + sizeof(void*) * 3); // key + value + 3 pointers (parent, left, right)
-    for (const auto& pair : group_index) {
-        memory += pair.first.capacity();  // group name
-        memory += pair.second.capacity(); // phone number
-    }
+    // Group index (code table + one handle vector per group)
+    memory += group_index.estimate_memory_usage();
+    group_index.for_each([&memory](GroupCode, const std::vector<const Student*>& bucket) {
+        memory += bucket.capacity() * sizeof(const Student*);
+    });
     
     // Surname index (multimap overhead: tree nodes + pointers)
     memory += surname_index.size() * (sizeof(std::string) * 2 + sizeof(void*) * 3);
@@ -223,5 +258,5 @@ size_t DatabaseHybrid::estimate_memory_usage() const {
 }
 
 std::string DatabaseHybrid::get_container_name() const {
-    return "Hybrid (unordered_map + 2x multimap indices)";
+    return "Hybrid (unordered_map + group-code table + multimap)";
 }
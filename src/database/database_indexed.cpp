@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <iostream>
+#include <vector>
+
+#include "database_indexed.hpp"
+#include "csv_handler.hpp"
+#include "sorting.hpp"
+
+std::tuple<bool, float, std::string> indexing::rating_key(const Student& student) {
+    bool nan = std::isnan(student.m_rating);
+    return {nan, nan ? 0.0f : student.m_rating, student.m_phone_number};
+}
+
+std::pair<int, std::string> indexing::birth_key(const Student& student) {
+    return {student.get_packed_birth_date(), student.m_phone_number};
+}
+
+std::tuple<std::string, bool, float, std::string> indexing::group_rating_desc(const Student& student) {
+    bool nan = std::isnan(student.m_rating);
+    return {student.m_group, nan, nan ? 0.0f : -student.m_rating, student.m_phone_number};
+}
+
+DatabaseIndexed::DatabaseIndexed() {}
+
+DatabaseIndexed::DatabaseIndexed(const std::vector<Student>& initial_data) {
+    primary_data.reserve(initial_data.size());
+
+    for (const auto& student : initial_data) {
+        add(student);
+    }
+}
+
+bool DatabaseIndexed::load_from_file(const std::string& filename) {
+    std::vector<Student> temp = csv::read_csv(filename);
+    clear();
+
+    primary_data.reserve(temp.size());
+
+    for (const auto& student : temp) {
+        add(student);
+    }
+
+    return !primary_data.empty();
+}
+
+void DatabaseIndexed::add(const Student& student) {
+    auto it = primary_data.find(student.m_phone_number);
+
+    if (it != primary_data.end()) {
+        indices.modify(it->second, [&student](Student& record) { record = student; });
+        return;
+    }
+
+    auto inserted = primary_data.emplace(student.m_phone_number, student);
+    indices.insert(&inserted.first->second);
+}
+
+bool DatabaseIndexed::remove_by_phone(const std::string& phone_number) {
+    auto it = primary_data.find(phone_number);
+
+    if (it != primary_data.end()) {
+        indices.erase(&it->second);
+
+        primary_data.erase(it);
+        return true;
+    }
+
+    return false;
+}
+
+size_t DatabaseIndexed::size() const {
+    return primary_data.size();
+}
+
+bool DatabaseIndexed::empty() const {
+    return primary_data.empty();
+}
+
+void DatabaseIndexed::clear() {
+    indices.clear();
+    primary_data.clear();
+}
+
+std::vector<Student> DatabaseIndexed::to_vector() const {
+    std::vector<Student> result;
+    result.reserve(primary_data.size());
+
+    for (const auto& pair : primary_data) {
+        result.push_back(pair.second);
+    }
+
+    return result;
+}
+
+bool DatabaseIndexed::change_group_by_phone(const std::string& phone_number,
+                                             const std::string& new_group) {
+    auto it = primary_data.find(phone_number);
+
+    if (it != primary_data.end()) {
+        indices.modify(it->second, [&new_group](Student& record) { record.m_group = new_group; });
+        return true;
+    }
+
+    return false;
+}
+
+std::vector<Student> DatabaseIndexed::get_students_by_group_sorted(const std::string& group) const {
+    std::vector<Student> result;
+
+    indices.get<GroupIndex>().for_each_equal(group, [&result](const Student& student) {
+        result.push_back(student);
+    });
+
+    sort_algorithms::multikey_sort_by_surname_and_name(result);
+
+    return result;
+}
+
+std::vector<std::string> DatabaseIndexed::get_groups_by_surname(const std::string& surname) const {
+    std::set<std::string> unique_groups;
+
+    indices.get<SurnameIndex>().for_each_equal(surname, [&unique_groups](const Student& student) {
+        unique_groups.insert(student.m_group);
+    });
+
+    return std::vector<std::string>(unique_groups.begin(), unique_groups.end());
+}
+
+void DatabaseIndexed::view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const {
+    out.clear();
+
+    indices.get<GroupIndex>().for_each_equal(group, [&out](const Student& student) {
+        out.push_back(&student);
+    });
+
+    sort_algorithms::multikey_sort_by_surname_and_name(out);
+}
+
+void DatabaseIndexed::view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const {
+    out.clear();
+
+    indices.get<SurnameIndex>().for_each_equal(surname, [&out](const Student& student) {
+        out.push_back(&student.m_group);
+    });
+
+    sort_unique_groups(out);
+}
+
+void DatabaseIndexed::for_each_student(const std::function<void(const Student&)>& visitor) const {
+    for (const auto& pair : primary_data) {
+        visitor(pair.second);
+    }
+}
+
+std::vector<Student> DatabaseIndexed::get_students_by_surname_prefix(const std::string& prefix, size_t limit) const {
+    std::vector<const Student*> handles;
+    indices.get<SurnameIndex>().collect_prefix(prefix, limit, handles);
+
+    std::vector<Student> result;
+    result.reserve(handles.size());
+
+    for (const Student* student : handles) {
+        result.push_back(*student);
+    }
+
+    return result;
+}
+
+std::vector<Student> DatabaseIndexed::get_students_by_rating_range(float min_rating, float max_rating) const {
+    std::vector<Student> result;
+
+    if (std::isnan(min_rating) || std::isnan(max_rating)) {
+        return result;
+    }
+
+    // Keys carry the phone, so scan from the smallest key of min_rating until past max_rating
+    // (NaN ratings sort after every number and end the scan too)
+    indices.get<RatingIndex>().scan_from({false, min_rating, std::string()},
+    [max_rating, &result](const Student& student) {
+        if (std::isnan(student.m_rating) || student.m_rating > max_rating) {
+            return false;
+        }
+
+        result.push_back(student);
+        return true;
+    });
+
+    return result;
+}
+
+std::vector<Student> DatabaseIndexed::get_students_by_birth_range(int from_date, int to_date) const {
+    std::vector<Student> result;
+
+    indices.get<BirthIndex>().scan_from({from_date, std::string()}, [to_date, &result](const Student& student) {
+        if (student.get_packed_birth_date() > to_date) {
+            return false;
+        }
+
+        result.push_back(student);
+        return true;
+    });
+
+    return result;
+}
+
+std::vector<Student> DatabaseIndexed::top_k_by_rating(const std::string& group, size_t k) const {
+    std::vector<Student> result;
+
+    if (k == 0) {
+        return result;
+    }
+
+    // Group entries are already in (rating desc, phone) order: take the first k
+    indices.get<GroupRatingIndex>().scan_from({group, false, -std::numeric_limits<float>::infinity(), std::string()},
+    [&group, k, &result](const Student& student) {
+        if (student.m_group != group) {
+            return false;
+        }
+
+        result.push_back(student);
+        return result.size() < k;
+    });
+
+    return result;
+}
+
+std::map<std::string, std::vector<Student>> DatabaseIndexed::top_k_by_rating_per_group(size_t k) const {
+    std::map<std::string, std::vector<Student>> result;
+    std::tuple<std::string, bool, float, std::string> next_group("", false, -std::numeric_limits<float>::infinity(), "");
+
+    // Jump from group to group: no string sorts between group and group + '\0', so the
+    // smallest key of group + '\0' is past every entry of group (whatever its rating)
+    while (true) {
+        const Student* head = nullptr;
+
+        indices.get<GroupRatingIndex>().scan_from(next_group, [&head](const Student& student) {
+            head = &student;
+            return false;
+        });
+
+        if (!head) {
+            break;
+        }
+
+        result.emplace(head->m_group, top_k_by_rating(head->m_group, k));
+        next_group = {head->m_group + '\0', false, -std::numeric_limits<float>::infinity(), std::string()};
+    }
+
+    return result;
+}
+
+size_t DatabaseIndexed::estimate_memory_usage() const {
+    size_t memory = sizeof(DatabaseIndexed);
+
+    size_t bucket_count = primary_data.bucket_count();
+    memory += bucket_count * sizeof(void*);
+    memory += primary_data.size() * (sizeof(std::string) + sizeof(Student) + sizeof(size_t) + sizeof(void*));
+
+    for (const auto& pair : primary_data) {
+        memory += pair.first.capacity(); // phone number key
+        memory += pair.second.m_name.capacity();
+        memory += pair.second.m_surname.capacity();
+        memory += pair.second.m_email.capacity();
+        memory += pair.second.m_group.capacity();
+        memory += pair.second.m_phone_number.capacity();
+    }
+
+    return memory + indices.estimate_memory_usage();
+}
+
+std::string DatabaseIndexed::get_container_name() const {
+    return "Indexed (unordered_map + declarative IndexSet)";
+}
@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <queue>
+#include <set>
+#include <unordered_map>
+
+#include "database_interface.hpp"
+#include "sorting.hpp"
+
+size_t IStudentDatabase::change_group_batch(const std::vector<std::pair<std::string, std::string>>& changes) {
+    size_t changed = 0;
+
+    for (const auto& change : changes) {
+        if (change_group_by_phone(change.first, change.second)) {
+            ++changed;
+        }
+    }
+
+    return changed;
+}
+
+std::vector<std::vector<std::string>> IStudentDatabase::get_groups_by_surnames(const std::vector<std::string>& surnames) const {
+    std::vector<std::vector<std::string>> result(surnames.size());
+    std::unordered_map<std::string, size_t> first_position;
+    first_position.reserve(surnames.size());
+
+    for (size_t i = 0; i < surnames.size(); ++i) {
+        auto inserted = first_position.emplace(surnames[i], i);
+
+        if (inserted.second) {
+            result[i] = get_groups_by_surname(surnames[i]);
+        } else {
+            result[i] = result[inserted.first->second];
+        }
+    }
+
+    return result;
+}
+
+std::vector<std::vector<Student>> IStudentDatabase::get_students_by_groups_sorted(const std::vector<std::string>& groups) const {
+    std::vector<std::vector<Student>> result(groups.size());
+    std::unordered_map<std::string, size_t> first_position;
+    first_position.reserve(groups.size());
+
+    for (size_t i = 0; i < groups.size(); ++i) {
+        auto inserted = first_position.emplace(groups[i], i);
+
+        if (inserted.second) {
+            result[i] = get_students_by_group_sorted(groups[i]);
+        } else {
+            result[i] = result[inserted.first->second];
+        }
+    }
+
+    return result;
+}
+
+std::vector<Student> IStudentDatabase::get_students_by_surname_prefix(const std::string& prefix, size_t limit) const {
+    std::vector<Student> result;
+
+    for_each_student([&prefix, &result](const Student& student) {
+        if (student.m_surname.compare(0, prefix.size(), prefix) == 0) {
+            result.push_back(student);
+        }
+    });
+
+    if (limit != 0 && limit < result.size()) {
+        std::partial_sort(result.begin(), result.begin() + limit, result.end(),
+                          student_comparators::compare_by_surname_name_and_phone);
+        result.resize(limit);
+    } else {
+        std::sort(result.begin(), result.end(),
+                  student_comparators::compare_by_surname_name_and_phone);
+    }
+
+    return result;
+}
+
+std::vector<Student> IStudentDatabase::get_students_by_rating_range(float min_rating, float max_rating) const {
+    std::vector<Student> result;
+
+    for_each_student([min_rating, max_rating, &result](const Student& student) {
+        if (student.m_rating >= min_rating && student.m_rating <= max_rating) {
+            result.push_back(student);
+        }
+    });
+
+    std::sort(result.begin(), result.end(), student_comparators::compare_by_rating_and_phone);
+
+    return result;
+}
+
+std::vector<Student> IStudentDatabase::get_students_by_birth_range(int from_date, int to_date) const {
+    std::vector<Student> result;
+
+    for_each_student([from_date, to_date, &result](const Student& student) {
+        int date = student.get_packed_birth_date();
+
+        if (date >= from_date && date <= to_date) {
+            result.push_back(student);
+        }
+    });
+
+    std::sort(result.begin(), result.end(), student_comparators::compare_by_birth_date_and_phone);
+
+    return result;
+}
+
+namespace {
+    // Keeps the k best students seen so far; the worst of them sits on top of the heap
+    class BoundedTopK {
+    public:
+        explicit BoundedTopK(size_t limit) : k(limit) {}
+
+        void offer(const Student& student) {
+            if (k == 0) {
+                return;
+            }
+
+            if (heap.size() < k) {
+                heap.push(student);
+            } else if (student_comparators::compare_by_rating_desc_and_phone(student, heap.top())) {
+                heap.pop();
+                heap.push(student);
+            }
+        }
+
+        std::vector<Student> take() {
+            std::vector<Student> result(heap.size());
+
+            for (size_t i = result.size(); i > 0; --i) {
+                result[i - 1] = heap.top();
+                heap.pop();
+            }
+
+            return result;
+        }
+
+    private:
+        using Order = bool (*)(const Student&, const Student&);
+
+        size_t k;
+        std::priority_queue<Student, std::vector<Student>, Order> heap{student_comparators::compare_by_rating_desc_and_phone};
+    };
+}
+
+std::vector<Student> IStudentDatabase::top_k_by_rating(const std::string& group, size_t k) const {
+    BoundedTopK top(k);
+
+    for_each_student([&group, &top](const Student& student) {
+        if (student.m_group == group) {
+            top.offer(student);
+        }
+    });
+
+    return top.take();
+}
+
+std::map<std::string, std::vector<Student>> IStudentDatabase::top_k_by_rating_per_group(size_t k) const {
+    std::unordered_map<std::string, BoundedTopK> tops;
+
+    for_each_student([k, &tops](const Student& student) {
+        tops.try_emplace(student.m_group, k).first->second.offer(student);
+    });
+
+    std::map<std::string, std::vector<Student>> result;
+
+    for (auto& pair : tops) {
+        result.emplace(pair.first, pair.second.take());
+    }
+
+    return result;
+}
+
+namespace {
+    // Maps each requested key to a slot shared by all its duplicates
+    std::unordered_map<std::string, size_t> assign_slots(const std::vector<std::string>& keys,
+                                                         std::vector<size_t>& slot_of) {
+        std::unordered_map<std::string, size_t> slots;
+        slots.reserve(keys.size());
+        slot_of.resize(keys.size());
+
+        for (size_t i = 0; i < keys.size(); ++i) {
+            slot_of[i] = slots.emplace(keys[i], slots.size()).first->second;
+        }
+
+        return slots;
+    }
+
+    // Moves each slot result into its last requesting position and copies it into the others
+    template <typename T>
+    std::vector<T> distribute(std::vector<T>& per_slot, const std::vector<size_t>& slot_of) {
+        std::vector<T> result(slot_of.size());
+        std::vector<size_t> remaining(per_slot.size(), 0);
+
+        for (size_t slot : slot_of) {
+            ++remaining[slot];
+        }
+
+        for (size_t i = 0; i < slot_of.size(); ++i) {
+            size_t slot = slot_of[i];
+
+            if (--remaining[slot] == 0) {
+                result[i] = std::move(per_slot[slot]);
+            } else {
+                result[i] = per_slot[slot];
+            }
+        }
+
+        return result;
+    }
+}
+
+std::vector<std::vector<std::string>> IStudentDatabase::scan_groups_by_surnames(const std::vector<std::string>& surnames) const {
+    std::vector<size_t> slot_of;
+    auto slots = assign_slots(surnames, slot_of);
+    std::vector<std::set<std::string>> unique_groups(slots.size());
+
+    for_each_student([&slots, &unique_groups](const Student& student) {
+        auto it = slots.find(student.m_surname);
+
+        if (it != slots.end()) {
+            unique_groups[it->second].insert(student.m_group);
+        }
+    });
+
+    std::vector<std::vector<std::string>> per_slot(slots.size());
+
+    for (size_t i = 0; i < slots.size(); ++i) {
+        per_slot[i].assign(unique_groups[i].begin(), unique_groups[i].end());
+    }
+
+    return distribute(per_slot, slot_of);
+}
+
+std::vector<std::vector<Student>> IStudentDatabase::scan_students_by_groups_sorted(const std::vector<std::string>& groups) const {
+    std::vector<size_t> slot_of;
+    auto slots = assign_slots(groups, slot_of);
+    std::vector<std::vector<Student>> per_slot(slots.size());
+
+    for_each_student([&slots, &per_slot](const Student& student) {
+        auto it = slots.find(student.m_group);
+
+        if (it != slots.end()) {
+            per_slot[it->second].push_back(student);
+        }
+    });
+
+    for (auto& roster : per_slot) {
+        sort_algorithms::multikey_sort_by_surname_and_name(roster);
+    }
+
+    return distribute(per_slot, slot_of);
+}
@@ -0,0 +1,865 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "database_mapped.hpp"
+#include "csv_handler.hpp"
+#include "sorting.hpp"
+
+using mapped_format::NIL;
+
+namespace {
+    constexpr uint32_t DEFAULT_RECORD_CAPACITY = 1024;
+    constexpr uint64_t DEFAULT_POOL_CAPACITY = 64 * 1024;
+    constexpr uint32_t DEFAULT_GROUP_CAPACITY = 256;
+    constexpr uint64_t MAX_POOL_CAPACITY = 0xFFFFFFFFull;  // StringRef offsets are 32-bit
+    constexpr uint64_t MAX_RECORD_CAPACITY = NIL - 1;
+
+    uint64_t align_up(uint64_t value) {
+        return (value + 63) & ~uint64_t(63);
+    }
+
+    uint32_t bucket_count_for(uint32_t record_capacity) {
+        uint32_t count = 16;
+
+        while (count < record_capacity) {
+            count <<= 1;
+        }
+
+        return count;
+    }
+
+    uint64_t string_bytes(const Student& student) {
+        return student.m_name.size() + student.m_surname.size() +
+               student.m_email.size() + student.m_phone_number.size();
+    }
+}
+
+DatabaseMapped::DatabaseMapped(const std::string& file_path) : path(file_path) {
+    struct stat st;
+
+    if (::stat(path.c_str(), &st) == 0) {
+        open_existing();
+    } else {
+        create(DEFAULT_RECORD_CAPACITY, DEFAULT_POOL_CAPACITY, DEFAULT_GROUP_CAPACITY);
+    }
+}
+
+DatabaseMapped::DatabaseMapped(const std::string& file_path, const std::vector<Student>& initial_data)
+    : path(file_path) {
+    uint64_t pool_bytes = 0;
+
+    for (const auto& student : initial_data) {
+        pool_bytes += string_bytes(student);
+    }
+
+    uint64_t record_capacity = std::max<uint64_t>(initial_data.size(), DEFAULT_RECORD_CAPACITY);
+
+    if (!create(static_cast<uint32_t>(std::min(record_capacity, MAX_RECORD_CAPACITY)),
+                std::min(pool_bytes + DEFAULT_POOL_CAPACITY, MAX_POOL_CAPACITY),
+                DEFAULT_GROUP_CAPACITY)) {
+        return;
+    }
+
+    for (const auto& student : initial_data) {
+        add(student);
+    }
+
+    flush();
+}
+
+DatabaseMapped::DatabaseMapped(const std::string& file_path, uint32_t record_capacity,
+                               uint64_t pool_capacity, uint32_t group_capacity)
+    : path(file_path) {
+    create(record_capacity, pool_capacity, group_capacity);
+}
+
+DatabaseMapped::~DatabaseMapped() {
+    if (is_open()) {
+        flush();
+        close();
+    }
+}
+
+uint64_t DatabaseMapped::hash(std::string_view key) {
+    // FNV-1a: the buckets live in the file, so the hash must not change between runs or builds
+    uint64_t h = 14695981039346656037ull;
+
+    for (char c : key) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+
+    return h;
+}
+
+bool DatabaseMapped::create(uint32_t record_capacity, uint64_t pool_capacity, uint32_t group_capacity) {
+    using namespace mapped_format;
+
+    if (record_capacity > MAX_RECORD_CAPACITY || pool_capacity > MAX_POOL_CAPACITY) {
+        std::cerr << "Error: " << path << " would exceed the mapped format limits" << std::endl;
+        return false;
+    }
+
+    Header layout{};
+    std::memcpy(layout.magic, MAGIC, sizeof(MAGIC));
+    layout.version = VERSION;
+    layout.record_capacity = record_capacity;
+    layout.free_head = NIL;
+    layout.group_capacity = group_capacity;
+    layout.bucket_count = bucket_count_for(record_capacity);
+    layout.pool_capacity = pool_capacity;
+    layout.groups_offset = align_up(sizeof(Header));
+    layout.phone_buckets_offset = align_up(layout.groups_offset + uint64_t(group_capacity) * sizeof(GroupEntry));
+    layout.surname_buckets_offset = align_up(layout.phone_buckets_offset + uint64_t(layout.bucket_count) * sizeof(uint32_t));
+    layout.records_offset = align_up(layout.surname_buckets_offset + uint64_t(layout.bucket_count) * sizeof(uint32_t));
+    layout.pool_offset = align_up(layout.records_offset + uint64_t(record_capacity) * sizeof(Record));
+    layout.file_size = layout.pool_offset + pool_capacity;
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0) {
+        std::cerr << "Error: Could not create file " << path << std::endl;
+        return false;
+    }
+
+    if (::ftruncate(fd, static_cast<off_t>(layout.file_size)) != 0) {
+        std::cerr << "Error: Could not resize " << path << std::endl;
+        close();
+        return false;
+    }
+
+    void* mapping = ::mmap(nullptr, layout.file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Error: Could not map " << path << std::endl;
+        close();
+        return false;
+    }
+
+    base = static_cast<char*>(mapping);
+    mapped_size = layout.file_size;
+
+    header() = layout;
+    std::fill_n(phone_buckets(), layout.bucket_count, NIL);
+    std::fill_n(surname_buckets(), layout.bucket_count, NIL);
+
+    group_ids.clear();
+    group_names.clear();
+
+    return flush();
+}
+
+bool DatabaseMapped::open_existing() {
+    using namespace mapped_format;
+
+    fd = ::open(path.c_str(), O_RDWR);
+
+    if (fd < 0) {
+        std::cerr << "Error: Could not open file " << path << std::endl;
+        return false;
+    }
+
+    struct stat st;
+
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+        std::cerr << "Error: " << path << " is not a mapped student database" << std::endl;
+        close();
+        return false;
+    }
+
+    void* mapping = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Error: Could not map " << path << std::endl;
+        close();
+        return false;
+    }
+
+    base = static_cast<char*>(mapping);
+    mapped_size = st.st_size;
+
+    const Header& h = header();
+
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "Error: " << path << " is not a mapped student database" << std::endl;
+        close();
+        return false;
+    }
+
+    if (h.version != VERSION) {
+        std::cerr << "Error: " << path << " has format version " << h.version
+                  << ", expected " << VERSION << std::endl;
+        close();
+        return false;
+    }
+
+    bool consistent =
+        h.file_size == mapped_size &&
+        (h.bucket_count & (h.bucket_count - 1)) == 0 && h.bucket_count != 0 &&
+        h.groups_offset >= sizeof(Header) &&
+        h.groups_offset + uint64_t(h.group_capacity) * sizeof(GroupEntry) <= h.phone_buckets_offset &&
+        h.phone_buckets_offset + uint64_t(h.bucket_count) * sizeof(uint32_t) <= h.surname_buckets_offset &&
+        h.surname_buckets_offset + uint64_t(h.bucket_count) * sizeof(uint32_t) <= h.records_offset &&
+        h.records_offset + uint64_t(h.record_capacity) * sizeof(Record) <= h.pool_offset &&
+        h.pool_offset + h.pool_capacity <= h.file_size &&
+        h.record_slots <= h.record_capacity &&
+        h.group_count <= h.group_capacity &&
+        h.pool_size <= h.pool_capacity;
+
+    if (!consistent) {
+        std::cerr << "Error: " << path << " has an inconsistent header" << std::endl;
+        close();
+        return false;
+    }
+
+    if (h.dirty) {
+        std::cerr << "Warning: " << path << " was not flushed, rebuilding links" << std::endl;
+        rebuild_links();
+        flush();
+    }
+
+    group_ids.clear();
+    group_names.clear();
+    group_names.reserve(h.group_count);
+
+    for (uint32_t i = 0; i < h.group_count; ++i) {
+        if (!in_pool(groups()[i].name)) {
+            std::cerr << "Error: " << path << " has a corrupt group table" << std::endl;
+            close();
+            return false;
+        }
+
+        group_names.emplace_back(view(groups()[i].name));
+        group_ids.emplace(group_names.back(), i);
+    }
+
+    return true;
+}
+
+void DatabaseMapped::close() {
+    if (base) {
+        ::munmap(base, mapped_size);
+        base = nullptr;
+        mapped_size = 0;
+    }
+
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+mapped_format::Header& DatabaseMapped::header() const {
+    return *reinterpret_cast<mapped_format::Header*>(base);
+}
+
+mapped_format::GroupEntry* DatabaseMapped::groups() const {
+    return reinterpret_cast<mapped_format::GroupEntry*>(base + header().groups_offset);
+}
+
+uint32_t* DatabaseMapped::phone_buckets() const {
+    return reinterpret_cast<uint32_t*>(base + header().phone_buckets_offset);
+}
+
+uint32_t* DatabaseMapped::surname_buckets() const {
+    return reinterpret_cast<uint32_t*>(base + header().surname_buckets_offset);
+}
+
+mapped_format::Record* DatabaseMapped::records() const {
+    return reinterpret_cast<mapped_format::Record*>(base + header().records_offset);
+}
+
+char* DatabaseMapped::pool() const {
+    return base + header().pool_offset;
+}
+
+bool DatabaseMapped::in_pool(mapped_format::StringRef ref) const {
+    return uint64_t(ref.offset) + ref.length <= header().pool_size;
+}
+
+std::string_view DatabaseMapped::view(mapped_format::StringRef ref) const {
+    return std::string_view(pool() + ref.offset, ref.length);
+}
+
+Student DatabaseMapped::decode(const mapped_format::Record& record) const {
+    return Student(std::string(view(record.name)), std::string(view(record.surname)),
+                   std::string(view(record.email)), record.birth_year, record.birth_month,
+                   record.birth_day, group_names[record.group], record.rating,
+                   std::string(view(record.phone)));
+}
+
+mapped_format::StringRef DatabaseMapped::append_string(std::string_view text) {
+    mapped_format::Header& h = header();
+    mapped_format::StringRef ref{static_cast<uint32_t>(h.pool_size), static_cast<uint32_t>(text.size())};
+
+    std::memcpy(pool() + h.pool_size, text.data(), text.size());
+    h.pool_size += text.size();
+
+    return ref;
+}
+
+uint32_t DatabaseMapped::find_record(std::string_view phone) const {
+    const mapped_format::Record* rows = records();
+    uint32_t index = phone_buckets()[hash(phone) & (header().bucket_count - 1)];
+
+    while (index != NIL && view(rows[index].phone) != phone) {
+        index = rows[index].phone_next;
+    }
+
+    return index;
+}
+
+uint32_t DatabaseMapped::find_or_add_group(const std::string& group) {
+    auto it = group_ids.find(group);
+
+    if (it != group_ids.end()) {
+        return it->second;
+    }
+
+    // Capacity was checked by reserve()
+    mapped_format::Header& h = header();
+    uint32_t index = h.group_count++;
+
+    groups()[index] = {append_string(group), NIL, 0};
+    group_names.push_back(group);
+    group_ids.emplace(group, index);
+
+    return index;
+}
+
+void DatabaseMapped::link_keys(uint32_t index) {
+    mapped_format::Record& record = records()[index];
+    uint32_t mask = header().bucket_count - 1;
+
+    uint32_t& phone_head = phone_buckets()[hash(view(record.phone)) & mask];
+    record.phone_next = phone_head;
+    phone_head = index;
+
+    uint32_t& surname_head = surname_buckets()[hash(view(record.surname)) & mask];
+    record.surname_next = surname_head;
+    surname_head = index;
+}
+
+void DatabaseMapped::unlink_keys(uint32_t index) {
+    mapped_format::Record* rows = records();
+    mapped_format::Record& record = rows[index];
+    uint32_t mask = header().bucket_count - 1;
+
+    uint32_t* slot = &phone_buckets()[hash(view(record.phone)) & mask];
+    while (*slot != index) {
+        slot = &rows[*slot].phone_next;
+    }
+    *slot = record.phone_next;
+
+    slot = &surname_buckets()[hash(view(record.surname)) & mask];
+    while (*slot != index) {
+        slot = &rows[*slot].surname_next;
+    }
+    *slot = record.surname_next;
+}
+
+void DatabaseMapped::link_group(uint32_t index) {
+    mapped_format::Record* rows = records();
+    mapped_format::GroupEntry& group = groups()[rows[index].group];
+
+    rows[index].group_prev = NIL;
+    rows[index].group_next = group.head;
+
+    if (group.head != NIL) {
+        rows[group.head].group_prev = index;
+    }
+
+    group.head = index;
+    group.count++;
+}
+
+void DatabaseMapped::unlink_group(uint32_t index) {
+    mapped_format::Record* rows = records();
+    mapped_format::Record& record = rows[index];
+    mapped_format::GroupEntry& group = groups()[record.group];
+
+    if (record.group_prev != NIL) {
+        rows[record.group_prev].group_next = record.group_next;
+    } else {
+        group.head = record.group_next;
+    }
+
+    if (record.group_next != NIL) {
+        rows[record.group_next].group_prev = record.group_prev;
+    }
+
+    group.count--;
+}
+
+void DatabaseMapped::rebuild_links() {
+    mapped_format::Header& h = header();
+    mapped_format::Record* rows = records();
+
+    std::fill_n(phone_buckets(), h.bucket_count, NIL);
+    std::fill_n(surname_buckets(), h.bucket_count, NIL);
+
+    // Pages written back before the crash may be torn: a group whose name no longer lies in
+    // the pool is emptied, and its records are freed with the other unreadable ones below
+    std::vector<bool> group_valid(h.group_count);
+
+    for (uint32_t i = 0; i < h.group_count; ++i) {
+        group_valid[i] = in_pool(groups()[i].name);
+
+        if (!group_valid[i]) {
+            groups()[i].name = {0, 0};
+        }
+
+        groups()[i].head = NIL;
+        groups()[i].count = 0;
+    }
+
+    auto readable = [&](const mapped_format::Record& record) {
+        return record.group < h.group_count && group_valid[record.group]
+            && in_pool(record.name) && in_pool(record.surname)
+            && in_pool(record.email) && in_pool(record.phone);
+    };
+
+    h.free_head = NIL;
+    h.record_count = 0;
+
+    for (uint32_t i = h.record_slots; i-- > 0; ) {
+        if (rows[i].live && readable(rows[i])) {
+            link_keys(i);
+            link_group(i);
+            h.record_count++;
+        } else {
+            rows[i].live = 0;
+            rows[i].phone_next = h.free_head;
+            h.free_head = i;
+        }
+    }
+}
+
+void DatabaseMapped::mark_dirty() {
+    // Make the flag durable before the first in-place write, so a crash is detected on open
+    if (!header().dirty) {
+        header().dirty = 1;
+        ::msync(base, sizeof(mapped_format::Header), MS_SYNC);
+    }
+}
+
+bool DatabaseMapped::reserve(uint64_t extra_records, uint64_t extra_pool_bytes, uint32_t extra_groups) {
+    const mapped_format::Header& h = header();
+
+    uint64_t free_slots = h.record_capacity - h.record_slots;
+    for (uint32_t i = h.free_head; i != NIL && free_slots < extra_records; i = records()[i].phone_next) {
+        free_slots++;
+    }
+
+    bool records_full = free_slots < extra_records;
+    bool pool_full = h.pool_size + extra_pool_bytes > h.pool_capacity;
+    bool groups_full = uint64_t(h.group_count) + extra_groups > h.group_capacity;
+
+    if (!records_full && !pool_full && !groups_full) {
+        return true;
+    }
+
+    uint64_t record_capacity = h.record_capacity;
+    uint64_t pool_capacity = h.pool_capacity;
+    uint64_t group_capacity = h.group_capacity;
+
+    if (records_full) {
+        record_capacity = std::max<uint64_t>(record_capacity * 2, uint64_t(h.record_count) + extra_records);
+    }
+
+    if (pool_full) {
+        pool_capacity = std::max<uint64_t>(pool_capacity * 2, h.pool_size + extra_pool_bytes);
+    }
+
+    if (groups_full) {
+        group_capacity = std::max<uint64_t>(group_capacity * 2, uint64_t(h.group_count) + extra_groups);
+    }
+
+    if (uint64_t(h.record_count) + extra_records > MAX_RECORD_CAPACITY ||
+        h.pool_size + extra_pool_bytes > MAX_POOL_CAPACITY || group_capacity >= NIL) {
+        std::cerr << "Error: " << path << " would exceed the mapped format limits" << std::endl;
+        return false;
+    }
+
+    return grow(static_cast<uint32_t>(std::min(record_capacity, MAX_RECORD_CAPACITY)),
+                std::min(pool_capacity, MAX_POOL_CAPACITY),
+                static_cast<uint32_t>(group_capacity));
+}
+
+bool DatabaseMapped::reserve_for(const Student& student, bool replacing) {
+    bool new_group = group_ids.find(student.m_group) == group_ids.end();
+
+    // A replaced record frees its slot, but its strings stay in the pool until the next grow
+    return reserve(replacing ? 0 : 1, string_bytes(student) + (new_group ? student.m_group.size() : 0), new_group ? 1 : 0);
+}
+
+bool DatabaseMapped::grow(uint32_t record_capacity, uint64_t pool_capacity, uint32_t group_capacity) {
+    DatabaseMapped fresh(path + ".grow", record_capacity, pool_capacity, group_capacity);
+
+    if (!fresh.is_open()) {
+        return false;
+    }
+
+    // Live records only: free slots and orphaned pool strings are dropped
+    const mapped_format::Record* rows = records();
+
+    for (uint32_t i = 0; i < header().record_slots; ++i) {
+        if (rows[i].live) {
+            fresh.insert(decode(rows[i]));
+        }
+    }
+
+    if (!fresh.flush() || std::rename(fresh.path.c_str(), path.c_str()) != 0) {
+        std::cerr << "Error: Could not replace " << path << " with a larger file" << std::endl;
+        fresh.close();
+        std::remove(fresh.path.c_str());
+        return false;
+    }
+
+    std::swap(fd, fresh.fd);
+    std::swap(base, fresh.base);
+    std::swap(mapped_size, fresh.mapped_size);
+    std::swap(group_ids, fresh.group_ids);
+    std::swap(group_names, fresh.group_names);
+
+    fresh.close();  // Old mapping; its file was replaced by the rename
+
+    mark_dirty();   // The caller is in the middle of a write
+    return true;
+}
+
+void DatabaseMapped::insert(const Student& student) {
+    // Capacity was checked by reserve()
+    mapped_format::Header& h = header();
+    uint32_t index;
+
+    if (h.free_head != NIL) {
+        index = h.free_head;
+        h.free_head = records()[index].phone_next;
+    } else {
+        index = h.record_slots++;
+    }
+
+    uint32_t group = find_or_add_group(student.m_group);
+
+    mapped_format::Record& record = records()[index];
+    record.name = append_string(student.m_name);
+    record.surname = append_string(student.m_surname);
+    record.email = append_string(student.m_email);
+    record.phone = append_string(student.m_phone_number);
+    record.group = group;
+    record.birth_year = student.m_birth_year;
+    record.birth_month = static_cast<uint8_t>(student.m_birth_month);
+    record.birth_day = static_cast<uint8_t>(student.m_birth_day);
+    record.live = 1;
+    record.reserved = 0;
+    record.rating = student.m_rating;
+
+    link_keys(index);
+    link_group(index);
+    h.record_count++;
+}
+
+void DatabaseMapped::release(uint32_t index) {
+    mapped_format::Header& h = header();
+    mapped_format::Record& record = records()[index];
+
+    unlink_keys(index);
+    unlink_group(index);
+
+    record.live = 0;
+    record.phone_next = h.free_head;
+    h.free_head = index;
+    h.record_count--;
+}
+
+bool DatabaseMapped::is_open() const {
+    return base != nullptr;
+}
+
+bool DatabaseMapped::flush() {
+    if (!is_open()) {
+        return false;
+    }
+
+    if (::msync(base, mapped_size, MS_SYNC) != 0) {
+        std::cerr << "Error: Could not sync " << path << std::endl;
+        return false;
+    }
+
+    header().dirty = 0;
+    return ::msync(base, sizeof(mapped_format::Header), MS_SYNC) == 0;
+}
+
+const std::string& DatabaseMapped::file_path() const {
+    return path;
+}
+
+bool DatabaseMapped::load_from_file(const std::string& filename) {
+    std::vector<Student> temp = csv::read_csv(filename);
+
+    // A missing or empty CSV must not wipe the backing file
+    if (!is_open() || temp.empty()) {
+        return false;
+    }
+
+    uint64_t pool_bytes = 0;
+    for (const auto& student : temp) {
+        pool_bytes += string_bytes(student);
+    }
+
+    // One growth up front instead of a doubling sequence, before anything is deleted, so a
+    // failed growth leaves the file as it was (sized as if the old records stayed)
+    if (!reserve(temp.size(), pool_bytes, 0)) {
+        return false;
+    }
+
+    clear();
+
+    for (const auto& student : temp) {
+        add(student);
+    }
+
+    flush();
+
+    return !empty();
+}
+
+void DatabaseMapped::add(const Student& student) {
+    if (!is_open()) {
+        return;
+    }
+
+    mark_dirty();
+
+    // Secure capacity before touching the old record: if the file cannot grow, both stay as they were
+    if (!reserve_for(student, find_record(student.m_phone_number) != NIL)) {
+        std::cerr << "Error: Could not add " << student.m_phone_number << " to " << path << std::endl;
+        return;
+    }
+
+    // reserve() may have rewritten the file, so look the record up again
+    uint32_t index = find_record(student.m_phone_number);
+
+    if (index != NIL) {
+        release(index);
+    }
+
+    insert(student);
+}
+
+bool DatabaseMapped::remove_by_phone(const std::string& phone_number) {
+    if (!is_open()) {
+        return false;
+    }
+
+    uint32_t index = find_record(phone_number);
+
+    if (index == NIL) {
+        return false;
+    }
+
+    mark_dirty();
+    release(index);
+
+    return true;
+}
+
+size_t DatabaseMapped::size() const {
+    return is_open() ? header().record_count : 0;
+}
+
+bool DatabaseMapped::empty() const {
+    return size() == 0;
+}
+
+void DatabaseMapped::clear() {
+    if (!is_open()) {
+        return;
+    }
+
+    mark_dirty();
+
+    mapped_format::Header& h = header();
+    h.record_count = 0;
+    h.record_slots = 0;
+    h.free_head = NIL;
+    h.group_count = 0;
+    h.pool_size = 0;
+
+    std::fill_n(phone_buckets(), h.bucket_count, NIL);
+    std::fill_n(surname_buckets(), h.bucket_count, NIL);
+
+    group_ids.clear();
+    group_names.clear();
+}
+
+std::vector<Student> DatabaseMapped::to_vector() const {
+    std::vector<Student> result;
+    result.reserve(size());
+
+    for_each_student([&result](const Student& student) {
+        result.push_back(student);
+    });
+
+    return result;
+}
+
+bool DatabaseMapped::change_group_by_phone(const std::string& phone_number, const std::string& new_group) {
+    if (!is_open()) {
+        return false;
+    }
+
+    uint32_t index = find_record(phone_number);
+
+    if (index == NIL) {
+        return false;
+    }
+
+    mark_dirty();
+
+    if (group_ids.find(new_group) == group_ids.end()) {
+        if (!reserve(0, new_group.size(), 1)) {
+            return false;
+        }
+
+        index = find_record(phone_number);  // grow() renumbers records
+    }
+
+    uint32_t group = find_or_add_group(new_group);
+    mapped_format::Record& record = records()[index];
+
+    if (record.group != group) {
+        unlink_group(index);
+        record.group = group;
+        link_group(index);
+    }
+
+    return true;
+}
+
+std::vector<Student> DatabaseMapped::get_students_by_group_sorted(const std::string& group) const {
+    std::vector<Student> result;
+    auto it = group_ids.find(group);
+
+    if (!is_open() || it == group_ids.end()) {
+        return result;
+    }
+
+    const mapped_format::Record* rows = records();
+    const mapped_format::GroupEntry& entry = groups()[it->second];
+    result.reserve(entry.count);
+
+    for (uint32_t i = entry.head; i != NIL; i = rows[i].group_next) {
+        result.push_back(decode(rows[i]));
+    }
+
+    sort_algorithms::multikey_sort_by_surname_and_name(result);
+
+    return result;
+}
+
+std::vector<std::string> DatabaseMapped::get_groups_by_surname(const std::string& surname) const {
+    std::vector<const std::string*> names;
+    view_groups_by_surname(surname, names);
+
+    std::vector<std::string> result;
+    result.reserve(names.size());
+
+    for (const std::string* name : names) {
+        result.push_back(*name);
+    }
+
+    return result;
+}
+
+void DatabaseMapped::view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const {
+    out.clear();
+    view_buffer.clear();
+
+    auto it = group_ids.find(group);
+
+    if (!is_open() || it == group_ids.end()) {
+        return;
+    }
+
+    const mapped_format::Record* rows = records();
+    const mapped_format::GroupEntry& entry = groups()[it->second];
+    view_buffer.reserve(entry.count);
+
+    for (uint32_t i = entry.head; i != NIL; i = rows[i].group_next) {
+        view_buffer.push_back(decode(rows[i]));
+    }
+
+    for (const auto& student : view_buffer) {
+        out.push_back(&student);
+    }
+
+    sort_algorithms::multikey_sort_by_surname_and_name(out);
+}
+
+void DatabaseMapped::view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const {
+    out.clear();
+
+    if (!is_open()) {
+        return;
+    }
+
+    const mapped_format::Record* rows = records();
+    std::vector<uint32_t> group_indices;
+
+    for (uint32_t i = surname_buckets()[hash(surname) & (header().bucket_count - 1)]; i != NIL; i = rows[i].surname_next) {
+        if (view(rows[i].surname) == surname) {
+            group_indices.push_back(rows[i].group);
+        }
+    }
+
+    std::sort(group_indices.begin(), group_indices.end());
+    group_indices.erase(std::unique(group_indices.begin(), group_indices.end()), group_indices.end());
+
+    for (uint32_t index : group_indices) {
+        out.push_back(&group_names[index]);
+    }
+
+    sort_unique_groups(out);
+}
+
+void DatabaseMapped::for_each_student(const std::function<void(const Student&)>& visitor) const {
+    if (!is_open()) {
+        return;
+    }
+
+    const mapped_format::Record* rows = records();
+    uint32_t slots = header().record_slots;
+
+    for (uint32_t i = 0; i < slots; ++i) {
+        if (rows[i].live) {
+            visitor(decode(rows[i]));
+        }
+    }
+}
+
+size_t DatabaseMapped::estimate_memory_usage() const {
+    // The file mapping (page cache, faulted in on demand) plus the in-memory group dictionary
+    size_t memory = sizeof(DatabaseMapped) + mapped_size;
+
+    memory += group_ids.bucket_count() * sizeof(void*);
+    memory += group_names.capacity() * sizeof(std::string);
+
+    for (const auto& name : group_names) {
+        memory += sizeof(std::string) + sizeof(uint32_t) + sizeof(void*) + 2 * name.capacity();
+    }
+
+    return memory + view_buffer.capacity() * sizeof(Student);
+}
+
+std::string DatabaseMapped::get_container_name() const {
+    return "Mapped (mmap file, offset-linked records)";
+}
@@ -0,0 +1,6 @@
+#include "database_base.hpp"
+#include "database_vector.hpp"
+
+std::unique_ptr<IStudentDatabase> make_memory_snapshot(const std::vector<Student>& students) {
+    return std::make_unique<DatabaseVector>(students);
+}
@@ -5,12 +5,35 @@
 
 #include "database_treemap.hpp"
 #include "csv_handler.hpp"
+#include "sorting.hpp"
 
 DatabaseTreeMap::DatabaseTreeMap() : data() {}
 
 DatabaseTreeMap::DatabaseTreeMap(const std::vector<Student>& initial_data) {
-    for (const auto& student : initial_data) {
-        data[student.m_phone_number] = student;
+    bulk_load(initial_data);
+}
+
+void DatabaseTreeMap::bulk_load(const std::vector<Student>& students) {
+    std::vector<const Student*> handles;
+    handles.reserve(students.size());
+
+    for (const auto& student : students) {
+        handles.push_back(&student);
+    }
+
+    // Stable, so among equal phones the last row in input order comes last
+    std::stable_sort(handles.begin(), handles.end(),
+    [](const Student* a, const Student* b) {
+        return a->m_phone_number < b->m_phone_number;
+    });
+
+    for (size_t i = 0; i < handles.size(); ++i) {
+        if (i + 1 < handles.size() && handles[i + 1]->m_phone_number == handles[i]->m_phone_number) {
+            continue;
+        }
+
+        // Hinted insert at end(): amortized O(1) per node for sorted input
+        data.emplace_hint(data.end(), handles[i]->m_phone_number, *handles[i]);
     }
 }
 
@@ -18,17 +41,11 @@ bool DatabaseTreeMap::load_from_file(const std::string& filename) {
     std::vector<Student> temp = csv::read_csv(filename);
     data.clear();
 
-    for (const auto& student : temp) {
-        data[student.m_phone_number] = student;
-    }
+    bulk_load(temp);
 
     return !data.empty();
 }
 
-bool DatabaseTreeMap::save_to_file(const std::string& filename) const {
-    return csv::write_csv(filename, to_vector());
-}
-
 void DatabaseTreeMap::add(const Student& student) {
     data[student.m_phone_number] = student;
 }
@@ -87,8 +104,7 @@ std::vector<Student> DatabaseTreeMap::get_students_by_group_sorted(const std::st
         }
     }
     
-    std::sort(result.begin(), result.end(), 
-              student_comparators::compare_by_surname_and_name);
+    sort_algorithms::multikey_sort_by_surname_and_name(result);
     
     return result;
 }
@@ -105,19 +121,42 @@ std::vector<std::string> DatabaseTreeMap::get_groups_by_surname(const std::strin
     return std::vector<std::string>(unique_groups.begin(), unique_groups.end());
 }
 
-bool DatabaseTreeMap::sort_by_rating_and_save(
-    const std::string& filename,
-    std::function<void(std::vector<Student>&, std::function<bool(const Student&, const Student&)>)> sort_func,
-    bool ascending) {
-    
-    std::vector<Student> sorted_data = to_vector();
-    
-    auto comparator = ascending ? student_comparators::compare_by_rating 
-                                : student_comparators::compare_by_rating_desc;
-    
-    sort_func(sorted_data, comparator);
-    
-    return csv::write_csv(filename, sorted_data);
+void DatabaseTreeMap::view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const {
+    out.clear();
+
+    for (const auto& pair : data) {
+        if (pair.second.m_group == group) {
+            out.push_back(&pair.second);
+        }
+    }
+
+    sort_algorithms::multikey_sort_by_surname_and_name(out);
+}
+
+void DatabaseTreeMap::view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const {
+    out.clear();
+
+    for (const auto& pair : data) {
+        if (pair.second.m_surname == surname) {
+            out.push_back(&pair.second.m_group);
+        }
+    }
+
+    sort_unique_groups(out);
+}
+
+void DatabaseTreeMap::for_each_student(const std::function<void(const Student&)>& visitor) const {
+    for (const auto& pair : data) {
+        visitor(pair.second);
+    }
+}
+
+std::vector<std::vector<std::string>> DatabaseTreeMap::get_groups_by_surnames(const std::vector<std::string>& surnames) const {
+    return scan_groups_by_surnames(surnames);
+}
+
+std::vector<std::vector<Student>> DatabaseTreeMap::get_students_by_groups_sorted(const std::vector<std::string>& groups) const {
+    return scan_students_by_groups_sorted(groups);
 }
 
 size_t DatabaseTreeMap::estimate_memory_usage() const {
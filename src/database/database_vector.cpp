@@ -1,80 +1,208 @@
 #include <algorithm>
 #include <set>
 #include <iostream>
+#include <unordered_map>
 
 #include "database_vector.hpp"
 #include "csv_handler.hpp"
+#include "sorting.hpp"
 
-DatabaseVector::DatabaseVector() : data() {}
+DatabaseVector::DatabaseVector(bool use_phone_index)
+    : blocks(std::make_shared<const BlockTable>()), count(0), use_phone_index(use_phone_index),
+      phone_index(std::make_shared<const PhoneIndex>()) {}
 
-DatabaseVector::DatabaseVector(const std::vector<Student>& initial_data) : data(initial_data) {}
+DatabaseVector::DatabaseVector(const std::vector<Student>& initial_data, bool use_phone_index)
+    : DatabaseVector(use_phone_index) {
+    bulk_load(initial_data);
+}
 
-bool DatabaseVector::load_from_file(const std::string& filename) {
-    data = csv::read_csv(filename);
-    return !data.empty();
+Student& DatabaseVector::mutable_at(size_t position) {
+    BlockTable& table = make_mutable(blocks);
+    return make_mutable(table[position / BLOCK_SIZE])[position % BLOCK_SIZE];
+}
+
+void DatabaseVector::push_back(const Student& student) {
+    BlockTable& table = make_mutable(blocks);
+
+    if (count % BLOCK_SIZE == 0) {
+        table.push_back(std::make_shared<const Block>());
+    }
+
+    make_mutable(table.back()).push_back(student);
+    ++count;
+}
+
+void DatabaseVector::pop_back() {
+    BlockTable& table = make_mutable(blocks);
+    Block& last = make_mutable(table.back());
+
+    last.pop_back();
+
+    if (last.empty()) {
+        table.pop_back();
+    }
+
+    --count;
+}
+
+size_t DatabaseVector::find_position(const std::string& phone_number) const {
+    if (use_phone_index) {
+        auto it = phone_index->find(phone_number);
+        return it != phone_index->end() ? it->second : count;
+    }
+
+    size_t position = 0;
+
+    for (const auto& block : *blocks) {
+        for (const auto& student : *block) {
+            if (student.m_phone_number == phone_number) {
+                return position;
+            }
+
+            ++position;
+        }
+    }
+
+    return count;
+}
+
+void DatabaseVector::bulk_load(const std::vector<Student>& students) {
+    // Without the persistent index a temporary one still dedupes in a single pass
+    PhoneIndex positions;
+    positions.reserve(students.size());
+
+    std::vector<Block> built;
+    size_t built_count = 0;
+
+    for (const auto& student : students) {
+        auto inserted = positions.emplace(student.m_phone_number, built_count);
+
+        if (!inserted.second) {
+            size_t position = inserted.first->second;
+            built[position / BLOCK_SIZE][position % BLOCK_SIZE] = student;
+            continue;
+        }
+
+        if (built_count % BLOCK_SIZE == 0) {
+            built.emplace_back();
+            built.back().reserve(std::min(BLOCK_SIZE, students.size() - built_count));
+        }
+
+        built.back().push_back(student);
+        ++built_count;
+    }
+
+    // Fresh storage: snapshots taken before the load keep the old blocks
+    auto table = std::make_shared<BlockTable>();
+    table->reserve(built.size());
+
+    for (auto& block : built) {
+        table->push_back(std::make_shared<const Block>(std::move(block)));
+    }
+
+    blocks = std::move(table);
+    count = built_count;
+    phone_index = use_phone_index ? std::make_shared<const PhoneIndex>(std::move(positions))
+                                  : std::make_shared<const PhoneIndex>();
 }
 
-bool DatabaseVector::save_to_file(const std::string& filename) const {
-    return csv::write_csv(filename, data);
+bool DatabaseVector::load_from_file(const std::string& filename) {
+    bulk_load(csv::read_csv(filename));
+    return count != 0;
 }
 
 void DatabaseVector::add(const Student& student) {
-    data.push_back(student);
+    size_t position = find_position(student.m_phone_number);
+
+    if (position != count) {
+        mutable_at(position) = student;
+        return;
+    }
+
+    if (use_phone_index) {
+        make_mutable(phone_index).emplace(student.m_phone_number, count);
+    }
+
+    push_back(student);
 }
 
 bool DatabaseVector::remove_by_phone(const std::string& phone_number) {
-    auto it = std::find_if(data.begin(), data.end(), 
-    [&phone_number](const Student& s) {
-        return s.m_phone_number == phone_number;
-    });
-    
-    if (it != data.end()) {
-        data.erase(it);
-        return true;
+    size_t position = find_position(phone_number);
+
+    if (position == count) {
+        return false;
     }
 
-    return false;
+    if (use_phone_index) {
+        make_mutable(phone_index).erase(phone_number);
+    }
+
+    // Swap-and-pop: move the last student into the hole instead of shifting the tail
+    if (position != count - 1) {
+        Student& last = mutable_at(count - 1);
+        Student& hole = mutable_at(position);
+        hole = std::move(last);
+
+        if (use_phone_index) {
+            make_mutable(phone_index)[hole.m_phone_number] = position;
+        }
+    }
+
+    pop_back();
+    return true;
 }
 
 size_t DatabaseVector::size() const {
-    return data.size();
+    return count;
 }
 
 bool DatabaseVector::empty() const {
-    return data.empty();
+    return count == 0;
 }
 
 void DatabaseVector::clear() {
-    data.clear();
+    blocks = std::make_shared<const BlockTable>();
+    count = 0;
+    phone_index = std::make_shared<const PhoneIndex>();
 }
 
 std::vector<Student> DatabaseVector::to_vector() const {
-    return data;
+    std::vector<Student> result;
+    result.reserve(count);
+
+    for_each_record([&result](const Student& student) {
+        result.push_back(student);
+    });
+
+    return result;
 }
 
 bool DatabaseVector::change_group_by_phone(const std::string& phone_number, const std::string& new_group) {
-    for (auto& student : data) {
-        if (student.m_phone_number == phone_number) {
-            student.m_group = new_group;
-            return true;
-        }
+    size_t position = find_position(phone_number);
+
+    if (position == count) {
+        return false;
     }
 
-    return false;
+    // A no-op change leaves a shared block shared
+    if (at(position).m_group != new_group) {
+        mutable_at(position).m_group = new_group;
+    }
+
+    return true;
 }
 
 std::vector<Student> DatabaseVector::get_students_by_group_sorted(const std::string& group) const {
     std::vector<Student> result;
-    result.reserve(data.size() / 10);
+    result.reserve(count / 10);
     
-    for (const auto& student : data) {
+    for_each_record([&](const Student& student) {
         if (student.m_group == group) {
             result.push_back(student);
         }
-    }
+    });
     
-    std::sort(result.begin(), result.end(), 
-              student_comparators::compare_by_surname_and_name);
+    sort_algorithms::multikey_sort_by_surname_and_name(result);
     
     return result;
 }
@@ -82,45 +210,124 @@ std::vector<Student> DatabaseVector::get_students_by_group_sorted(const std::str
 std::vector<std::string> DatabaseVector::get_groups_by_surname(const std::string& surname) const {
     std::set<std::string> unique_groups;
     
-    for (const auto& student : data) {
+    for_each_record([&](const Student& student) {
         if (student.m_surname == surname) {
             unique_groups.insert(student.m_group);
         }
-    }
+    });
     
     return std::vector<std::string>(unique_groups.begin(), unique_groups.end());
 }
 
-bool DatabaseVector::sort_by_rating_and_save(
-    const std::string& filename,
-    std::function<void(std::vector<Student>&, std::function<bool(const Student&, const Student&)>)> sort_func,
-    bool ascending) {
-    
-    std::vector<Student> sorted_data = data;
-    
-    auto comparator = ascending ? student_comparators::compare_by_rating 
-                                : student_comparators::compare_by_rating_desc;
-    
-    sort_func(sorted_data, comparator);
-    
-    return csv::write_csv(filename, sorted_data);
+void DatabaseVector::view_students_by_group_sorted(const std::string& group, std::vector<const Student*>& out) const {
+    out.clear();
+
+    for_each_record([&](const Student& student) {
+        if (student.m_group == group) {
+            out.push_back(&student);
+        }
+    });
+
+    sort_algorithms::multikey_sort_by_surname_and_name(out);
+}
+
+void DatabaseVector::view_groups_by_surname(const std::string& surname, std::vector<const std::string*>& out) const {
+    out.clear();
+
+    for_each_record([&](const Student& student) {
+        if (student.m_surname == surname) {
+            out.push_back(&student.m_group);
+        }
+    });
+
+    sort_unique_groups(out);
+}
+
+void DatabaseVector::for_each_student(const std::function<void(const Student&)>& visitor) const {
+    for_each_record(visitor);
+}
+
+size_t DatabaseVector::change_group_batch(const std::vector<std::pair<std::string, std::string>>& changes) {
+    if (use_phone_index) {
+        size_t changed = 0;
+
+        for (const auto& change : changes) {
+            changed += change_group_by_phone(change.first, change.second);
+        }
+
+        return changed;
+    }
+
+    // phone -> (final group, number of requested changes)
+    std::unordered_map<std::string, std::pair<const std::string*, size_t>> pending;
+    pending.reserve(changes.size());
+
+    for (const auto& change : changes) {
+        auto& entry = pending[change.first];
+        entry.first = &change.second;
+        ++entry.second;
+    }
+
+    size_t changed = 0;
+
+    // One scan for the whole batch instead of one scan per change; only blocks holding a
+    // changed student are made writable
+    for (size_t position = 0; position < count && !pending.empty(); ++position) {
+        auto it = pending.find(at(position).m_phone_number);
+
+        if (it != pending.end()) {
+            if (at(position).m_group != *it->second.first) {
+                mutable_at(position).m_group = *it->second.first;
+            }
+
+            changed += it->second.second;
+            pending.erase(it);
+        }
+    }
+
+    return changed;
+}
+
+std::vector<std::vector<std::string>> DatabaseVector::get_groups_by_surnames(const std::vector<std::string>& surnames) const {
+    return scan_groups_by_surnames(surnames);
+}
+
+std::vector<std::vector<Student>> DatabaseVector::get_students_by_groups_sorted(const std::vector<std::string>& groups) const {
+    return scan_students_by_groups_sorted(groups);
+}
+
+std::unique_ptr<IStudentDatabase> DatabaseVector::snapshot() const {
+    return std::make_unique<DatabaseVector>(*this);
 }
 
 size_t DatabaseVector::estimate_memory_usage() const {
     size_t memory = sizeof(DatabaseVector);
-    memory += data.capacity() * sizeof(Student);
     
-    for (const auto& student : data) {
-        memory += student.m_name.capacity();
-        memory += student.m_surname.capacity();
-        memory += student.m_email.capacity();
-        memory += student.m_group.capacity();
-        memory += student.m_phone_number.capacity();
+    // Block table, then each block with its shared control block
+    memory += sizeof(BlockTable) + blocks->capacity() * sizeof(std::shared_ptr<const Block>);
+    
+    for (const auto& block : *blocks) {
+        memory += sizeof(Block) + sizeof(long) * 2 + sizeof(void*);
+        memory += block->capacity() * sizeof(Student);
+        
+        for (const auto& student : *block) {
+            memory += student.m_name.capacity();
+            memory += student.m_surname.capacity();
+            memory += student.m_email.capacity();
+            memory += student.m_group.capacity();
+            memory += student.m_phone_number.capacity();
+        }
+    }
+    
+    // Phone index (hash nodes: key + position + next pointer)
+    memory += phone_index->bucket_count() * sizeof(void*);
+    for (const auto& pair : *phone_index) {
+        memory += sizeof(std::string) + sizeof(size_t) * 2 + sizeof(void*) + pair.first.capacity();
     }
     
     return memory;
 }
 
 std::string DatabaseVector::get_container_name() const {
-    return "std::vector";
+    return use_phone_index ? "std::vector + phone index" : "std::vector";
 }
\ No newline at end of file
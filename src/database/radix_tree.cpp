@@ -0,0 +1,227 @@
+#include <algorithm>
+
+#include "radix_tree.hpp"
+
+namespace indexing {
+
+    RadixTree::ChildIterator RadixTree::find_child(Node& node, char first) {
+        return std::lower_bound(node.children.begin(), node.children.end(), first,
+        [](const std::unique_ptr<Node>& child, char c) {
+            // Unsigned byte order, as std::string compares (char is signed on x86)
+            return static_cast<unsigned char>(child->label[0]) < static_cast<unsigned char>(c);
+        });
+    }
+
+    RadixTree::ConstChildIterator RadixTree::find_child(const Node& node, char first) {
+        return std::lower_bound(node.children.begin(), node.children.end(), first,
+        [](const std::unique_ptr<Node>& child, char c) {
+            return static_cast<unsigned char>(child->label[0]) < static_cast<unsigned char>(c);
+        });
+    }
+
+    void RadixTree::insert(const std::string& key, Handle handle) {
+        insert(root, key, 0, handle);
+    }
+
+    void RadixTree::insert(Node& node, const std::string& key, size_t pos, Handle handle) {
+        ++node.count;
+
+        if (pos == key.size()) {
+            node.values.push_back(handle);
+            return;
+        }
+
+        auto it = find_child(node, key[pos]);
+
+        if (it == node.children.end() || (*it)->label[0] != key[pos]) {
+            auto leaf = std::make_unique<Node>();
+            leaf->label = key.substr(pos);
+            leaf->values.push_back(handle);
+            leaf->count = 1;
+
+            node.children.insert(it, std::move(leaf));
+            return;
+        }
+
+        Node& child = **it;
+        size_t common = 0;
+
+        while (common < child.label.size() && pos + common < key.size()
+               && child.label[common] == key[pos + common]) {
+            ++common;
+        }
+
+        if (common < child.label.size()) {
+            // Split the edge: the new middle node takes the shared part of the label
+            auto middle = std::make_unique<Node>();
+            middle->label = child.label.substr(0, common);
+            middle->count = child.count;
+
+            child.label.erase(0, common);
+            middle->children.push_back(std::move(*it));
+            *it = std::move(middle);
+        }
+
+        insert(**it, key, pos + common, handle);
+    }
+
+    bool RadixTree::erase(const std::string& key, Handle handle) {
+        return erase(root, key, 0, handle);
+    }
+
+    bool RadixTree::erase(Node& node, const std::string& key, size_t pos, Handle handle) {
+        if (pos == key.size()) {
+            auto it = std::find(node.values.begin(), node.values.end(), handle);
+
+            if (it == node.values.end()) {
+                return false;
+            }
+
+            *it = node.values.back();
+            node.values.pop_back();
+            --node.count;
+
+            return true;
+        }
+
+        auto it = find_child(node, key[pos]);
+
+        if (it == node.children.end() || key.compare(pos, (*it)->label.size(), (*it)->label) != 0) {
+            return false;
+        }
+
+        if (!erase(**it, key, pos + (*it)->label.size(), handle)) {
+            return false;
+        }
+
+        --node.count;
+
+        // Keep the tree compressed: drop empty subtrees, merge pass-through nodes into their child
+        Node& child = **it;
+
+        if (child.count == 0) {
+            node.children.erase(it);
+        } else if (child.values.empty() && child.children.size() == 1) {
+            std::unique_ptr<Node> grandchild = std::move(child.children.front());
+            grandchild->label.insert(0, child.label);
+            *it = std::move(grandchild);
+        }
+
+        return true;
+    }
+
+    void RadixTree::clear() {
+        root = Node();
+    }
+
+    size_t RadixTree::size() const {
+        return root.count;
+    }
+
+    const std::vector<RadixTree::Handle>* RadixTree::find(const std::string& key) const {
+        const Node* node = &root;
+        size_t pos = 0;
+
+        while (pos < key.size()) {
+            auto it = find_child(*node, key[pos]);
+
+            if (it == node->children.end() || key.compare(pos, (*it)->label.size(), (*it)->label) != 0) {
+                return nullptr;
+            }
+
+            pos += (*it)->label.size();
+            node = it->get();
+        }
+
+        return node->values.empty() ? nullptr : &node->values;
+    }
+
+    const RadixTree::Node* RadixTree::find_prefix_node(const std::string& prefix) const {
+        const Node* node = &root;
+        size_t pos = 0;
+
+        while (pos < prefix.size()) {
+            auto it = find_child(*node, prefix[pos]);
+
+            if (it == node->children.end()) {
+                return nullptr;
+            }
+
+            const std::string& label = (*it)->label;
+            size_t overlap = std::min(label.size(), prefix.size() - pos);
+
+            if (label.compare(0, overlap, prefix, pos, overlap) != 0) {
+                return nullptr;
+            }
+
+            // A prefix ending inside an edge matches the whole subtree below it
+            pos += overlap;
+            node = it->get();
+        }
+
+        return node;
+    }
+
+    size_t RadixTree::count_prefix(const std::string& prefix) const {
+        const Node* node = find_prefix_node(prefix);
+        return node ? node->count : 0;
+    }
+
+    void RadixTree::collect_prefix(const std::string& prefix, size_t limit, std::vector<Handle>& out) const {
+        const Node* node = find_prefix_node(prefix);
+
+        if (!node) {
+            return;
+        }
+
+        size_t wanted = (limit == 0) ? node->count : std::min(limit, node->count);
+        out.reserve(out.size() + wanted);
+
+        collect(*node, out.size() + wanted, out);
+    }
+
+    void RadixTree::collect(const Node& node, size_t limit, std::vector<Handle>& out) {
+        if (out.size() >= limit) {
+            return;
+        }
+
+        // Keys stored here sort before every key in the subtree below
+        if (!node.values.empty()) {
+            size_t first = out.size();
+            size_t take = std::min(node.values.size(), limit - first);
+
+            out.insert(out.end(), node.values.begin(), node.values.end());
+
+            auto comparator = [](Handle a, Handle b) {
+                return student_comparators::compare_by_surname_name_and_phone(*a, *b);
+            };
+
+            std::partial_sort(out.begin() + first, out.begin() + first + take, out.end(), comparator);
+            out.resize(first + take);
+        }
+
+        for (const auto& child : node.children) {
+            if (out.size() >= limit) {
+                return;
+            }
+
+            collect(*child, limit, out);
+        }
+    }
+
+    size_t RadixTree::node_memory(const Node& node) {
+        size_t memory = sizeof(Node) + node.label.capacity();
+        memory += node.children.capacity() * sizeof(std::unique_ptr<Node>);
+        memory += node.values.capacity() * sizeof(Handle);
+
+        for (const auto& child : node.children) {
+            memory += node_memory(*child);
+        }
+
+        return memory;
+    }
+
+    size_t RadixTree::estimate_memory_usage() const {
+        return node_memory(root) - sizeof(Node);
+    }
+}
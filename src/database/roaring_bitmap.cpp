@@ -0,0 +1,458 @@
+#include <algorithm>
+#include <iterator>
+#include <initializer_list>
+
+#include "roaring_bitmap.hpp"
+
+namespace indexing {
+
+    void RoaringBitmap::to_bitmap(Container& container) {
+        container.bits.assign(BITMAP_WORDS, 0);
+
+        for (uint16_t low : container.array) {
+            container.bits[low >> 6] |= uint64_t(1) << (low & 63);
+        }
+
+        std::vector<uint16_t>().swap(container.array);
+    }
+
+    void RoaringBitmap::to_array(Container& container) {
+        container.array.clear();
+        container.array.reserve(container.cardinality);
+
+        for (uint32_t word = 0; word < BITMAP_WORDS; ++word) {
+            uint64_t bits = container.bits[word];
+
+            while (bits) {
+                container.array.push_back(static_cast<uint16_t>(word * 64 + uint32_t(__builtin_ctzll(bits))));
+                bits &= bits - 1;
+            }
+        }
+
+        std::vector<uint64_t>().swap(container.bits);
+    }
+
+    void RoaringBitmap::normalize(Container& container) {
+        if (container.is_bitmap() && container.cardinality <= ARRAY_MAX) {
+            to_array(container);
+        } else if (!container.is_bitmap() && container.cardinality > ARRAY_MAX) {
+            to_bitmap(container);
+        }
+    }
+
+    void RoaringBitmap::append(uint16_t key, Container&& container) {
+        if (container.cardinality == 0) {
+            return;
+        }
+
+        normalize(container);
+        keys.push_back(key);
+        containers.push_back(std::move(container));
+    }
+
+    void RoaringBitmap::add(uint32_t value) {
+        uint16_t key = static_cast<uint16_t>(value >> 16);
+        uint16_t low = static_cast<uint16_t>(value);
+
+        auto key_it = std::lower_bound(keys.begin(), keys.end(), key);
+        size_t index = static_cast<size_t>(key_it - keys.begin());
+
+        if (key_it == keys.end() || *key_it != key) {
+            keys.insert(key_it, key);
+            containers.insert(containers.begin() + static_cast<std::ptrdiff_t>(index), Container());
+        }
+
+        Container& container = containers[index];
+
+        if (container.is_bitmap()) {
+            uint64_t& word = container.bits[low >> 6];
+            uint64_t mask = uint64_t(1) << (low & 63);
+
+            container.cardinality += (word & mask) == 0;
+            word |= mask;
+            return;
+        }
+
+        auto it = std::lower_bound(container.array.begin(), container.array.end(), low);
+
+        if (it != container.array.end() && *it == low) {
+            return;
+        }
+
+        container.array.insert(it, low);
+        container.cardinality++;
+        normalize(container);
+    }
+
+    bool RoaringBitmap::remove(uint32_t value) {
+        uint16_t key = static_cast<uint16_t>(value >> 16);
+        uint16_t low = static_cast<uint16_t>(value);
+
+        auto key_it = std::lower_bound(keys.begin(), keys.end(), key);
+
+        if (key_it == keys.end() || *key_it != key) {
+            return false;
+        }
+
+        size_t index = static_cast<size_t>(key_it - keys.begin());
+        Container& container = containers[index];
+
+        if (container.is_bitmap()) {
+            uint64_t& word = container.bits[low >> 6];
+            uint64_t mask = uint64_t(1) << (low & 63);
+
+            if ((word & mask) == 0) {
+                return false;
+            }
+
+            word &= ~mask;
+        } else {
+            auto it = std::lower_bound(container.array.begin(), container.array.end(), low);
+
+            if (it == container.array.end() || *it != low) {
+                return false;
+            }
+
+            container.array.erase(it);
+        }
+
+        if (--container.cardinality == 0) {
+            keys.erase(key_it);
+            containers.erase(containers.begin() + static_cast<std::ptrdiff_t>(index));
+        } else {
+            normalize(container);
+        }
+
+        return true;
+    }
+
+    bool RoaringBitmap::contains(uint32_t value) const {
+        uint16_t key = static_cast<uint16_t>(value >> 16);
+        uint16_t low = static_cast<uint16_t>(value);
+
+        auto key_it = std::lower_bound(keys.begin(), keys.end(), key);
+
+        if (key_it == keys.end() || *key_it != key) {
+            return false;
+        }
+
+        const Container& container = containers[static_cast<size_t>(key_it - keys.begin())];
+
+        if (container.is_bitmap()) {
+            return (container.bits[low >> 6] >> (low & 63)) & 1;
+        }
+
+        return std::binary_search(container.array.begin(), container.array.end(), low);
+    }
+
+    uint64_t RoaringBitmap::cardinality() const {
+        uint64_t total = 0;
+
+        for (const Container& container : containers) {
+            total += container.cardinality;
+        }
+
+        return total;
+    }
+
+    bool RoaringBitmap::empty() const {
+        return containers.empty();
+    }
+
+    void RoaringBitmap::clear() {
+        keys.clear();
+        containers.clear();
+    }
+
+    // Container kernels: array x array merges, bitmap x bitmap works word by word,
+    // mixed pairs probe the bitmap once per array value
+
+    RoaringBitmap::Container RoaringBitmap::intersect(const Container& a, const Container& b) {
+        Container result;
+
+        if (a.is_bitmap() && b.is_bitmap()) {
+            result.bits.resize(BITMAP_WORDS);
+
+            for (uint32_t word = 0; word < BITMAP_WORDS; ++word) {
+                result.bits[word] = a.bits[word] & b.bits[word];
+                result.cardinality += uint32_t(__builtin_popcountll(result.bits[word]));
+            }
+        } else if (a.is_bitmap() || b.is_bitmap()) {
+            const Container& array = a.is_bitmap() ? b : a;
+            const Container& bitmap = a.is_bitmap() ? a : b;
+
+            for (uint16_t low : array.array) {
+                if ((bitmap.bits[low >> 6] >> (low & 63)) & 1) {
+                    result.array.push_back(low);
+                }
+            }
+
+            result.cardinality = static_cast<uint32_t>(result.array.size());
+        } else {
+            std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                                  std::back_inserter(result.array));
+            result.cardinality = static_cast<uint32_t>(result.array.size());
+        }
+
+        return result;
+    }
+
+    RoaringBitmap::Container RoaringBitmap::unite(const Container& a, const Container& b) {
+        Container result;
+
+        if (!a.is_bitmap() && !b.is_bitmap() && a.cardinality + b.cardinality <= ARRAY_MAX) {
+            std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                           std::back_inserter(result.array));
+            result.cardinality = static_cast<uint32_t>(result.array.size());
+            return result;
+        }
+
+        result.bits.assign(BITMAP_WORDS, 0);
+
+        for (const Container* source : {&a, &b}) {
+            if (source->is_bitmap()) {
+                for (uint32_t word = 0; word < BITMAP_WORDS; ++word) {
+                    result.bits[word] |= source->bits[word];
+                }
+            } else {
+                for (uint16_t low : source->array) {
+                    result.bits[low >> 6] |= uint64_t(1) << (low & 63);
+                }
+            }
+        }
+
+        for (uint64_t word : result.bits) {
+            result.cardinality += uint32_t(__builtin_popcountll(word));
+        }
+
+        return result;
+    }
+
+    RoaringBitmap::Container RoaringBitmap::subtract(const Container& a, const Container& b) {
+        Container result;
+
+        if (a.is_bitmap()) {
+            result.bits = a.bits;
+
+            if (b.is_bitmap()) {
+                for (uint32_t word = 0; word < BITMAP_WORDS; ++word) {
+                    result.bits[word] &= ~b.bits[word];
+                }
+            } else {
+                for (uint16_t low : b.array) {
+                    result.bits[low >> 6] &= ~(uint64_t(1) << (low & 63));
+                }
+            }
+
+            for (uint64_t word : result.bits) {
+                result.cardinality += uint32_t(__builtin_popcountll(word));
+            }
+        } else if (b.is_bitmap()) {
+            for (uint16_t low : a.array) {
+                if (!((b.bits[low >> 6] >> (low & 63)) & 1)) {
+                    result.array.push_back(low);
+                }
+            }
+
+            result.cardinality = static_cast<uint32_t>(result.array.size());
+        } else {
+            std::set_difference(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                                std::back_inserter(result.array));
+            result.cardinality = static_cast<uint32_t>(result.array.size());
+        }
+
+        return result;
+    }
+
+    uint32_t RoaringBitmap::intersect_cardinality(const Container& a, const Container& b) {
+        uint32_t count = 0;
+
+        if (a.is_bitmap() && b.is_bitmap()) {
+            for (uint32_t word = 0; word < BITMAP_WORDS; ++word) {
+                count += uint32_t(__builtin_popcountll(a.bits[word] & b.bits[word]));
+            }
+        } else if (a.is_bitmap() || b.is_bitmap()) {
+            const Container& array = a.is_bitmap() ? b : a;
+            const Container& bitmap = a.is_bitmap() ? a : b;
+
+            for (uint16_t low : array.array) {
+                count += (bitmap.bits[low >> 6] >> (low & 63)) & 1;
+            }
+        } else {
+            auto i = a.array.begin();
+            auto j = b.array.begin();
+
+            while (i != a.array.end() && j != b.array.end()) {
+                if (*i < *j) {
+                    ++i;
+                } else if (*j < *i) {
+                    ++j;
+                } else {
+                    ++count;
+                    ++i;
+                    ++j;
+                }
+            }
+        }
+
+        return count;
+    }
+
+    bool RoaringBitmap::intersects(const Container& a, const Container& b) {
+        if (a.is_bitmap() && b.is_bitmap()) {
+            for (uint32_t word = 0; word < BITMAP_WORDS; ++word) {
+                if (a.bits[word] & b.bits[word]) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        if (a.is_bitmap() || b.is_bitmap()) {
+            const Container& array = a.is_bitmap() ? b : a;
+            const Container& bitmap = a.is_bitmap() ? a : b;
+
+            for (uint16_t low : array.array) {
+                if ((bitmap.bits[low >> 6] >> (low & 63)) & 1) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        auto i = a.array.begin();
+        auto j = b.array.begin();
+
+        while (i != a.array.end() && j != b.array.end()) {
+            if (*i < *j) {
+                ++i;
+            } else if (*j < *i) {
+                ++j;
+            } else {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Bitmap-level operations walk both sorted key lists in step, like a merge
+
+    RoaringBitmap RoaringBitmap::intersect(const RoaringBitmap& a, const RoaringBitmap& b) {
+        RoaringBitmap result;
+        size_t i = 0, j = 0;
+
+        while (i < a.keys.size() && j < b.keys.size()) {
+            if (a.keys[i] < b.keys[j]) {
+                ++i;
+            } else if (b.keys[j] < a.keys[i]) {
+                ++j;
+            } else {
+                result.append(a.keys[i], intersect(a.containers[i], b.containers[j]));
+                ++i;
+                ++j;
+            }
+        }
+
+        return result;
+    }
+
+    RoaringBitmap RoaringBitmap::unite(const RoaringBitmap& a, const RoaringBitmap& b) {
+        RoaringBitmap result;
+        size_t i = 0, j = 0;
+
+        while (i < a.keys.size() || j < b.keys.size()) {
+            if (j == b.keys.size() || (i < a.keys.size() && a.keys[i] < b.keys[j])) {
+                result.keys.push_back(a.keys[i]);
+                result.containers.push_back(a.containers[i]);
+                ++i;
+            } else if (i == a.keys.size() || b.keys[j] < a.keys[i]) {
+                result.keys.push_back(b.keys[j]);
+                result.containers.push_back(b.containers[j]);
+                ++j;
+            } else {
+                result.append(a.keys[i], unite(a.containers[i], b.containers[j]));
+                ++i;
+                ++j;
+            }
+        }
+
+        return result;
+    }
+
+    RoaringBitmap RoaringBitmap::subtract(const RoaringBitmap& a, const RoaringBitmap& b) {
+        RoaringBitmap result;
+        size_t j = 0;
+
+        for (size_t i = 0; i < a.keys.size(); ++i) {
+            while (j < b.keys.size() && b.keys[j] < a.keys[i]) {
+                ++j;
+            }
+
+            if (j < b.keys.size() && b.keys[j] == a.keys[i]) {
+                result.append(a.keys[i], subtract(a.containers[i], b.containers[j]));
+            } else {
+                result.keys.push_back(a.keys[i]);
+                result.containers.push_back(a.containers[i]);
+            }
+        }
+
+        return result;
+    }
+
+    uint64_t RoaringBitmap::intersect_cardinality(const RoaringBitmap& a, const RoaringBitmap& b) {
+        uint64_t count = 0;
+        size_t i = 0, j = 0;
+
+        while (i < a.keys.size() && j < b.keys.size()) {
+            if (a.keys[i] < b.keys[j]) {
+                ++i;
+            } else if (b.keys[j] < a.keys[i]) {
+                ++j;
+            } else {
+                count += intersect_cardinality(a.containers[i], b.containers[j]);
+                ++i;
+                ++j;
+            }
+        }
+
+        return count;
+    }
+
+    bool RoaringBitmap::intersects(const RoaringBitmap& a, const RoaringBitmap& b) {
+        size_t i = 0, j = 0;
+
+        while (i < a.keys.size() && j < b.keys.size()) {
+            if (a.keys[i] < b.keys[j]) {
+                ++i;
+            } else if (b.keys[j] < a.keys[i]) {
+                ++j;
+            } else {
+                if (intersects(a.containers[i], b.containers[j])) {
+                    return true;
+                }
+
+                ++i;
+                ++j;
+            }
+        }
+
+        return false;
+    }
+
+    size_t RoaringBitmap::estimate_memory_usage() const {
+        size_t memory = sizeof(RoaringBitmap);
+
+        memory += keys.capacity() * sizeof(uint16_t);
+        memory += containers.capacity() * sizeof(Container);
+
+        for (const Container& container : containers) {
+            memory += container.array.capacity() * sizeof(uint16_t);
+            memory += container.bits.capacity() * sizeof(uint64_t);
+        }
+
+        return memory;
+    }
+}
@@ -1,47 +1,79 @@
 #include <iostream>
+#include <chrono>
+#include <iomanip>
 #include <string>
+#include <stdexcept>
 #include <cstring>
+#include <cctype>
+#include <limits>
 #include <unordered_map>
 #include <algorithm>
+#include <thread>
 #include <vector>
 
 #include "database.hpp"
 #include "student.hpp"
 #include "csv_handler.hpp"
 #include "sorting.hpp"
+#include "external_sort.hpp"
 #include "benchmark.hpp"
+#include "static_driver.hpp"
 
 void print_usage(const char* program_name) {
     std::cout << "Usage: " << program_name << " [mode] [arguments]\n\n";
     std::cout << "Benchmark Modes:\n";
     std::cout << "  benchmark            Complete benchmark suite (default)\n";
-    std::cout << "  operations           Database operations benchmark\n";
-    std::cout << "  sorting              Sorting algorithms benchmark\n\n";
+    std::cout << "  operations [--views] [--static]\n";
+    std::cout << "                       Database operations benchmark\n";
+    std::cout << "                       --views: Op2/Op3 through the zero-copy view API\n";
+    std::cout << "                       --static: call the concrete engines without virtual dispatch\n";
+    std::cout << "  sorting              Sorting algorithms benchmark\n";
+    std::cout << "  presorted            Sorting on sorted, reversed and k-perturbed inputs\n";
+    std::cout << "  name-sort            Surname + name sorting: std::sort vs multikey quicksort\n";
+    std::cout << "  batched [seconds]    Batched operations benchmark (batch sizes 1, 16, 256)\n";
+    std::cout << "  queries [seconds]    Read-only query benchmark (prefix, range, top-K)\n";
+    std::cout << "  bitmap [seconds]     Bitmap set-algebra queries vs Hybrid indices\n";
+    std::cout << "  load [rows...]       Per-row add vs bulk build load times (default: 100000 1000000)\n";
+    std::cout << "  mapped [rows] [file] Build a memory-mapped database, time reopening it vs parsing CSV\n";
+    std::cout << "                       (default: 200000 results/students.map)\n";
+    std::cout << "  dispatch [ops]       Virtual vs static dispatch overhead (default: 10000 ops)\n";
+    std::cout << "  stress [readers] [writers] [seconds]\n";
+    std::cout << "                       Concurrent engine stress test (default: 4 2 5)\n\n";
     std::cout << "Operation Modes:\n";
     std::cout << "  change-group <phone> <new_group>\n";
     std::cout << "                       Change student's group by phone\n";
     std::cout << "  get-group <group>    Get students from group (sorted)\n";
     std::cout << "  get-surname <surname>\n";
     std::cout << "                       Get groups by surname\n";
-    std::cout << "  sort-rating [output] [algorithm]\n";
+    std::cout << "  sort-rating [output] [algorithm] [--keyed] [--threads N]\n";
     std::cout << "                       Sort by rating and save\n";
     std::cout << "                       Output: results/sorted_output.csv (default)\n";
     std::cout << "                       Algorithms: std, bubble, insertion, selection,\n";
-    std::cout << "                                   merge, quick, heap, radix\n";
-    std::cout << "                       Default algorithm: quick\n";
+    std::cout << "                                   merge, quick, heap, radix,\n";
+    std::cout << "                                   tim, parallel-merge\n";
+    std::cout << "                       Default algorithm: quick (pattern-defeating quicksort)\n";
+    std::cout << "                       --keyed: sort (rating, index) pairs, then move\n";
+    std::cout << "                                each record once (not for radix)\n";
+    std::cout << "                       --threads N: parallel-merge threads (default: all cores)\n";
+    std::cout << "  sort-rating [output] --external [--mem-budget SIZE] [--input CSV]\n";
+    std::cout << "                       External merge sort: stream the CSV in chunks of at most\n";
+    std::cout << "                       SIZE bytes (K/M/G suffix, default 64M), spill sorted runs\n";
+    std::cout << "                       to temporary files and merge them into the output\n";
+    std::cout << "                       Input: data/students.csv (default)\n";
     std::cout << "  help                 Show this help\n";
 }
 
 
 
-void run_operations_benchmark_mode() {
-    std::cout << "Database Operations Benchmark (V3: 5:10:100)\n";
+void run_operations_benchmark_mode(bool use_views = false, bool static_dispatch = false) {
+    std::cout << "Database Operations Benchmark (V3: 5:10:100)" << (use_views ? " [views]" : "")
+              << (static_dispatch ? " [static]" : "") << "\n";
     std::cout << "Containers: vector, unordered_map, map\n";
     std::cout << "Sizes: 100, 1000, 10000, 100000\n";
     std::cout << "Duration: 10s per test\n\n";
     
     std::vector<size_t> data_sizes = {100, 1000, 10000, 100000};
-    auto results = benchmark::run_all_operations_benchmarks(data_sizes, 10.0);
+    auto results = benchmark::run_all_operations_benchmarks(data_sizes, 10.0, use_views, static_dispatch);
     
     // benchmark::print_operation_results(results);
     benchmark::save_operation_results(results, "results/operations_benchmark.csv");
@@ -51,7 +83,10 @@ void run_operations_benchmark_mode() {
 
 void run_sorting_benchmark_mode() {
     std::cout << "Sorting Algorithms Benchmark (S2: rating)\n";
-    std::cout << "Algorithms: std::sort, bubble, insertion, selection, merge, quick, heap, radix\n";
+    std::cout << "Algorithms: std::sort, bubble, insertion, selection, merge, quick, heap,\n";
+    std::cout << "            tim, parallel merge, radix\n";
+    std::cout << "Each algorithm runs with a std::function comparator, as a template ([template])\n";
+    std::cout << "and on (rating, index) pairs followed by one permutation pass ([keyed])\n";
     std::cout << "Note: O(n^2) algorithms tested only on n <= 10000\n\n";
     
     std::vector<Student> full_data = csv::read_csv("data/students.csv");
@@ -63,16 +98,208 @@ void run_sorting_benchmark_mode() {
         
         std::cout << "\n=== Testing with data size: " << size << " ===\n";
         std::vector<Student> subset(full_data.begin(), full_data.begin() + size);
-        auto results = benchmark::run_sorting_benchmarks(subset, student_comparators::compare_by_rating);
+        auto results = benchmark::run_sorting_benchmarks(subset, [](const Student& a, const Student& b) {
+            return a.m_rating < b.m_rating;
+        });
         all_results.insert(all_results.end(), results.begin(), results.end());
     }
     
     benchmark::print_sort_results(all_results);
+    
+    // Thread scaling of the parallel merge sort on the full data set
+    size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < hardware_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(hardware_threads);
+    
+    std::cout << "\n=== Parallel merge sort thread scaling: " << full_data.size() << " records ===\n";
+    auto scaling = benchmark::run_parallel_scaling_benchmark(full_data, [](const Student& a, const Student& b) {
+        return a.m_rating < b.m_rating;
+    }, thread_counts);
+    
+    std::cout << "\n" << std::left << std::setw(10) << "Threads" << std::setw(15) << "Time (ms)" << "Speedup\n";
+    for (size_t i = 0; i < scaling.size(); ++i) {
+        std::cout << std::setw(10) << thread_counts[i] << std::setw(15) << std::fixed << std::setprecision(3)
+                  << scaling[i].execution_time_ms << std::setprecision(2)
+                  << scaling.front().execution_time_ms / scaling[i].execution_time_ms << "x\n";
+    }
+    
+    all_results.insert(all_results.end(), scaling.begin(), scaling.end());
     benchmark::save_sort_results(all_results, "results/sorting_benchmark.csv");
     
     std::cout << "\nOutput: results/sorting_benchmark.csv\n";
 }
 
+void run_presorted_benchmark_mode() {
+    std::cout << "Sorting Benchmark on Presorted Inputs (S2: rating)\n";
+    std::cout << "Inputs: random, sorted, reversed, sorted with n/100 random swaps\n";
+    std::cout << "Algorithms (template variants): std::sort, merge, quick, tim, radix\n\n";
+    
+    std::vector<Student> full_data = csv::read_csv("data/students.csv");
+    std::vector<size_t> data_sizes = {10000, 100000, 200000};
+    std::vector<benchmark::SortBenchmarkResult> all_results;
+    
+    for (size_t size : data_sizes) {
+        if (size > full_data.size()) continue;
+        
+        std::cout << "\n=== Testing with data size: " << size << " ===\n";
+        std::vector<Student> subset(full_data.begin(), full_data.begin() + size);
+        auto results = benchmark::run_presorted_benchmarks(subset, [](const Student& a, const Student& b) {
+            return a.m_rating < b.m_rating;
+        });
+        all_results.insert(all_results.end(), results.begin(), results.end());
+    }
+    
+    benchmark::print_sort_results(all_results);
+    benchmark::save_sort_results(all_results, "results/presorted_benchmark.csv");
+    
+    std::cout << "\nOutput: results/presorted_benchmark.csv\n";
+}
+
+void run_name_sort_benchmark_mode() {
+    std::cout << "Surname + Name Sorting Benchmark (Op2 ordering)\n";
+    std::cout << "std::sort + compare_by_surname_and_name vs multikey quicksort\n";
+    std::cout << "Sizes: one group, 10000, 100000, 200000\n\n";
+    
+    std::vector<Student> full_data = csv::read_csv("data/students.csv");
+    std::vector<benchmark::SortBenchmarkResult> all_results;
+    
+    if (full_data.empty()) {
+        return;
+    }
+    
+    // A real Op2 input: every student of the first record's group
+    std::vector<Student> group;
+    for (const auto& student : full_data) {
+        if (student.m_group == full_data.front().m_group) {
+            group.push_back(student);
+        }
+    }
+    
+    std::cout << "\n=== Testing with group " << full_data.front().m_group << ": " << group.size() << " ===\n";
+    auto group_results = benchmark::run_name_sort_benchmarks(group);
+    all_results.insert(all_results.end(), group_results.begin(), group_results.end());
+    
+    for (size_t size : {10000, 100000, 200000}) {
+        if (size > full_data.size()) continue;
+        
+        std::cout << "\n=== Testing with data size: " << size << " ===\n";
+        std::vector<Student> subset(full_data.begin(), full_data.begin() + size);
+        auto results = benchmark::run_name_sort_benchmarks(subset);
+        all_results.insert(all_results.end(), results.begin(), results.end());
+    }
+    
+    benchmark::print_sort_results(all_results);
+    benchmark::save_sort_results(all_results, "results/name_sort_benchmark.csv");
+    
+    std::cout << "\nOutput: results/name_sort_benchmark.csv\n";
+}
+
+void run_batched_benchmark_mode(double seconds) {
+    std::cout << "Batched Operations Benchmark (V3: 5:10:100)\n";
+    std::cout << "Batch sizes: 1, 16, 256\n";
+    std::cout << "Sizes: 1000, 10000, 100000\n";
+    std::cout << "Duration: " << seconds << "s per test\n\n";
+    
+    std::vector<size_t> data_sizes = {1000, 10000, 100000};
+    std::vector<size_t> batch_sizes = {1, 16, 256};
+    auto results = benchmark::run_all_batched_benchmarks(data_sizes, batch_sizes, seconds);
+    
+    benchmark::print_operation_results(results);
+    benchmark::save_operation_results(results, "results/batched_benchmark.csv");
+    
+    std::cout << "\nOutput: results/batched_benchmark.csv\n";
+}
+
+void run_query_benchmark_mode(double seconds) {
+    std::cout << "Query Benchmark (surname type-ahead, rating / birth date ranges, top-K by rating)\n";
+    std::cout << "Containers: vector (scan), hybrid (scan), indexed (radix tree + ordered indices)\n";
+    std::cout << "Sizes: 1000, 10000, 100000\n";
+    std::cout << "Duration: " << seconds << "s per query\n\n";
+    
+    std::vector<size_t> data_sizes = {1000, 10000, 100000};
+    auto results = benchmark::run_all_query_benchmarks(data_sizes, seconds);
+    
+    benchmark::print_query_results(results);
+    benchmark::save_query_results(results, "results/query_benchmark.csv");
+    
+    std::cout << "\nOutput: results/query_benchmark.csv\n";
+}
+
+void run_bitmap_benchmark_mode(double seconds) {
+    std::cout << "Bitmap Query Benchmark (Op3 and group / surname AND, OR, ANDNOT filters)\n";
+    std::cout << "Containers: hybrid (group vectors + surname multimap), bitmap (roaring bitmaps)\n";
+    std::cout << "Sizes: 10000, 100000\n";
+    std::cout << "Duration: " << seconds << "s per query\n\n";
+    
+    std::vector<size_t> data_sizes = {10000, 100000};
+    auto results = benchmark::run_all_bitmap_query_benchmarks(data_sizes, seconds);
+    
+    benchmark::print_query_results(results);
+    benchmark::save_query_results(results, "results/bitmap_benchmark.csv");
+    
+    std::cout << "\nOutput: results/bitmap_benchmark.csv\n";
+}
+
+void run_load_benchmark_mode(const std::vector<size_t>& data_sizes) {
+    std::cout << "Load Benchmark (per-row add vs bulk build)\n";
+    std::cout << "Containers: map, hybrid\n";
+    std::cout << "Sizes:";
+    for (size_t size : data_sizes) {
+        std::cout << " " << size;
+    }
+    std::cout << "\n\n";
+    
+    auto results = benchmark::run_all_load_benchmarks(data_sizes);
+    
+    benchmark::print_load_results(results);
+    benchmark::save_load_results(results, "results/load_benchmark.csv");
+    
+    std::cout << "\nOutput: results/load_benchmark.csv\n";
+}
+
+void run_mapped_benchmark_mode(size_t rows, const std::string& file_path) {
+    std::cout << "Mapped Database Benchmark (build, reopen, first query)\n";
+    std::cout << "Rows: " << rows << "\n\n";
+    
+    auto result = benchmark::run_mapped_open_benchmark(file_path, rows);
+    benchmark::print_mapped_open_result(result);
+}
+
+void run_dispatch_benchmark_mode(size_t script_length) {
+    std::cout << "Dispatch Overhead Benchmark (V3: 5:10:100, same script through the vtable and the concrete type)\n";
+    std::cout << "Sizes: 100, 1000, 10000\n";
+    std::cout << "Script: " << script_length << " operations, best of 3 rounds\n\n";
+    
+    std::vector<size_t> data_sizes = {100, 1000, 10000};
+    auto results = benchmark::run_all_dispatch_benchmarks(data_sizes, script_length, 3);
+    
+    benchmark::print_dispatch_results(results);
+    benchmark::save_dispatch_results(results, "results/dispatch_benchmark.csv");
+    
+    std::cout << "\nOutput: results/dispatch_benchmark.csv\n";
+}
+
+int run_stress_mode(size_t readers, size_t writers, double seconds) {
+    std::cout << "Concurrent Stress Test (RCU read path)\n";
+    std::cout << "Readers: " << readers << ", Writers: " << writers << ", Duration: " << seconds << "s\n\n";
+    
+    std::vector<Student> full_data = csv::read_csv("data/students.csv");
+    if (full_data.empty()) {
+        return 1;
+    }
+    
+    std::vector<Student> subset(full_data.begin(), full_data.begin() + std::min<size_t>(10000, full_data.size()));
+    DatabaseConcurrent db(subset);
+    
+    auto result = benchmark::run_concurrent_stress_test(db, readers, writers, seconds);
+    benchmark::print_stress_results(result);
+    
+    return result.violations == 0 ? 0 : 1;
+}
+
 void run_benchmark_mode() {
     run_operations_benchmark_mode();
 
@@ -102,12 +329,13 @@ void run_change_group(IStudentDatabase* db, const std::string& phone, const std:
 }
 
 void run_get_group(IStudentDatabase* db, const std::string& group) {
-    auto students = db->get_students_by_group_sorted(group);
+    std::vector<const Student*> students;
+    db->view_students_by_group_sorted(group, students);
 
     std::cout << "Group '" << group << "': " << students.size() << " students\n";
 
-    for (const auto& s : students) {
-        std::cout << "  " << s.m_surname << " " << s.m_name << " (rating: " << s.m_rating << ")\n";
+    for (const Student* s : students) {
+        std::cout << "  " << s->m_surname << " " << s->m_name << " (rating: " << s->m_rating << ")\n";
     }
 }
 
@@ -121,8 +349,38 @@ void run_get_surname(IStudentDatabase* db, const std::string& surname) {
     }
 }
 
-void run_sort_rating(IStudentDatabase* db, const std::string& output, const std::string& algorithm) {
+void run_sort_rating(IStudentDatabase* db, const std::string& output, const std::string& algorithm, bool keyed,
+                     size_t threads) {
     using SortFunc = std::function<void(std::vector<Student>&, std::function<bool(const Student&, const Student&)>)>;
+    using sort_algorithms::Algorithm;
+    
+    if (keyed) {
+        static const std::unordered_map<std::string, Algorithm> keyed_algorithms = {
+            {"std", Algorithm::Std},
+            {"bubble", Algorithm::Bubble},
+            {"insertion", Algorithm::Insertion},
+            {"selection", Algorithm::Selection},
+            {"merge", Algorithm::Merge},
+            {"quick", Algorithm::Quick},
+            {"heap", Algorithm::Heap},
+            {"tim", Algorithm::Tim},
+            {"parallel-merge", Algorithm::ParallelMerge}
+        };
+        
+        auto it = keyed_algorithms.find(algorithm);
+        if (it == keyed_algorithms.end()) {
+            std::cerr << "Error: No keyed variant of algorithm '" << algorithm << "'\n";
+            return;
+        }
+        
+        if (db->sort_by_rating_keyed_and_save(output, true, it->second, threads)) {
+            std::cout << "Sorted " << db->size() << " students by rating using " << algorithm << " [keyed]\n";
+            std::cout << "Output: " << output << "\n";
+        } else {
+            std::cerr << "Error: Failed to save to " << output << "\n";
+        }
+        return;
+    }
     
     static const std::unordered_map<std::string, SortFunc> algorithms = {
         {"std", sort_algorithms::std_sort},
@@ -132,7 +390,11 @@ void run_sort_rating(IStudentDatabase* db, const std::string& output, const std:
         {"merge", sort_algorithms::merge_sort},
         {"quick", sort_algorithms::quick_sort},
         {"heap", sort_algorithms::heap_sort},
-        {"radix", sort_algorithms::radix_sort_by_rating}
+        {"tim", sort_algorithms::tim_sort},
+        {"radix", sort_algorithms::radix_sort_by_rating},
+        {"parallel-merge", [](std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator) {
+            sort_algorithms::parallel_merge_sort(data, comparator);
+        }}
     };
     
     auto it = algorithms.find(algorithm);
@@ -141,7 +403,15 @@ void run_sort_rating(IStudentDatabase* db, const std::string& output, const std:
         return;
     }
     
-    if (db->sort_by_rating_and_save(output, it->second, true)) {
+    SortFunc sort_func = it->second;
+    if (algorithm == "parallel-merge" && threads > 0) {
+        sort_func = [threads](std::vector<Student>& data,
+                              std::function<bool(const Student&, const Student&)> comparator) {
+            sort_algorithms::parallel_merge_sort(data, comparator, threads);
+        };
+    }
+    
+    if (db->sort_by_rating_and_save(output, sort_func, true)) {
         std::cout << "Sorted " << db->size() << " students by rating using " << algorithm << "\n";
         std::cout << "Output: " << output << "\n";
     } else {
@@ -149,6 +419,61 @@ void run_sort_rating(IStudentDatabase* db, const std::string& output, const std:
     }
 }
 
+// Byte count with an optional K / M / G suffix (powers of 1024)
+size_t parse_size(const std::string& text) {
+    // std::stoull accepts (and wraps) a leading minus sign
+    if (text.empty() || !std::isdigit(static_cast<unsigned char>(text[0]))) {
+        throw std::invalid_argument("size must start with a digit");
+    }
+
+    size_t end = 0;
+    unsigned long long parsed = std::stoull(text, &end);  // Throws std::out_of_range on overflow
+    std::string suffix = text.substr(end);
+    unsigned shift = 0;
+
+    if (suffix == "K" || suffix == "k") {
+        shift = 10;
+    } else if (suffix == "M" || suffix == "m") {
+        shift = 20;
+    } else if (suffix == "G" || suffix == "g") {
+        shift = 30;
+    } else if (!suffix.empty()) {
+        throw std::invalid_argument("unknown size suffix '" + suffix + "'");
+    }
+
+    if (parsed > (std::numeric_limits<size_t>::max() >> shift)) {
+        throw std::out_of_range("size '" + text + "' overflows");
+    }
+
+    return static_cast<size_t>(parsed) << shift;
+}
+
+int run_external_sort_rating(const std::string& input, const std::string& output, size_t memory_budget) {
+    external_sort::Options options;
+    options.memory_budget = memory_budget;
+
+    external_sort::Stats stats;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    bool ok = external_sort::sort_csv_by_rating(input, output, options, &stats);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    if (!ok) {
+        std::cerr << "Error: External sort of " << input << " failed\n";
+        return 1;
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << "Sorted " << stats.records << " students by rating using external merge sort\n";
+    std::cout << "Memory budget: " << (memory_budget >> 10) << " KiB, runs: " << stats.runs
+              << ", merge passes: " << stats.merge_passes << ", fan-in: " << stats.fan_in << "\n";
+    std::cout << "Time: " << std::fixed << std::setprecision(1) << ms << " ms\n";
+    std::cout << "Output: " << output << "\n";
+
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     std::string mode = "benchmark";
     
@@ -164,11 +489,88 @@ int main(int argc, char* argv[]) {
         run_benchmark_mode();
         return 0;
     } else if (mode == "operations") {
-        run_operations_benchmark_mode();
+        bool use_views = false;
+        bool static_dispatch = false;
+        
+        for (int i = 2; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--views") == 0) {
+                use_views = true;
+            } else if (std::strcmp(argv[i], "--static") == 0) {
+                static_dispatch = true;
+            }
+        }
+        
+        run_operations_benchmark_mode(use_views, static_dispatch);
         return 0;
     } else if (mode == "sorting") {
         run_sorting_benchmark_mode();
         return 0;
+    } else if (mode == "presorted") {
+        run_presorted_benchmark_mode();
+        return 0;
+    } else if (mode == "name-sort") {
+        run_name_sort_benchmark_mode();
+        return 0;
+    } else if (mode == "batched") {
+        run_batched_benchmark_mode(argc >= 3 ? std::stod(argv[2]) : 5.0);
+        return 0;
+    } else if (mode == "queries") {
+        run_query_benchmark_mode(argc >= 3 ? std::stod(argv[2]) : 2.0);
+        return 0;
+    } else if (mode == "bitmap") {
+        run_bitmap_benchmark_mode(argc >= 3 ? std::stod(argv[2]) : 2.0);
+        return 0;
+    } else if (mode == "load") {
+        std::vector<size_t> data_sizes;
+        for (int i = 2; i < argc; ++i) {
+            data_sizes.push_back(std::stoul(argv[i]));
+        }
+        if (data_sizes.empty()) {
+            data_sizes = {100000, 1000000};
+        }
+        run_load_benchmark_mode(data_sizes);
+        return 0;
+    } else if (mode == "mapped") {
+        run_mapped_benchmark_mode(argc >= 3 ? std::stoul(argv[2]) : 200000,
+                                  argc >= 4 ? argv[3] : "results/students.map");
+        return 0;
+    } else if (mode == "dispatch") {
+        run_dispatch_benchmark_mode(argc >= 3 ? std::stoul(argv[2]) : 10000);
+        return 0;
+    } else if (mode == "stress") {
+        size_t readers = argc >= 3 ? std::stoul(argv[2]) : 4;
+        size_t writers = argc >= 4 ? std::stoul(argv[3]) : 2;
+        double seconds = argc >= 5 ? std::stod(argv[4]) : 5.0;
+        return run_stress_mode(readers, writers, seconds);
+    } else if (mode == "sort-rating" && std::find_if(argv + 2, argv + argc, [](const char* arg) {
+                   return std::strcmp(arg, "--external") == 0;
+               }) != argv + argc) {
+        std::string input = "data/students.csv";
+        std::string output = "results/sorted_output.csv";
+        size_t memory_budget = external_sort::Options().memory_budget;
+        
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--external") {
+                continue;
+            } else if ((arg == "--mem-budget" || arg == "--input") && i + 1 >= argc) {
+                std::cerr << "Error: " << arg << " requires a value\n";
+                return 1;
+            } else if (arg == "--mem-budget") {
+                try {
+                    memory_budget = parse_size(argv[++i]);
+                } catch (const std::exception&) {
+                    std::cerr << "Error: Invalid memory budget '" << argv[i] << "'\n";
+                    return 1;
+                }
+            } else if (arg == "--input") {
+                input = argv[++i];
+            } else {
+                output = arg;
+            }
+        }
+        
+        return run_external_sort_rating(input, output, memory_budget);
     }
     
     IStudentDatabase* db = load_database("data/students.csv");
@@ -201,20 +603,35 @@ int main(int argc, char* argv[]) {
         run_get_surname(db, argv[2]);
         
     } else if (mode == "sort-rating") {
-        std::string output = argc >= 3 ? argv[2] : "results/sorted_output.csv";
-        std::string algorithm = argc >= 4 ? argv[3] : "quick";
+        bool keyed = false;
+        size_t threads = 0;
+        std::vector<std::string> args;
+        
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--keyed") {
+                keyed = true;
+            } else if (arg == "--threads" && i + 1 < argc) {
+                threads = std::stoul(argv[++i]);
+            } else {
+                args.push_back(arg);
+            }
+        }
+        
+        std::string output = args.size() >= 1 ? args[0] : "results/sorted_output.csv";
+        std::string algorithm = args.size() >= 2 ? args[1] : "quick";
         
-        if (argc == 3) {
+        if (args.size() == 1) {
             static const std::vector<std::string> known_algorithms = {
-                "std", "bubble", "insertion", "selection", "merge", "quick", "heap", "radix"
+                "std", "bubble", "insertion", "selection", "merge", "quick", "heap", "tim", "radix", "parallel-merge"
             };
-            if (std::find(known_algorithms.begin(), known_algorithms.end(), argv[2]) != known_algorithms.end()) {
-                algorithm = argv[2];
+            if (std::find(known_algorithms.begin(), known_algorithms.end(), args[0]) != known_algorithms.end()) {
+                algorithm = args[0];
                 output = "results/sorted_output.csv";
             }
         }
         
-        run_sort_rating(db, output, algorithm);
+        run_sort_rating(db, output, algorithm, keyed, threads);
         
     } else {
         std::cerr << "Error: Invalid mode '" << mode << "'\n\n";
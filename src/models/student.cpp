@@ -1,3 +1,5 @@
+#include <cmath>
+
 #include "student.hpp"
 
 // Constructors
@@ -17,6 +19,10 @@ std::string Student::get_full_name() const {
     return m_surname + " " + m_name;
 }
 
+int Student::get_packed_birth_date() const {
+    return m_birth_year * 10000 + m_birth_month * 100 + m_birth_day;
+}
+
 // Comparison functions
 namespace student_comparators {
     // Compare by surname and name (alphabetically)
@@ -28,6 +34,57 @@ namespace student_comparators {
         return a.m_name < b.m_name;
     }
     
+    bool compare_ptr_by_surname_and_name(const Student* a, const Student* b) {
+        return compare_by_surname_and_name(*a, *b);
+    }
+    
+    bool compare_by_surname_name_and_phone(const Student& a, const Student& b) {
+        if (a.m_surname != b.m_surname) {
+            return a.m_surname < b.m_surname;
+        }
+
+        if (a.m_name != b.m_name) {
+            return a.m_name < b.m_name;
+        }
+
+        return a.m_phone_number < b.m_phone_number;
+    }
+    
+    bool compare_by_rating_desc_and_phone(const Student& a, const Student& b) {
+        bool a_nan = std::isnan(a.m_rating);
+        bool b_nan = std::isnan(b.m_rating);
+
+        // NaN ranks below every rating
+        if (a_nan != b_nan) {
+            return b_nan;
+        }
+
+        if (!a_nan && a.m_rating != b.m_rating) {
+            return a.m_rating > b.m_rating;
+        }
+
+        return a.m_phone_number < b.m_phone_number;
+    }
+    
+    bool compare_by_rating_and_phone(const Student& a, const Student& b) {
+        if (a.m_rating != b.m_rating) {
+            return a.m_rating < b.m_rating;
+        }
+
+        return a.m_phone_number < b.m_phone_number;
+    }
+    
+    bool compare_by_birth_date_and_phone(const Student& a, const Student& b) {
+        int a_date = a.get_packed_birth_date();
+        int b_date = b.get_packed_birth_date();
+
+        if (a_date != b_date) {
+            return a_date < b_date;
+        }
+
+        return a.m_phone_number < b.m_phone_number;
+    }
+    
     // Compare by rating (ascending)
     bool compare_by_rating(const Student& a, const Student& b) {
         return a.m_rating < b.m_rating;
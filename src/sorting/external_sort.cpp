@@ -0,0 +1,478 @@
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <unistd.h>
+
+#include "external_sort.hpp"
+#include "csv_handler.hpp"
+#include "sorting.hpp"
+#include "sorting_generic.hpp"
+#include "student.hpp"
+
+namespace external_sort {
+
+    namespace {
+
+        constexpr size_t MIN_MEMORY_BUDGET = size_t(1) << 20;
+        constexpr size_t MIN_STREAM_BUFFER = size_t(64) << 10;
+        constexpr size_t MAX_STREAM_BUFFER = size_t(1) << 20;
+        constexpr size_t MAX_FAN_IN = 512;
+
+        // Heap bytes behind a string (short strings live inside the object)
+        size_t heap_bytes(const std::string& s) {
+            return s.capacity() > 15 ? s.capacity() + 1 : 0;
+        }
+
+        /**
+         * @brief Budgeted size of one chunk record
+         * Twice sizeof(Student) covers vector growth; 20 bytes cover the radix sort's
+         * (key, index) pair, its ping-pong copy and the permutation entry.
+         */
+        size_t record_bytes(const Student& s) {
+            return 2 * sizeof(Student) + 20
+                 + heap_bytes(s.m_name) + heap_bytes(s.m_surname) + heap_bytes(s.m_email)
+                 + heap_bytes(s.m_group) + heap_bytes(s.m_phone_number);
+        }
+
+        uint32_t sort_key(const Student& s, bool ascending) {
+            uint32_t key = sort_algorithms::generic::ordered_float_bits(s.m_rating);
+            return ascending ? key : ~key;
+        }
+
+        // Run file record: rating, birth year / month / day, then five length-prefixed strings
+
+        template <typename T>
+        void write_pod(std::ostream& out, T value) {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template <typename T>
+        bool read_pod(std::istream& in, T& value) {
+            return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+        }
+
+        void write_string(std::ostream& out, const std::string& s) {
+            write_pod(out, static_cast<uint32_t>(s.size()));
+            out.write(s.data(), static_cast<std::streamsize>(s.size()));
+        }
+
+        bool read_string(std::istream& in, std::string& s) {
+            uint32_t size;
+
+            if (!read_pod(in, size)) {
+                return false;
+            }
+
+            s.resize(size);
+
+            return size == 0 || static_cast<bool>(in.read(&s[0], size));
+        }
+
+        void write_record(std::ostream& out, const Student& s) {
+            write_pod(out, s.m_rating);
+            write_pod(out, static_cast<int32_t>(s.m_birth_year));
+            write_pod(out, static_cast<int8_t>(s.m_birth_month));
+            write_pod(out, static_cast<int8_t>(s.m_birth_day));
+            write_string(out, s.m_name);
+            write_string(out, s.m_surname);
+            write_string(out, s.m_email);
+            write_string(out, s.m_group);
+            write_string(out, s.m_phone_number);
+        }
+
+        enum class ReadResult {
+            End,      // Clean end of run: nothing left before the first field
+            Record,   // A complete record
+            Partial   // The run ends (or fails) inside a record
+        };
+
+        // Reads into s in place so its strings keep their capacity from record to record
+        ReadResult read_record(std::istream& in, Student& s) {
+            int32_t year;
+            int8_t month, day;
+
+            if (!read_pod(in, s.m_rating)) {
+                // A short read also sets eofbit, so only zero bytes read is a clean end
+                return in.gcount() == 0 && in.eof() && !in.bad() ? ReadResult::End : ReadResult::Partial;
+            }
+
+            if (!read_pod(in, year) || !read_pod(in, month) || !read_pod(in, day)) {
+                return ReadResult::Partial;
+            }
+
+            s.m_birth_year = year;
+            s.m_birth_month = month;
+            s.m_birth_day = day;
+
+            bool complete = read_string(in, s.m_name) && read_string(in, s.m_surname) && read_string(in, s.m_email)
+                         && read_string(in, s.m_group) && read_string(in, s.m_phone_number);
+
+            return complete ? ReadResult::Record : ReadResult::Partial;
+        }
+
+        /**
+         * @brief Temporary run files, removed when no longer needed or on destruction
+         */
+        class TempFiles {
+        public:
+            explicit TempFiles(const std::string& dir) {
+                std::error_code error;
+                directory = dir.empty() ? std::filesystem::temp_directory_path(error) : std::filesystem::path(dir);
+                prefix = "student_db_sort_" + std::to_string(::getpid()) + "_";
+            }
+
+            ~TempFiles() {
+                for (const auto& path : live) {
+                    std::error_code error;
+                    std::filesystem::remove(path, error);
+                }
+            }
+
+            std::string create() {
+                std::string path = (directory / (prefix + std::to_string(counter++) + ".run")).string();
+                live.push_back(path);
+                return path;
+            }
+
+            void remove(const std::string& path) {
+                std::error_code error;
+                std::filesystem::remove(path, error);
+                live.erase(std::remove(live.begin(), live.end(), path), live.end());
+            }
+
+        private:
+            std::filesystem::path directory;
+            std::string prefix;
+            size_t counter = 0;
+            std::vector<std::string> live;
+        };
+
+        /**
+         * @brief Buffered sequential reader over one run file
+         */
+        struct RunReader {
+            std::vector<char> buffer;
+            std::ifstream in;
+            Student current;
+            uint32_t key = 0;
+            bool exhausted = false;
+            bool truncated = false;  // Ended mid-record (as opposed to at a record boundary)
+
+            bool open(const std::string& path, size_t buffer_size) {
+                buffer.resize(buffer_size);
+                in.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                in.open(path, std::ios::binary);
+
+                return in.is_open();
+            }
+
+            void advance(bool ascending) {
+                ReadResult result = read_record(in, current);
+
+                exhausted = result != ReadResult::Record;
+                truncated = result == ReadResult::Partial;
+
+                if (!exhausted) {
+                    key = sort_key(current, ascending);
+                }
+            }
+        };
+
+        /**
+         * @brief Tournament tree of losers over k runs
+         *
+         * Internal node i holds the run that lost the match played there; node 0 holds the
+         * overall winner. After the winner advances, only its leaf-to-root path is replayed:
+         * log2(k) comparisons per output record, each against a single stored loser.
+         * Exhausted runs lose to everything; equal keys go to the lower run index.
+         */
+        class LoserTree {
+        public:
+            explicit LoserTree(const std::vector<std::unique_ptr<RunReader>>& runs)
+                : runs(runs), tree(std::max<size_t>(runs.size(), 1)) {
+                tree[0] = build(1);
+            }
+
+            size_t winner() const {
+                return tree[0];
+            }
+
+            void replay() {
+                size_t k = runs.size();
+                size_t winner = tree[0];
+
+                for (size_t node = (winner + k) / 2; node > 0; node /= 2) {
+                    if (beats(tree[node], winner)) {
+                        std::swap(tree[node], winner);
+                    }
+                }
+
+                tree[0] = winner;
+            }
+
+        private:
+            const std::vector<std::unique_ptr<RunReader>>& runs;
+            std::vector<size_t> tree;
+
+            bool beats(size_t a, size_t b) const {
+                const RunReader& ra = *runs[a];
+                const RunReader& rb = *runs[b];
+
+                if (ra.exhausted || rb.exhausted) {
+                    return !ra.exhausted || (rb.exhausted && a < b);
+                }
+
+                return ra.key < rb.key || (ra.key == rb.key && a < b);
+            }
+
+            // Leaves are nodes k .. 2k - 1; returns the winner of the subtree at node
+            size_t build(size_t node) {
+                size_t k = runs.size();
+
+                if (node >= k) {
+                    return node - k;
+                }
+
+                size_t left = build(2 * node);
+                size_t right = build(2 * node + 1);
+
+                if (beats(left, right)) {
+                    tree[node] = right;
+                    return left;
+                }
+
+                tree[node] = left;
+                return right;
+            }
+        };
+
+        /**
+         * @brief Merge the runs at paths in order, handing each record to sink
+         */
+        template <typename Sink>
+        bool merge_runs(const std::vector<std::string>& paths, size_t buffer_size, bool ascending, Sink&& sink) {
+            std::vector<std::unique_ptr<RunReader>> runs;
+            runs.reserve(paths.size());
+
+            for (const auto& path : paths) {
+                runs.push_back(std::make_unique<RunReader>());
+
+                if (!runs.back()->open(path, buffer_size)) {
+                    std::cerr << "Error: Could not open run file " << path << std::endl;
+                    return false;
+                }
+
+                runs.back()->advance(ascending);
+
+                if (runs.back()->truncated) {
+                    std::cerr << "Error: Truncated run file " << path << std::endl;
+                    return false;
+                }
+            }
+
+            LoserTree tree(runs);
+
+            while (!runs[tree.winner()]->exhausted) {
+                size_t winner = tree.winner();
+                RunReader& run = *runs[winner];
+
+                sink(run.current);
+                run.advance(ascending);
+
+                if (run.truncated) {
+                    std::cerr << "Error: Truncated run file " << paths[winner] << std::endl;
+                    return false;
+                }
+
+                tree.replay();
+            }
+
+            return true;
+        }
+    }
+
+    bool sort_csv_by_rating(const std::string& input, const std::string& output, const Options& options, Stats* stats) {
+        size_t budget = std::max(options.memory_budget, MIN_MEMORY_BUDGET);
+        bool ascending = options.ascending;
+
+        // Merge fan-in: one read buffer per run plus the output buffer must fit the budget
+        size_t fan_in = std::min(MAX_FAN_IN, std::max<size_t>(2, budget / MIN_STREAM_BUFFER - 1));
+        size_t buffer_size = std::min(MAX_STREAM_BUFFER, budget / (fan_in + 1));
+
+        std::ifstream file(input);
+
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not open file " << input << std::endl;
+            return false;
+        }
+
+        TempFiles temp_files(options.temp_dir);
+        std::vector<std::string> runs;
+        std::vector<char> write_buffer(buffer_size);
+
+        std::vector<Student> chunk;
+        size_t chunk_bytes = 0;
+        size_t records = 0;
+
+        auto spill = [&]() {
+            sort_algorithms::radix_sort_students(chunk, sort_algorithms::RadixKey::Rating, ascending);
+
+            std::string path = temp_files.create();
+            std::ofstream out;
+            out.rdbuf()->pubsetbuf(write_buffer.data(), static_cast<std::streamsize>(write_buffer.size()));
+            out.open(path, std::ios::binary);
+
+            for (const auto& student : chunk) {
+                write_record(out, student);
+            }
+
+            out.close();
+
+            if (!out) {
+                std::cerr << "Error: Could not write run file " << path << std::endl;
+                return false;
+            }
+
+            runs.push_back(path);
+            chunk.clear();
+            chunk_bytes = 0;
+
+            return true;
+        };
+
+        std::string line;
+
+        // Skip header line
+        if (std::getline(file, line)) {}
+
+        while (std::getline(file, line)) {
+            if (line.empty()) {
+                continue;
+            }
+
+            try {
+                chunk.push_back(csv::parse_line(line));
+            } catch (const std::exception& e) {
+                std::cerr << "Error parsing line: " << line << std::endl;
+                std::cerr << "Exception: " << e.what() << std::endl;
+                continue;
+            }
+
+            ++records;
+            chunk_bytes += record_bytes(chunk.back());
+
+            if (chunk_bytes >= budget && !spill()) {
+                return false;
+            }
+        }
+
+        std::ofstream out;
+        out.rdbuf()->pubsetbuf(write_buffer.data(), static_cast<std::streamsize>(write_buffer.size()));
+
+        size_t spilled_runs = runs.size();
+        size_t passes = 0;
+
+        if (runs.empty()) {
+            // Everything fit in one chunk: sort in memory, no run files
+            sort_algorithms::radix_sort_students(chunk, sort_algorithms::RadixKey::Rating, ascending);
+
+            out.open(output);
+            if (!out.is_open()) {
+                std::cerr << "Error: Could not create file " << output << std::endl;
+                return false;
+            }
+
+            out << csv::HEADER;
+            for (const auto& student : chunk) {
+                out << csv::to_csv_line(student) << "\n";
+            }
+        } else {
+            if (!chunk.empty() && !spill()) {
+                return false;
+            }
+
+            spilled_runs = runs.size();
+            std::vector<Student>().swap(chunk);
+
+            // Too many runs for one merge: merge adjacent groups (keeps equal keys in input order)
+            while (runs.size() > fan_in) {
+                std::vector<std::string> merged;
+
+                for (size_t begin = 0; begin < runs.size(); begin += fan_in) {
+                    std::vector<std::string> group(runs.begin() + begin,
+                                                   runs.begin() + std::min(begin + fan_in, runs.size()));
+
+                    if (group.size() == 1) {
+                        merged.push_back(group.front());
+                        continue;
+                    }
+
+                    std::string path = temp_files.create();
+                    std::ofstream run_out;
+                    run_out.rdbuf()->pubsetbuf(write_buffer.data(), static_cast<std::streamsize>(write_buffer.size()));
+                    run_out.open(path, std::ios::binary);
+
+                    bool merged_ok = merge_runs(group, buffer_size, ascending, [&run_out](const Student& student) {
+                        write_record(run_out, student);
+                    });
+
+                    run_out.close();
+
+                    if (!merged_ok || !run_out) {
+                        std::cerr << "Error: Could not write run file " << path << std::endl;
+                        return false;
+                    }
+
+                    for (const auto& done : group) {
+                        temp_files.remove(done);
+                    }
+
+                    merged.push_back(path);
+                }
+
+                runs.swap(merged);
+                ++passes;
+            }
+
+            out.open(output);
+            if (!out.is_open()) {
+                std::cerr << "Error: Could not create file " << output << std::endl;
+                return false;
+            }
+
+            out << csv::HEADER;
+            bool merged_ok = merge_runs(runs, buffer_size, ascending, [&out](const Student& student) {
+                out << csv::to_csv_line(student) << "\n";
+            });
+
+            if (!merged_ok) {
+                return false;
+            }
+
+            ++passes;
+        }
+
+        out.close();
+
+        if (!out) {
+            std::cerr << "Error: Could not write file " << output << std::endl;
+            return false;
+        }
+
+        std::cout << "Successfully wrote " << records << " students to " << output << std::endl;
+
+        if (stats) {
+            stats->records = records;
+            stats->runs = spilled_runs;
+            stats->merge_passes = passes;
+            stats->fan_in = fan_in;
+        }
+
+        return true;
+    }
+}
@@ -1,269 +1,260 @@
-#include <algorithm>
-
 #include "sorting.hpp"
+#include "sorting_generic.hpp"
+#include "sorting_parallel.hpp"
 #include "student.hpp"
 
+#include <string>
+
 namespace sort_algorithms {
-    
-    // Bubble Sort
-    void bubble_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator) {
-        size_t n = data.size();
 
-        for (size_t i = 0; i < n - 1; ++i) {
-            bool swapped = false;
-            for (size_t j = 0; j < n - i - 1; ++j) {
-                if (!comparator(data[j], data[j + 1])) {
-                    std::swap(data[j], data[j + 1]);
-                    swapped = true;
-                }
-            }
+    namespace {
 
-            if (!swapped) {
-                break;
+        constexpr std::ptrdiff_t MULTIKEY_INSERTION_THRESHOLD = 16;
+
+        /**
+         * @brief View of the (surname, name) key of element index
+         * Read as one string surname + separator + name, with end of key (0) < separator (1)
+         * < every character (2..257), which orders exactly like compare_by_surname_and_name.
+         */
+        struct NameKey {
+            const std::string* surname;
+            const std::string* name;
+            uint32_t index;
+        };
+
+        inline int key_char(const NameKey& key, size_t depth) {
+            size_t surname_size = key.surname->size();
+
+            if (depth < surname_size) {
+                return static_cast<unsigned char>((*key.surname)[depth]) + 2;
             }
-        }
-    }
-    
-    // Insertion Sort
-    void insertion_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator) {
-        size_t n = data.size();
-    
-        for (size_t i = 1; i < n; ++i) {
-            Student key = data[i];
-            int j = i - 1;
-            
-            while (j >= 0 && !comparator(data[j], key)) {
-                data[j + 1] = data[j];
-                --j;
+
+            if (depth == surname_size) {
+                return 1;
             }
 
-            data[j + 1] = key;
+            depth -= surname_size + 1;
+
+            return depth < key.name->size() ? static_cast<unsigned char>((*key.name)[depth]) + 2 : 0;
         }
-    }
-    
-    // Selection Sort
-    void selection_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator) {
-        size_t n = data.size();
 
-        for (size_t i = 0; i < n - 1; ++i) {
-            size_t min_idx = i;
+        // Keys agree on the first depth characters; equal keys fall back to input order
+        bool key_less(const NameKey& a, const NameKey& b, size_t depth) {
+            while (true) {
+                int ca = key_char(a, depth);
+                int cb = key_char(b, depth);
 
-            for (size_t j = i + 1; j < n; ++j) {
-                if (comparator(data[j], data[min_idx])) {
-                    min_idx = j;
+                if (ca != cb) {
+                    return ca < cb;
+                }
+
+                if (ca == 0) {
+                    return a.index < b.index;
                 }
-            }
 
-            if (min_idx != i) {
-                std::swap(data[i], data[min_idx]);
+                ++depth;
             }
         }
-    }
-    
-    // Merge Sort Helper
-    void merge(std::vector<Student>& data, int left, int mid, int right, 
-               std::function<bool(const Student&, const Student&)> comparator) {
-        int n1 = mid - left + 1;
-        int n2 = right - mid;
-        
-        std::vector<Student> L(n1), R(n2);
-        
-        for (int i = 0; i < n1; ++i) {
-            L[i] = data[left + i];
-        }
 
-        for (int i = 0; i < n2; ++i) {
-            R[i] = data[mid + 1 + i];
-        }
-        
-        int i = 0, j = 0, k = left;
-        
-        while (i < n1 && j < n2) {
-            if (comparator(L[i], R[j]) || !comparator(R[j], L[i])) {
-                data[k] = L[i];
-                ++i;
-            } else {
-                data[k] = R[j];
-                ++j;
+        /**
+         * @brief Multikey quicksort (Bentley-Sedgewick) of keys sharing their first depth characters
+         * Three-way partition on the character at depth: < and > recurse at the same depth, =
+         * moves on to depth + 1, so no character of a shared prefix is compared twice per level.
+         */
+        void multikey_quicksort(NameKey* first, NameKey* last, size_t depth) {
+            while (last - first > MULTIKEY_INSERTION_THRESHOLD) {
+                int a = key_char(first[0], depth);
+                int b = key_char(first[(last - first) / 2], depth);
+                int c = key_char(*(last - 1), depth);
+                int pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+                // [first, lt) < pivot, [lt, it) == pivot, [gt, last) > pivot
+                NameKey* lt = first;
+                NameKey* it = first;
+                NameKey* gt = last;
+
+                while (it < gt) {
+                    int ch = key_char(*it, depth);
+
+                    if (ch < pivot) {
+                        std::swap(*lt++, *it++);
+                    } else if (ch > pivot) {
+                        std::swap(*it, *--gt);
+                    } else {
+                        ++it;
+                    }
+                }
+
+                multikey_quicksort(first, lt, depth);
+                multikey_quicksort(gt, last, depth);
+
+                if (pivot == 0) {
+                    // Identical keys: input order
+                    std::sort(lt, gt, [](const NameKey& x, const NameKey& y) { return x.index < y.index; });
+                    return;
+                }
+
+                first = lt;
+                last = gt;
+                ++depth;
             }
 
-            ++k;
+            generic::insertion_sort(first, last, [depth](const NameKey& x, const NameKey& y) {
+                return key_less(x, y, depth);
+            });
         }
-        
-        while (i < n1) {
-            data[k] = L[i];
-            ++i;
-            ++k;
-        }
-        
-        while (j < n2) {
-            data[k] = R[j];
-            ++j;
-            ++k;
+
+        template <typename Element, typename StudentOf>
+        std::vector<NameKey> sorted_name_keys(const std::vector<Element>& data, StudentOf student_of) {
+            std::vector<NameKey> keys;
+            keys.reserve(data.size());
+
+            for (size_t i = 0; i < data.size(); ++i) {
+                const Student& student = student_of(data[i]);
+                keys.push_back({&student.m_surname, &student.m_name, static_cast<uint32_t>(i)});
+            }
+
+            multikey_quicksort(keys.data(), keys.data() + keys.size(), 0);
+
+            return keys;
         }
     }
-    
-    void merge_sort_helper(std::vector<Student>& data, int left, int right,
-                           std::function<bool(const Student&, const Student&)> comparator) {
-        if (left >= right) {
-            return;
-        }
-    
-        int mid = left + (right - left) / 2;
 
-        merge_sort_helper(data, left, mid, comparator);
-        merge_sort_helper(data, mid + 1, right, comparator);
-    
-        merge(data, left, mid, right, comparator);
+    // std::function entry points: each comparison is an indirect call through the wrapper,
+    // which is passed down by reference (never copied per recursion level)
+
+    void bubble_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator) {
+        generic::bubble_sort(data.begin(), data.end(), std::ref(comparator));
     }
     
-    // Merge Sort
-    void merge_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator) {
-        if (data.size() > 1) {
-            merge_sort_helper(data, 0, data.size() - 1, comparator);
-        }
+    void insertion_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator) {
+        generic::insertion_sort(data.begin(), data.end(), std::ref(comparator));
     }
     
-    // Quick Sort Helper
-    int partition(std::vector<Student>& data, int low, int high,
-                  std::function<bool(const Student&, const Student&)> comparator) {
-        Student pivot = data[high];
-        int i = low - 1;
-        
-        for (int j = low; j < high; ++j) {
-            if (comparator(data[j], pivot)) {
-                ++i;
-                std::swap(data[i], data[j]);
-            }
-        }
-
-        std::swap(data[i + 1], data[high]);
-
-        return i + 1;
+    void selection_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator) {
+        generic::selection_sort(data.begin(), data.end(), std::ref(comparator));
     }
     
-    void quick_sort_helper(std::vector<Student>& data, int low, int high,
-                           std::function<bool(const Student&, const Student&)> comparator) {
-        if (low >= high) {
-            return;
-        }
-    
-        int pi = partition(data, low, high, comparator);
-
-        quick_sort_helper(data, low, pi - 1, comparator);
-        quick_sort_helper(data, pi + 1, high, comparator);
+    void merge_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator) {
+        generic::merge_sort(data.begin(), data.end(), std::ref(comparator));
     }
     
-    // Quick Sort
     void quick_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator) {
-        if (data.size() > 1) {
-            quick_sort_helper(data, 0, data.size() - 1, comparator);
-        }
+        generic::quick_sort(data.begin(), data.end(), std::ref(comparator));
     }
     
-    // Heap Sort Helper
-    void heapify(std::vector<Student>& data, int n, int i,
-                 std::function<bool(const Student&, const Student&)> comparator) {
-        int largest = i;
-        int left = 2 * i + 1;
-        int right = 2 * i + 2;
-        
-        if (left < n && !comparator(data[left], data[largest])) {
-            largest = left;
-        }
-        
-        if (right < n && !comparator(data[right], data[largest])) {
-            largest = right;
-        }
-        
-        if (largest != i) {
-            std::swap(data[i], data[largest]);
-            heapify(data, n, largest, comparator);
-        }
+    void tim_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator) {
+        generic::tim_sort(data.begin(), data.end(), std::ref(comparator));
     }
     
-    // Heap Sort
     void heap_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator) {
-        int n = data.size();
-        
-        for (int i = n / 2 - 1; i >= 0; --i) {
-            heapify(data, n, i, comparator);
-        }
-        
-        for (int i = n - 1; i > 0; --i) {
-            std::swap(data[0], data[i]);
-            heapify(data, i, 0, comparator);
-        }
+        generic::heap_sort(data.begin(), data.end(), std::ref(comparator));
     }
     
-    // Standard library sort
     void std_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator) {
-        std::sort(data.begin(), data.end(), comparator);
+        generic::std_sort(data.begin(), data.end(), std::ref(comparator));
     }
     
-    // Radix Sort for Student rating
     void radix_sort_by_rating(std::vector<Student>& data, 
                              std::function<bool(const Student&, const Student&)> comparator) {
-        if (data.empty()) {
-            return;
-        }
-        
-        bool ascending = true;
-
-        // Check either acsending or descending
-        if (data.size() >= 2) {
-            Student s1, s2;
-            s1.m_rating = 1;
-            s2.m_rating = 2;
-            ascending = comparator(s1, s2);
+        generic::radix_sort_by_rating(data.begin(), data.end(), std::ref(comparator));
+    }
+    
+    void radix_sort_students(std::vector<Student>& data, RadixKey key, bool ascending) {
+        switch (key) {
+            case RadixKey::Rating:
+                generic::radix_sort_by_key(data.begin(), data.end(), [](const Student& s) {
+                    return generic::ordered_float_bits(s.m_rating);
+                }, ascending);
+                break;
+            case RadixKey::BirthDate:
+                generic::radix_sort_by_key(data.begin(), data.end(), [](const Student& s) {
+                    return generic::ordered_int_bits(static_cast<int32_t>(s.get_packed_birth_date()));
+                }, ascending);
+                break;
         }
+    }
+    
+    void multikey_sort_by_surname_and_name(std::vector<Student>& data) {
+        std::vector<NameKey> keys = sorted_name_keys(data, [](const Student& s) -> const Student& { return s; });
         
-        // Convert ratings to integers
-        std::vector<std::pair<int, size_t>> indexed_ratings;
-        indexed_ratings.reserve(data.size());
+        std::vector<uint32_t> order;
+        order.reserve(keys.size());
         
-        for (size_t i = 0; i < data.size(); ++i) {
-            int rating_int = static_cast<int>(data[i].m_rating * 100.0f);
-            indexed_ratings.push_back({rating_int, i});
+        for (const auto& key : keys) {
+            order.push_back(key.index);
         }
         
-        const int MAX_RATING = 10000;
-        std::vector<int> count(MAX_RATING + 1, 0);
+        generic::apply_permutation(data.begin(), order);
+    }
+    
+    void multikey_sort_by_surname_and_name(std::vector<const Student*>& data) {
+        std::vector<NameKey> keys = sorted_name_keys(data, [](const Student* s) -> const Student& { return *s; });
+        std::vector<const Student*> sorted;
+        sorted.reserve(keys.size());
         
-        for (const auto& pair : indexed_ratings) {
-            count[pair.first]++;
+        for (const auto& key : keys) {
+            sorted.push_back(data[key.index]);
         }
         
-        // Cumulative count
-        if (ascending) {
-            for (int i = 1; i <= MAX_RATING; ++i) {
-                count[i] += count[i - 1];
-            }
-        } else {
-            for (int i = MAX_RATING - 1; i >= 0; --i) {
-                count[i] += count[i + 1];
-            }
-        }
+        data.swap(sorted);
+    }
+    
+    void parallel_merge_sort(std::vector<Student>& data, std::function<bool(const Student&, const Student&)> comparator,
+                             size_t thread_count) {
+        // No threads are started for inputs that would be sorted sequentially anyway
+        parallel::ThreadPool pool(data.size() < generic::PARALLEL_MERGE_MIN ? 1 : thread_count);
         
-        std::vector<Student> output(data.size());
+        generic::parallel_merge_sort(data.begin(), data.end(), std::ref(comparator), pool);
+    }
+    
+    namespace {
         
-        if (ascending) {
-            for (int i = indexed_ratings.size() - 1; i >= 0; --i) {
-                int rating = indexed_ratings[i].first;
-                size_t orig_index = indexed_ratings[i].second;
-                output[count[rating] - 1] = data[orig_index];
-                count[rating]--;
-            }
-        } else {
-            for (int i = indexed_ratings.size() - 1; i >= 0; --i) {
-                int rating = indexed_ratings[i].first;
-                size_t orig_index = indexed_ratings[i].second;
-                output[count[rating] - 1] = data[orig_index];
-                count[rating]--;
+        // Shared by the Student and pointer overloads; rating_of reads the rating of one element
+        template <typename T, typename RatingOf>
+        void keyed_sort(std::vector<T>& data, bool ascending, Algorithm algorithm, size_t thread_count,
+                        RatingOf rating_of) {
+            if (data.empty()) {
+                return;
             }
+            
+            // Descending order is ascending order of the complemented key
+            auto key_of = [ascending, &rating_of](const T& element) {
+                uint32_t bits = generic::ordered_float_bits(rating_of(element));
+                return ascending ? bits : ~bits;
+            };
+            
+            auto sort_pairs = [algorithm, thread_count](auto first, auto last, auto pair_less) {
+                switch (algorithm) {
+                    case Algorithm::Std:       generic::std_sort(first, last, pair_less); break;
+                    case Algorithm::Bubble:    generic::bubble_sort(first, last, pair_less); break;
+                    case Algorithm::Insertion: generic::insertion_sort(first, last, pair_less); break;
+                    case Algorithm::Selection: generic::selection_sort(first, last, pair_less); break;
+                    case Algorithm::Merge:     generic::merge_sort(first, last, pair_less); break;
+                    case Algorithm::Quick:     generic::quick_sort(first, last, pair_less); break;
+                    case Algorithm::Heap:      generic::heap_sort(first, last, pair_less); break;
+                    case Algorithm::Tim:       generic::tim_sort(first, last, pair_less); break;
+                    case Algorithm::ParallelMerge: {
+                        size_t n = static_cast<size_t>(last - first);
+                        parallel::ThreadPool pool(n < generic::PARALLEL_MERGE_MIN ? 1 : thread_count);
+                        generic::parallel_merge_sort(first, last, pair_less, pool);
+                        break;
+                    }
+                }
+            };
+            
+            generic::sort_by_key(data, key_of, std::less<uint32_t>(), sort_pairs);
         }
         
-        data = std::move(output);
     }
     
-}
\ No newline at end of file
+    void keyed_sort_by_rating(std::vector<Student>& data, bool ascending, Algorithm algorithm, size_t thread_count) {
+        keyed_sort(data, ascending, algorithm, thread_count, [](const Student& s) { return s.m_rating; });
+    }
+    
+    void keyed_sort_by_rating(std::vector<const Student*>& data, bool ascending, Algorithm algorithm,
+                              size_t thread_count) {
+        keyed_sort(data, ascending, algorithm, thread_count, [](const Student* s) { return s->m_rating; });
+    }
+    
+}
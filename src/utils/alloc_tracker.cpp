@@ -0,0 +1,202 @@
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+
+#include <malloc.h>
+
+#include "alloc_tracker.hpp"
+
+namespace {
+    std::atomic<size_t> active_scopes{0};  // Open LoadScopes; nothing is counted while 0
+
+    std::atomic<size_t> live_bytes{0};
+    std::atomic<size_t> live_blocks{0};
+    std::atomic<size_t> allocations{0};
+
+    void record_allocation(void* ptr) {
+        if (active_scopes.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+
+        live_bytes.fetch_add(malloc_usable_size(ptr), std::memory_order_relaxed);
+        live_blocks.fetch_add(1, std::memory_order_relaxed);
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void record_deallocation(void* ptr) {
+        if (active_scopes.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+
+        live_bytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+        live_blocks.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void* tracked_malloc(size_t size) {
+        void* ptr = std::malloc(size == 0 ? 1 : size);
+
+        if (ptr) {
+            record_allocation(ptr);
+        }
+
+        return ptr;
+    }
+
+    void* tracked_aligned_alloc(size_t size, std::align_val_t alignment) {
+        size_t align = static_cast<size_t>(alignment);
+        size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align;  // aligned_alloc needs a multiple
+        void* ptr = std::aligned_alloc(align, rounded);
+
+        if (ptr) {
+            record_allocation(ptr);
+        }
+
+        return ptr;
+    }
+
+    void tracked_free(void* ptr) {
+        if (ptr) {
+            record_deallocation(ptr);
+            std::free(ptr);
+        }
+    }
+
+    void* allocate_or_throw(size_t size) {
+        while (true) {
+            if (void* ptr = tracked_malloc(size)) {
+                return ptr;
+            }
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    void* aligned_allocate_or_throw(size_t size, std::align_val_t alignment) {
+        while (true) {
+            if (void* ptr = tracked_aligned_alloc(size, alignment)) {
+                return ptr;
+            }
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    size_t read_status_kb(const std::string& line) {
+        // "VmRSS:	   12345 kB"
+        size_t pos = line.find_first_of("0123456789");
+        return pos == std::string::npos ? 0 : std::stoull(line.substr(pos)) * 1024;
+    }
+}
+
+// Global replacements: every form funnels into tracked_malloc / tracked_aligned_alloc / tracked_free
+
+void* operator new(size_t size) { return allocate_or_throw(size); }
+void* operator new[](size_t size) { return allocate_or_throw(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return tracked_malloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return tracked_malloc(size); }
+
+void* operator new(size_t size, std::align_val_t alignment) { return aligned_allocate_or_throw(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return aligned_allocate_or_throw(size, alignment); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return tracked_aligned_alloc(size, alignment);
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return tracked_aligned_alloc(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr) noexcept { tracked_free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { tracked_free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { tracked_free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { tracked_free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { tracked_free(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { tracked_free(ptr); }
+
+namespace alloc_tracker {
+
+    Counters counters() {
+        Counters result;
+        result.live_bytes = live_bytes.load(std::memory_order_relaxed);
+        result.live_blocks = live_blocks.load(std::memory_order_relaxed);
+        result.allocations = allocations.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    ProcessMemory process_memory() {
+        ProcessMemory result{0, 0};
+        std::ifstream status("/proc/self/status");
+        std::string line;
+
+        while (std::getline(status, line)) {
+            if (line.compare(0, 6, "VmRSS:") == 0) {
+                result.rss_bytes = read_status_kb(line);
+            } else if (line.compare(0, 6, "VmHWM:") == 0) {
+                result.peak_rss_bytes = read_status_kb(line);
+            }
+        }
+
+        return result;
+    }
+
+    bool reset_peak_rss() {
+        std::ofstream clear_refs("/proc/self/clear_refs");
+        clear_refs << "5";
+        clear_refs.flush();
+        return static_cast<bool>(clear_refs);
+    }
+
+    LoadScope::LoadScope() : tracking(true) {
+        reset_peak_rss();
+        start_memory = process_memory();
+        active_scopes.fetch_add(1, std::memory_order_relaxed);
+        start_counters = counters();
+    }
+
+    LoadScope::~LoadScope() {
+        stop_tracking();
+    }
+
+    void LoadScope::stop_tracking() {
+        if (tracking) {
+            active_scopes.fetch_sub(1, std::memory_order_relaxed);
+            tracking = false;
+        }
+    }
+
+    LoadFootprint LoadScope::finish() {
+        Counters end_counters = counters();
+        stop_tracking();
+
+        ProcessMemory end_memory = process_memory();
+
+        // Signed deltas: a load may free blocks that were allocated before the scope
+        long long blocks = static_cast<long long>(end_counters.live_blocks) - static_cast<long long>(start_counters.live_blocks);
+        long long bytes = static_cast<long long>(end_counters.live_bytes) - static_cast<long long>(start_counters.live_bytes)
+                        + blocks * static_cast<long long>(sizeof(size_t));  // glibc chunk header
+
+        LoadFootprint result;
+        result.heap_bytes = bytes > 0 ? static_cast<size_t>(bytes) : 0;
+        result.heap_blocks = blocks > 0 ? static_cast<size_t>(blocks) : 0;
+        result.allocations = end_counters.allocations - start_counters.allocations;
+        result.rss_before_bytes = start_memory.rss_bytes;
+        result.rss_after_bytes = end_memory.rss_bytes;
+        result.peak_rss_bytes = end_memory.peak_rss_bytes;
+        return result;
+    }
+}
@@ -100,7 +100,7 @@ namespace csv {
         }
         
         // Write header
-        file << "m_name,m_surname,m_email,m_birth_year,m_birth_month,m_birth_day,m_group,m_rating,m_phone_number\n";
+        file << HEADER;
         
         // Write student data
         for (const auto& student : students) {
@@ -114,4 +114,25 @@ namespace csv {
         return true;
     }
     
+    bool write_csv(const std::string& filename, const std::vector<const Student*>& students) {
+        std::ofstream file(filename);
+        
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not create file " << filename << std::endl;
+            return false;
+        }
+        
+        file << HEADER;
+        
+        for (const Student* student : students) {
+            file << to_csv_line(*student) << "\n";
+        }
+        
+        file.close();
+    
+        std::cout << "Successfully wrote " << students.size() << " students to " << filename << std::endl;
+    
+        return true;
+    }
+    
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include <atomic>
+#include <array>
+#include <limits>
+#include <stdexcept>
+
+#include "epoch.hpp"
+
+namespace epoch {
+
+    namespace {
+        constexpr size_t MAX_READERS = 256;
+        constexpr uint64_t IDLE = std::numeric_limits<uint64_t>::max();
+
+        // One cache line per reader so announcements never bounce between cores
+        struct alignas(64) ReaderSlot {
+            std::atomic<uint64_t> epoch{IDLE};
+            std::atomic<bool> in_use{false};
+        };
+
+        std::atomic<uint64_t> global_epoch{1};
+        std::array<ReaderSlot, MAX_READERS> slots;
+
+        // Slot is claimed on the first read of a thread and released on thread exit
+        struct SlotHandle {
+            ReaderSlot* slot = nullptr;
+
+            SlotHandle() {
+                for (auto& candidate : slots) {
+                    bool expected = false;
+                    if (candidate.in_use.compare_exchange_strong(expected, true)) {
+                        slot = &candidate;
+                        return;
+                    }
+                }
+
+                throw std::runtime_error("epoch: too many concurrent reader threads");
+            }
+
+            ~SlotHandle() {
+                slot->epoch.store(IDLE, std::memory_order_release);
+                slot->in_use.store(false, std::memory_order_release);
+            }
+        };
+
+        ReaderSlot& local_slot() {
+            thread_local SlotHandle handle;
+            return *handle.slot;
+        }
+    }
+
+    ReadGuard::ReadGuard() {
+        ReaderSlot& slot = local_slot();
+
+        // seq_cst store orders the announcement before the caller loads the root pointer
+        slot.epoch.store(global_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    }
+
+    ReadGuard::~ReadGuard() {
+        local_slot().epoch.store(IDLE, std::memory_order_release);
+    }
+
+    uint64_t advance() {
+        return global_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+    }
+
+    uint64_t min_active() {
+        uint64_t oldest = IDLE;
+
+        for (const auto& slot : slots) {
+            uint64_t announced = slot.epoch.load(std::memory_order_seq_cst);
+            if (announced < oldest) {
+                oldest = announced;
+            }
+        }
+
+        return oldest;
+    }
+
+    bool is_quiescent(uint64_t retired_epoch) {
+        return min_active() >= retired_epoch;
+    }
+}
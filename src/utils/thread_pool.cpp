@@ -0,0 +1,171 @@
+#include "thread_pool.hpp"
+
+namespace parallel {
+
+    namespace {
+        // Pool and deque owned by the current thread; non-pool threads use deque 0
+        thread_local const ThreadPool* local_pool = nullptr;
+        thread_local size_t local_queue = 0;
+    }
+
+    ThreadPool::ThreadPool(size_t thread_count) {
+        if (thread_count == 0) {
+            thread_count = std::thread::hardware_concurrency();
+        }
+
+        if (thread_count == 0) {
+            thread_count = 1;
+        }
+
+        queues.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i) {
+            queues.push_back(std::make_unique<Queue>());
+        }
+
+        workers.reserve(thread_count - 1);
+        for (size_t i = 1; i < thread_count; ++i) {
+            workers.emplace_back(&ThreadPool::worker_loop, this, i);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping.store(true);
+        }
+        wake.notify_all();
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    size_t ThreadPool::size() const {
+        return queues.size();
+    }
+
+    size_t ThreadPool::local_index() const {
+        return local_pool == this ? local_queue : 0;
+    }
+
+    void ThreadPool::submit(std::function<void()> task) {
+        Queue& queue = *queues[local_index()];
+
+        // Counted before it is visible: a worker that takes the task at once must not
+        // decrement pending below zero (it would wrap and keep idle workers spinning)
+        pending.fetch_add(1);
+
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+
+        // Empty critical section: a worker between its predicate check and sleeping cannot miss this
+        { std::lock_guard<std::mutex> lock(sleep_mutex); }
+        wake.notify_one();
+    }
+
+    bool ThreadPool::pop(size_t index, std::function<void()>& task) {
+        Queue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.tasks.empty()) {
+            return false;
+        }
+
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        pending.fetch_sub(1);
+
+        return true;
+    }
+
+    bool ThreadPool::steal(size_t thief, std::function<void()>& task) {
+        for (size_t offset = 1; offset < queues.size(); ++offset) {
+            Queue& queue = *queues[(thief + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                pending.fetch_sub(1);
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool ThreadPool::try_run_one() {
+        size_t index = local_index();
+        std::function<void()> task;
+
+        if (!pop(index, task) && !steal(index, task)) {
+            return false;
+        }
+
+        task();
+
+        return true;
+    }
+
+    void ThreadPool::wait_for_work(const std::function<bool()>& done) {
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock, [this, &done] { return pending.load() > 0 || done(); });
+    }
+
+    void ThreadPool::notify_waiters() {
+        // Same empty critical section as submit(): a waiter about to sleep cannot miss this
+        { std::lock_guard<std::mutex> lock(sleep_mutex); }
+        wake.notify_all();
+    }
+
+    void ThreadPool::worker_loop(size_t index) {
+        local_pool = this;
+        local_queue = index;
+
+        while (true) {
+            if (try_run_one()) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            wake.wait(lock, [this] { return stopping.load() || pending.load() > 0; });
+
+            if (stopping.load() && pending.load() == 0) {
+                return;
+            }
+        }
+    }
+
+    TaskGroup::TaskGroup(ThreadPool& pool) : pool(pool) {}
+
+    TaskGroup::~TaskGroup() {
+        wait();
+    }
+
+    void TaskGroup::run(std::function<void()> task) {
+        outstanding.fetch_add(1);
+
+        // The group may be destroyed as soon as outstanding reaches zero, so the last
+        // task only touches the pool afterwards
+        pool.submit([this, &owner = pool, task = std::move(task)] {
+            task();
+
+            if (outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                owner.notify_waiters();
+            }
+        });
+    }
+
+    void TaskGroup::wait() {
+        auto done = [this] { return outstanding.load(std::memory_order_acquire) == 0; };
+
+        while (!done()) {
+            if (!pool.try_run_one()) {
+                pool.wait_for_work(done);
+            }
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "database.hpp"
+#include "csv_handler.hpp"
+#include "sorting.hpp"
+
+// DatabaseMapped visits decoded temporaries, so the generic save paths must copy the students
+
+namespace {
+    int failures = 0;
+
+    void check(bool condition, const std::string& message) {
+        if (!condition) {
+            std::cerr << "FAILED: " << message << "\n";
+            ++failures;
+        }
+    }
+
+    std::vector<Student> make_students(size_t count) {
+        std::vector<Student> students;
+
+        for (size_t i = 0; i < count; ++i) {
+            students.emplace_back("Name" + std::to_string(i % 17), "Surname" + std::to_string(i % 31),
+                                  "name.surname@student.org", 1990 + static_cast<int>(i % 20), 1 + static_cast<int>(i % 12),
+                                  1 + static_cast<int>(i % 28), "ABC-" + std::to_string(10 + i % 50),
+                                  static_cast<float>((i * 7919) % 1000) / 10.0f, "38(0" + std::to_string(100000 + i) + ")");
+        }
+
+        return students;
+    }
+
+    bool same_phones(std::vector<Student> a, std::vector<Student> b) {
+        auto by_phone = [](const Student& x, const Student& y) { return x.m_phone_number < y.m_phone_number; };
+        std::sort(a.begin(), a.end(), by_phone);
+        std::sort(b.begin(), b.end(), by_phone);
+
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const Student& x, const Student& y) {
+            return x.m_phone_number == y.m_phone_number && x.m_rating == y.m_rating;
+        });
+    }
+}
+
+int main() {
+    const std::string map_path = "test_mapped_save.map";
+    const std::string csv_path = "test_mapped_save.csv";
+
+    std::vector<Student> students = make_students(5000);
+    DatabaseMapped db(map_path, students);
+    check(db.is_open() && db.size() == students.size(), "mapped engine holds every student");
+
+    check(db.save_to_file(csv_path), "save_to_file succeeds");
+    check(same_phones(csv::read_csv(csv_path), students), "save_to_file writes every student");
+
+    for (bool ascending : {true, false}) {
+        check(db.sort_by_rating_keyed_and_save(csv_path, ascending, sort_algorithms::Algorithm::Quick),
+              "keyed save succeeds");
+
+        std::vector<Student> saved = csv::read_csv(csv_path);
+        check(same_phones(saved, students), "keyed save writes every student");
+        check(std::is_sorted(saved.begin(), saved.end(), [ascending](const Student& a, const Student& b) {
+            return ascending ? a.m_rating < b.m_rating : a.m_rating > b.m_rating;
+        }), "keyed save orders by rating");
+    }
+
+    std::remove(map_path.c_str());
+    std::remove(csv_path.c_str());
+
+    if (failures == 0) {
+        std::cout << "test_mapped_save: OK\n";
+    }
+
+    return failures == 0 ? 0 : 1;
+}